@@ -16,7 +16,7 @@ template<typename Data>
 inline bool DictionaryContainer<Data>::InsertAll(MappableContainer<Data> && container) {
     bool all = false;
     container.Map (
-        [this, &all](const Data & dat) {
+        [this, &all](Data & dat) {
             all &= Insert(std::move(dat));
         }
     );
@@ -50,7 +50,7 @@ template<typename Data>
 inline bool DictionaryContainer<Data>::InsertSome(MappableContainer<Data> && container) {
     bool some = false;
     container.Map (
-        [this, &some](const Data & dat) {
+        [this, &some](Data & dat) {
             some |= Insert(std::move(dat));
         }
     );
@@ -0,0 +1,47 @@
+
+namespace lasd {
+
+  /* ************************************************************************** */
+
+  template <typename Derived, typename Data>
+  inline const Derived & StaticLinearContainer<Derived, Data>::Self() const noexcept {
+      static_assert(std::is_final_v<Derived>, "Qualified calls would bypass the overrides of a derived class");
+      return static_cast<const Derived &>(*this);
+  }
+
+  template <typename Derived, typename Data>
+  inline unsigned long StaticLinearContainer<Derived, Data>::StaticSize() const noexcept {
+      return Self().Derived::Size();
+  }
+
+  template <typename Derived, typename Data>
+  inline bool StaticLinearContainer<Derived, Data>::StaticEmpty() const noexcept {
+      return Self().Derived::Empty();
+  }
+
+  template <typename Derived, typename Data>
+  inline const Data & StaticLinearContainer<Derived, Data>::StaticAt(unsigned long index) const {
+      return Self().Derived::operator[](index);
+  }
+
+  template <typename Derived, typename Data>
+  template <typename Fun>
+  inline void StaticLinearContainer<Derived, Data>::StaticTraverse(Fun fun) const {
+      const Derived & self = Self();
+      for (unsigned long index = 0, size = self.Derived::Size(); index < size; ++index) {
+          fun(self.Derived::operator[](index));
+      }
+  }
+
+  template <typename Derived, typename Data>
+  template <typename Accumulator, typename Fun>
+  inline Accumulator StaticLinearContainer<Derived, Data>::StaticFold(Fun fun, Accumulator accumulator) const {
+      StaticTraverse([&fun, &accumulator](const Data & data) {
+          accumulator = fun(data, accumulator);
+      });
+      return accumulator;
+  }
+
+  /* ************************************************************************** */
+
+}
@@ -0,0 +1,56 @@
+#ifndef STATIC_HPP
+#define STATIC_HPP
+
+#include <type_traits>
+#include "container.hpp"
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Non-virtual interface (CRTP) for generic code over a final linear container
+// with constant-time operator[]. Every member calls the member of Derived by
+// its qualified name, which binds it at compile time: a final class has no
+// override to miss, and its virtual-base offsets are known, so the calls can
+// be inlined. Functions are template parameters, not std::function objects.
+// The virtual interface of the container is still there, unchanged.
+template <typename Derived, typename Data>
+class StaticLinearContainer {
+
+private:
+
+protected:
+
+  // Default constructor
+  StaticLinearContainer() = default;
+
+public:
+
+  // Specific member functions (non-virtual)
+
+  inline unsigned long StaticSize() const noexcept;
+  inline bool StaticEmpty() const noexcept;
+
+  inline const Data & StaticAt(unsigned long) const; // As operator[] (must throw std::out_of_range when out of range)
+
+  template <typename Fun>
+  inline void StaticTraverse(Fun) const; // Calls fun(value) in index order
+
+  template <typename Accumulator, typename Fun>
+  inline Accumulator StaticFold(Fun, Accumulator) const; // As Fold: accumulator = fun(value, accumulator) in index order
+
+protected:
+
+  inline const Derived & Self() const noexcept;
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "static.cpp"
+
+#endif
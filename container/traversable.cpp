@@ -18,12 +18,24 @@ namespace lasd {
       return accumulator;
   } 
   
+  //FoldInPlace
+  template <typename Data>
+  template <typename Accumulator>
+  inline Accumulator TraversableContainer<Data>::FoldInPlace(FoldInPlaceFun<Accumulator> fun, Accumulator && accumulator) const {
+      Traverse(
+          [&fun, &accumulator](const Data & data) {
+              fun(data, accumulator);
+          }
+      );
+      return std::move(accumulator);
+  }
+  
   // Exists
   template <typename Data>
   inline bool TraversableContainer<Data>::Exists(const Data & value) const noexcept {
       bool exists = false;
       Traverse(
-          [value, &exists](const Data & data) {
+          [&value, &exists](const Data & data) {
               exists |= (data == value); 
           }
       );
@@ -45,6 +57,16 @@ namespace lasd {
       return accumulator;
     };
   
+  //PreOrderFoldInPlace
+  template <typename Data>
+    template <typename Accumulator>
+    inline Accumulator PreOrderTraversableContainer<Data>::PreOrderFoldInPlace(FoldInPlaceFun<Accumulator> func, Accumulator && accumulator) const
+    {
+      PreOrderTraverse([&accumulator, &func](const Data &currData)
+                       { func(currData, accumulator); });
+      return std::move(accumulator);
+    };
+  
   
   //PostOrderTravesableContainer
   /* ************************************************************************** */
@@ -59,6 +81,16 @@ namespace lasd {
       return accumulator;
     };
   
+  //PostOrderFoldInPlace
+  template <typename Data>
+  template <typename Accumulator>
+  inline Accumulator PostOrderTraversableContainer<Data>::PostOrderFoldInPlace(FoldInPlaceFun<Accumulator> func, Accumulator && accumulator) const
+    {
+      PostOrderTraverse([&accumulator, &func](const Data &currData)
+                        { func(currData, accumulator); });
+      return std::move(accumulator);
+    };
+  
   
   }
   
\ No newline at end of file
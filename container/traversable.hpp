@@ -3,6 +3,7 @@
 #define TRAVERSABLE_HPP
 
 #include <functional>
+#include <utility>
 #include "testable.hpp"
 
 /* ************************************************************************** */
@@ -49,6 +50,14 @@ public:
   template <typename Accumulator>
   inline Accumulator Fold(FoldFun<Accumulator> func, Accumulator base) const noexcept;
 
+  template <typename Accumulator>
+  using FoldInPlaceFun = std::function<void(const Data &, Accumulator &)>;
+
+  // As Fold, but the function updates the accumulator in place instead of
+  // returning a new one: no copy of the accumulator per value
+  template <typename Accumulator>
+  inline Accumulator FoldInPlace(FoldInPlaceFun<Accumulator>, Accumulator &&) const;
+
   /* ************************************************************************ */
 
   // Specific member function (inherited from TestableContainer)
@@ -98,6 +107,12 @@ public:
   template <typename Accumulator>
   inline Accumulator PreOrderFold(FoldFun<Accumulator>, Accumulator) const;
 
+  template <typename Accumulator>
+  using FoldInPlaceFun = typename TraversableContainer<Data>::template FoldInPlaceFun<Accumulator>;
+
+  template <typename Accumulator>
+  inline Accumulator PreOrderFoldInPlace(FoldInPlaceFun<Accumulator>, Accumulator &&) const;
+
   /* ************************************************************************ */
 
   // Specific member function (inherited from TraversableContainer)
@@ -148,6 +163,12 @@ public:
   template <typename Accumulator>
   inline Accumulator PostOrderFold(FoldFun<Accumulator>, Accumulator) const;
 
+  template <typename Accumulator>
+  using FoldInPlaceFun = typename TraversableContainer<Data>::template FoldInPlaceFun<Accumulator>;
+
+  template <typename Accumulator>
+  inline Accumulator PostOrderFoldInPlace(FoldInPlaceFun<Accumulator>, Accumulator &&) const;
+
   /* ************************************************************************ */
 
   // Specific member function (inherited from TraversableContainer)
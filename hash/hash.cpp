@@ -0,0 +1,21 @@
+namespace lasd {
+
+/* ************************************************************************** */
+
+// std::hash is the identity for integral types, so its result is passed
+// through a 64-bit finalizer: hash tables take both the slot index and the
+// control tag from it, and need high and low bits to be well distributed.
+template <typename Data>
+ulong Hashable<Data>::operator()(const Data & dat) const noexcept {
+  ulong key = static_cast<ulong>(std::hash<Data>{}(dat));
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdUL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53UL;
+  key ^= key >> 33;
+  return key;
+}
+
+/* ************************************************************************** */
+
+}
@@ -0,0 +1,33 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+/* ************************************************************************** */
+
+#include "../container/container.hpp"
+
+#include <functional>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+template <typename Data>
+class Hashable {
+
+public:
+
+  // Specific member function (concrete function should not throw exceptions)
+
+  ulong operator()(const Data &) const noexcept; // Mixed hash code: every bit depends on every input bit
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "hash.cpp"
+
+#endif
@@ -0,0 +1,351 @@
+
+#include <bit>
+#include <cstring>
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* SETHASH - CONSTRUCTORS                                                      */
+/* ************************************************************************** */
+
+template <typename Data, typename Hasher>
+SetHash<Data, Hasher>::SetHash(const TraversableContainer<Data> & container) {
+  Reserve(container.Size());
+  container.Traverse(
+    [this](const Data & dat) {
+      Insert(dat);
+    }
+  );
+}
+
+template <typename Data, typename Hasher>
+SetHash<Data, Hasher>::SetHash(MappableContainer<Data> && container) {
+  Reserve(container.Size());
+  container.Map(
+    [this](Data & dat) {
+      Insert(std::move(dat));
+    }
+  );
+}
+
+/* ************************************************************************** */
+/* SETHASH - COPY AND MOVE CONSTRUCTORS                                        */
+/* ************************************************************************** */
+
+// Copy constructor (same hasher and capacity, hence the same layout)
+template <typename Data, typename Hasher>
+SetHash<Data, Hasher>::SetHash(const SetHash & other) : hasher(other.hasher) {
+  if (other.capacity == 0) {
+    return;
+  }
+  control = new signed char[other.capacity + GroupWidth - 1];
+  slots = std::allocator<Data>().allocate(other.capacity);
+  capacity = other.capacity;
+  std::memcpy(control, other.control, capacity + GroupWidth - 1);
+
+  ulong index = 0;
+  try {
+    for (; index < capacity; ++index) {
+      if (control[index] >= 0) {
+        std::construct_at(slots + index, other.slots[index]);
+      }
+    }
+  } catch (...) {
+    for (ulong built = 0; built < index; ++built) {
+      if (control[built] >= 0) {
+        std::destroy_at(slots + built);
+      }
+    }
+    std::allocator<Data>().deallocate(slots, capacity);
+    delete[] control;
+    control = nullptr;
+    slots = nullptr;
+    capacity = 0;
+    throw;
+  }
+  size = other.size;
+}
+
+// Move constructor
+template <typename Data, typename Hasher>
+SetHash<Data, Hasher>::SetHash(SetHash && other) noexcept : hasher(other.hasher) {
+  std::swap(size, other.size);
+  std::swap(control, other.control);
+  std::swap(slots, other.slots);
+  std::swap(capacity, other.capacity);
+}
+
+/* ************************************************************************** */
+/* SETHASH - DESTRUCTOR                                                        */
+/* ************************************************************************** */
+
+template <typename Data, typename Hasher>
+SetHash<Data, Hasher>::~SetHash() {
+  Release();
+}
+
+/* ************************************************************************** */
+/* SETHASH - ASSIGNMENT OPERATORS                                              */
+/* ************************************************************************** */
+
+// Copy assignment
+template <typename Data, typename Hasher>
+SetHash<Data, Hasher> & SetHash<Data, Hasher>::operator=(const SetHash & other) {
+  if (this != &other) {
+    SetHash temp{other};
+    *this = std::move(temp);
+  }
+  return *this;
+}
+
+// Move assignment
+template <typename Data, typename Hasher>
+SetHash<Data, Hasher> & SetHash<Data, Hasher>::operator=(SetHash && other) noexcept {
+  std::swap(hasher, other.hasher);
+  std::swap(size, other.size);
+  std::swap(control, other.control);
+  std::swap(slots, other.slots);
+  std::swap(capacity, other.capacity);
+  return *this;
+}
+
+/* ************************************************************************** */
+/* SETHASH - COMPARISON OPERATORS                                              */
+/* ************************************************************************** */
+
+template <typename Data, typename Hasher>
+bool SetHash<Data, Hasher>::operator==(const SetHash & other) const noexcept {
+  if (size != other.size) {
+    return false;
+  }
+  bool equal = true;
+  other.Traverse(
+    [this, &equal](const Data & dat) {
+      equal = equal && Exists(dat);
+    }
+  );
+  return equal;
+}
+
+template <typename Data, typename Hasher>
+inline bool SetHash<Data, Hasher>::operator!=(const SetHash & other) const noexcept {
+  return !(*this == other);
+}
+
+/* ************************************************************************** */
+/* SETHASH - SPECIFIC MEMBER FUNCTIONS                                         */
+/* ************************************************************************** */
+
+template <typename Data, typename Hasher>
+void SetHash<Data, Hasher>::Reserve(ulong count) {
+  ulong newCapacity = MinCapacity;
+  while (newCapacity * 7 < count * 8) {
+    newCapacity <<= 1;
+  }
+  if (newCapacity > capacity) {
+    Rehash(newCapacity);
+  }
+}
+
+/* ************************************************************************** */
+/* SETHASH - DICTIONARY CONTAINER FUNCTIONS                                    */
+/* ************************************************************************** */
+
+template <typename Data, typename Hasher>
+bool SetHash<Data, Hasher>::Insert(const Data & value) {
+  if constexpr (std::is_copy_constructible_v<Data>) {
+    return InsertValue(value);
+  } else {
+    throw std::logic_error("Inserting a copy of a value that is not copy constructible.");
+  }
+}
+
+template <typename Data, typename Hasher>
+bool SetHash<Data, Hasher>::Insert(Data && value) {
+  return InsertValue(std::move(value));
+}
+
+template <typename Data, typename Hasher>
+bool SetHash<Data, Hasher>::Remove(const Data & value) {
+  if (size == 0) {
+    return false;
+  }
+  ulong slot = Find(value, hasher(value));
+  if (slot == capacity) {
+    return false;
+  }
+  std::destroy_at(slots + slot);
+  --size;
+  BackwardShift(slot);
+  return true;
+}
+
+/* ************************************************************************** */
+/* SETHASH - TESTABLE CONTAINER FUNCTIONS                                      */
+/* ************************************************************************** */
+
+template <typename Data, typename Hasher>
+bool SetHash<Data, Hasher>::Exists(const Data & value) const noexcept {
+  return (size != 0) && (Find(value, hasher(value)) != capacity);
+}
+
+/* ************************************************************************** */
+/* SETHASH - TRAVERSABLE CONTAINER FUNCTIONS                                   */
+/* ************************************************************************** */
+
+template <typename Data, typename Hasher>
+void SetHash<Data, Hasher>::Traverse(TraverseFun fun) const {
+  for (ulong pos = 0; pos < capacity; pos += GroupWidth) {
+    for (unsigned int full = Group(control + pos).MatchFull(); full != 0; full &= full - 1) {
+      fun(slots[pos + std::countr_zero(full)]);
+    }
+  }
+}
+
+/* ************************************************************************** */
+/* SETHASH - CLEARABLE CONTAINER FUNCTIONS                                     */
+/* ************************************************************************** */
+
+template <typename Data, typename Hasher>
+void SetHash<Data, Hasher>::Clear() {
+  Release();
+}
+
+/* ************************************************************************** */
+/* SETHASH - AUXILIARY FUNCTIONS                                               */
+/* ************************************************************************** */
+
+template <typename Data, typename Hasher>
+ulong SetHash<Data, Hasher>::Find(const Data & value, ulong hash) const noexcept {
+  if (capacity == 0) {
+    return capacity;
+  }
+  signed char tag = Tag(hash);
+  ulong pos = Home(hash);
+  while (true) {
+    Group group(control + pos);
+    for (unsigned int match = group.Match(tag); match != 0; match &= match - 1) {
+      ulong slot = (pos + std::countr_zero(match)) & (capacity - 1);
+      if (slots[slot] == value) {
+        return slot;
+      }
+    }
+    // Equal values share the home slot, so none lies past the end of the run
+    if (group.MatchEmpty() != 0) {
+      return capacity;
+    }
+    pos = (pos + GroupWidth) & (capacity - 1);
+  }
+}
+
+template <typename Data, typename Hasher>
+ulong SetHash<Data, Hasher>::FindEmpty(ulong pos) const noexcept {
+  while (true) {
+    unsigned int empty = Group(control + pos).MatchEmpty();
+    if (empty != 0) {
+      return (pos + std::countr_zero(empty)) & (capacity - 1);
+    }
+    pos = (pos + GroupWidth) & (capacity - 1);
+  }
+}
+
+template <typename Data, typename Hasher>
+void SetHash<Data, Hasher>::SetControl(ulong slot, signed char tag) noexcept {
+  control[slot] = tag;
+  if (slot < GroupWidth - 1) {
+    control[capacity + slot] = tag;
+  }
+}
+
+template <typename Data, typename Hasher>
+template <typename Value>
+bool SetHash<Data, Hasher>::InsertValue(Value && value) {
+  if (capacity == 0) {
+    Rehash(MinCapacity);
+  }
+  ulong hash = hasher(value);
+  if (Find(value, hash) != capacity) {
+    return false;
+  }
+  // Maximum load factor 7/8: probe runs stay short and an empty slot always exists
+  if ((size + 1) * 8 > capacity * 7) {
+    Rehash(capacity * 2);
+  }
+  ulong slot = FindEmpty(Home(hash));
+  std::construct_at(slots + slot, std::forward<Value>(value));
+  SetControl(slot, Tag(hash));
+  ++size;
+  return true;
+}
+
+template <typename Data, typename Hasher>
+void SetHash<Data, Hasher>::Rehash(ulong newCapacity) {
+  signed char * oldControl = control;
+  Data * oldSlots = slots;
+  ulong oldCapacity = capacity;
+
+  control = new signed char[newCapacity + GroupWidth - 1];
+  try {
+    slots = std::allocator<Data>().allocate(newCapacity);
+  } catch (...) {
+    delete[] control;
+    control = oldControl;
+    throw;
+  }
+  capacity = newCapacity;
+  std::memset(control, CtrlEmpty, capacity + GroupWidth - 1);
+
+  for (ulong index = 0; index < oldCapacity; ++index) {
+    if (oldControl[index] >= 0) {
+      ulong hash = hasher(oldSlots[index]);
+      ulong slot = FindEmpty(Home(hash));
+      std::construct_at(slots + slot, std::move(oldSlots[index]));
+      std::destroy_at(oldSlots + index);
+      SetControl(slot, Tag(hash));
+    }
+  }
+
+  if (oldSlots != nullptr) {
+    std::allocator<Data>().deallocate(oldSlots, oldCapacity);
+  }
+  delete[] oldControl;
+}
+
+// Moves back every value of the run after the hole that may legally occupy
+// it (its home is not between the hole and its current slot); the last
+// vacated slot becomes empty.
+template <typename Data, typename Hasher>
+void SetHash<Data, Hasher>::BackwardShift(ulong hole) {
+  ulong mask = capacity - 1;
+  for (ulong next = (hole + 1) & mask; control[next] != CtrlEmpty; next = (next + 1) & mask) {
+    ulong home = Home(hasher(slots[next]));
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      std::construct_at(slots + hole, std::move(slots[next]));
+      std::destroy_at(slots + next);
+      SetControl(hole, control[next]);
+      hole = next;
+    }
+  }
+  SetControl(hole, CtrlEmpty);
+}
+
+template <typename Data, typename Hasher>
+void SetHash<Data, Hasher>::Release() noexcept {
+  for (ulong index = 0; index < capacity; ++index) {
+    if (control[index] >= 0) {
+      std::destroy_at(slots + index);
+    }
+  }
+  if (slots != nullptr) {
+    std::allocator<Data>().deallocate(slots, capacity);
+  }
+  delete[] control;
+  control = nullptr;
+  slots = nullptr;
+  capacity = 0;
+  size = 0;
+}
+
+/* ************************************************************************** */
+
+}
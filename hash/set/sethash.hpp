@@ -0,0 +1,193 @@
+#ifndef SETHASH_HPP
+#define SETHASH_HPP
+
+/* ************************************************************************** */
+
+#include "../hash.hpp"
+#include "../../container/dictionary.hpp"
+#include "../../container/traversable.hpp"
+
+#include <memory>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Unordered set with open addressing (linear probing at slot granularity).
+// Every slot has a control byte: CtrlEmpty, or the low 7 bits of the hash of
+// the stored value (H2). Probing reads sixteen control bytes at a time and
+// compares all of them against H2 in one SSE2 instruction; the values are
+// touched only on a tag match. Removal shifts the rest of the probe run back
+// into the hole, so there are no tombstones and lookups never degrade.
+template <typename Data, typename Hasher = Hashable<Data>>
+class SetHash final : virtual public DictionaryContainer<Data>,
+                      virtual public TraversableContainer<Data>,
+                      virtual public ClearableContainer {
+
+private:
+
+protected:
+
+  using Container::size;
+
+  static constexpr ulong GroupWidth = 16;
+  static constexpr ulong MinCapacity = 16;
+  static constexpr signed char CtrlEmpty = -128;
+
+  [[no_unique_address]] Hasher hasher{};
+
+  signed char * control = nullptr; // capacity + GroupWidth - 1 bytes: the first group is cloned at the end
+  Data * slots = nullptr;
+  ulong capacity = 0; // Always zero or a power of two
+
+public:
+
+  // Default constructor
+  SetHash() = default;
+
+  /* ************************************************************************ */
+
+  // Specific constructors
+  SetHash(const TraversableContainer<Data> &); // A set obtained from a TraversableContainer
+  SetHash(MappableContainer<Data> &&); // A set obtained from a MappableContainer
+
+  /* ************************************************************************ */
+
+  // Copy constructor
+  SetHash(const SetHash &);
+
+  // Move constructor
+  SetHash(SetHash &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Destructor
+  virtual ~SetHash();
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  SetHash & operator=(const SetHash &);
+
+  // Move assignment
+  SetHash & operator=(SetHash &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Comparison operators
+  bool operator==(const SetHash &) const noexcept;
+  inline bool operator!=(const SetHash &) const noexcept;
+
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  void Reserve(ulong); // Grows the table so that the given number of values fits without rehashing
+
+  inline ulong Capacity() const noexcept { return capacity; }
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from DictionaryContainer)
+
+  bool Insert(const Data &) override; // Override DictionaryContainer member (copy of the value)
+  bool Insert(Data &&) override; // Override DictionaryContainer member (move of the value)
+  bool Remove(const Data &) override; // Override DictionaryContainer member
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from TestableContainer)
+
+  bool Exists(const Data &) const noexcept override; // Override TestableContainer member
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from TraversableContainer)
+
+  using typename TraversableContainer<Data>::TraverseFun;
+
+  void Traverse(TraverseFun) const override; // Override TraversableContainer member
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from ClearableContainer)
+
+  void Clear() override; // Override ClearableContainer member
+
+protected:
+
+  // Sixteen control bytes loaded at once; every query yields a bit mask with
+  // bit i set when the i-th byte of the group satisfies it.
+  struct Group {
+
+#if defined(__SSE2__)
+    __m128i ctrl;
+
+    explicit Group(const signed char * pos) noexcept
+      : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+    inline unsigned int Match(signed char tag) const noexcept {
+      return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag))));
+    }
+
+    inline unsigned int MatchEmpty() const noexcept { return Match(CtrlEmpty); }
+
+    inline unsigned int MatchFull() const noexcept {
+      return ~static_cast<unsigned int>(_mm_movemask_epi8(ctrl)) & 0xFFFFu;
+    }
+#else
+    const signed char * ctrl;
+
+    explicit Group(const signed char * pos) noexcept : ctrl(pos) {}
+
+    inline unsigned int Match(signed char tag) const noexcept {
+      unsigned int mask = 0;
+      for (ulong i = 0; i < GroupWidth; ++i) {
+        mask |= static_cast<unsigned int>(ctrl[i] == tag) << i;
+      }
+      return mask;
+    }
+
+    inline unsigned int MatchEmpty() const noexcept { return Match(CtrlEmpty); }
+
+    inline unsigned int MatchFull() const noexcept {
+      unsigned int mask = 0;
+      for (ulong i = 0; i < GroupWidth; ++i) {
+        mask |= static_cast<unsigned int>(ctrl[i] >= 0) << i;
+      }
+      return mask;
+    }
+#endif
+
+  };
+
+  inline ulong Home(ulong hash) const noexcept { return (hash >> 7) & (capacity - 1); }
+  inline static signed char Tag(ulong hash) noexcept { return static_cast<signed char>(hash & 0x7F); }
+
+  ulong Find(const Data &, ulong) const noexcept; // Slot of the value, or capacity when absent
+  ulong FindEmpty(ulong) const noexcept; // First empty slot of the probe run starting at the given slot
+
+  void SetControl(ulong, signed char) noexcept;
+  void Rehash(ulong);
+  void BackwardShift(ulong);
+  void Release() noexcept;
+
+  template <typename Value>
+  bool InsertValue(Value &&);
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "sethash.cpp"
+
+#endif
@@ -0,0 +1,150 @@
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* TOPK - CONSTRUCTORS                                                         */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+TopK<Data, Compare>::TopK(ulong count) : k(count) {
+  heap.Reserve(count);
+}
+
+// Copy constructor
+template <typename Data, typename Compare>
+TopK<Data, Compare>::TopK(const TopK & other)
+  : k(other.k), heap(other.heap), compare(other.compare) {
+  size = other.size;
+}
+
+// Move constructor
+template <typename Data, typename Compare>
+TopK<Data, Compare>::TopK(TopK && other) noexcept
+  : k(other.k), heap(std::move(other.heap)), compare(other.compare) {
+  std::swap(size, other.size);
+}
+
+/* ************************************************************************** */
+/* TOPK - ASSIGNMENT OPERATORS                                                 */
+/* ************************************************************************** */
+
+// Copy assignment
+template <typename Data, typename Compare>
+TopK<Data, Compare> & TopK<Data, Compare>::operator=(const TopK & other) {
+  if (this != &other) {
+    TopK temp{other};
+    *this = std::move(temp);
+  }
+  return *this;
+}
+
+// Move assignment
+template <typename Data, typename Compare>
+TopK<Data, Compare> & TopK<Data, Compare>::operator=(TopK && other) noexcept {
+  std::swap(k, other.k);
+  std::swap(heap, other.heap);
+  std::swap(size, other.size);
+  std::swap(compare, other.compare);
+  return *this;
+}
+
+/* ************************************************************************** */
+/* TOPK - SPECIFIC MEMBER FUNCTIONS                                            */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+bool TopK<Data, Compare>::Offer(const Data & value) {
+  return Keep(value);
+}
+
+template <typename Data, typename Compare>
+bool TopK<Data, Compare>::Offer(Data && value) {
+  return Keep(std::move(value));
+}
+
+template <typename Data, typename Compare>
+void TopK<Data, Compare>::OfferAll(const TraversableContainer<Data> & container) {
+  container.Traverse(
+    [this](const Data & dat) {
+      Keep(dat);
+    }
+  );
+}
+
+template <typename Data, typename Compare>
+void TopK<Data, Compare>::Merge(const TopK & other) {
+  if (this != &other) {
+    OfferAll(other);
+  }
+}
+
+template <typename Data, typename Compare>
+void TopK<Data, Compare>::Merge(TopK && other) {
+  if (this == &other) {
+    return;
+  }
+  while (!other.heap.Empty()) {
+    Keep(other.heap.TopNRemove());
+  }
+  other.size = 0;
+}
+
+template <typename Data, typename Compare>
+const Data & TopK<Data, Compare>::Threshold() const {
+  if (size == 0) {
+    throw std::length_error("Top-k selector is empty");
+  }
+  return heap.Top();
+}
+
+// Sorting the heap ascending under Reversed leaves the best value first
+template <typename Data, typename Compare>
+Vector<Data> TopK<Data, Compare>::Result() const {
+  HeapVec<Data, 2, Reversed> sorted(heap);
+  sorted.Sort();
+  return Vector<Data>(std::move(sorted));
+}
+
+/* ************************************************************************** */
+/* TOPK - TRAVERSABLE CONTAINER FUNCTIONS                                      */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void TopK<Data, Compare>::Traverse(TraverseFun fun) const {
+  heap.Traverse(fun);
+}
+
+/* ************************************************************************** */
+/* TOPK - CLEARABLE CONTAINER FUNCTIONS                                        */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void TopK<Data, Compare>::Clear() {
+  heap.Clear();
+  heap.Reserve(k);
+  size = 0;
+}
+
+/* ************************************************************************** */
+/* TOPK - AUXILIARY FUNCTIONS                                                  */
+/* ************************************************************************** */
+
+// Once full, the only comparison a rejected value costs is the one against the top
+template <typename Data, typename Compare>
+template <typename Item>
+bool TopK<Data, Compare>::Keep(Item && value) {
+  if (size < k) {
+    heap.Insert(std::forward<Item>(value));
+    ++size;
+    return true;
+  }
+  if (k == 0 || !compare(heap.Top(), value)) {
+    return false;
+  }
+  heap.ReplaceTop(std::forward<Item>(value));
+  return true;
+}
+
+/* ************************************************************************** */
+
+}
@@ -0,0 +1,113 @@
+#ifndef TOPK_HPP
+#define TOPK_HPP
+
+/* ************************************************************************** */
+
+#include "../vec/heapvec.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Streaming selector of the k best values offered so far (the greatest
+// under Compare, as a PQHeap would pop them first). The kept values form a
+// heap with the worst of them on top, so a value that does not make the cut
+// is rejected by a single comparison against the top, and one that does
+// replaces it in O(log k). Selectors filled on different threads combine
+// with Merge into the selector of the union.
+template <typename Data, typename Compare = std::less<Data>>
+class TopK final : virtual public TraversableContainer<Data>,
+                   virtual public ClearableContainer {
+
+private:
+
+protected:
+
+  using Container::size;
+
+  struct Reversed { // Puts the worst kept value on top of the heap
+    [[no_unique_address]] Compare compare{};
+    inline bool operator()(const Data & a, const Data & b) const { return compare(b, a); }
+  };
+
+  ulong k = 0;
+  HeapVec<Data, 2, Reversed> heap;
+
+  [[no_unique_address]] Compare compare{};
+
+public:
+
+  // Specific constructor
+  explicit TopK(ulong); // Selector of the given number of values
+
+  /* ************************************************************************ */
+
+  // Copy constructor
+  TopK(const TopK &);
+
+  // Move constructor
+  TopK(TopK &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Destructor
+  virtual ~TopK() = default;
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  TopK & operator=(const TopK &);
+
+  // Move assignment
+  TopK & operator=(TopK &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  bool Offer(const Data &); // Copy of the value; false when it was rejected
+  bool Offer(Data &&); // Move of the value; false when it was rejected
+  void OfferAll(const TraversableContainer<Data> &);
+
+  void Merge(const TopK &); // Offers every value kept by the other selector
+  void Merge(TopK &&); // Moves in every value kept by the other selector, leaving it empty
+
+  const Data & Threshold() const; // Worst kept value: only better ones get in once full (must throw std::length_error when empty)
+  Vector<Data> Result() const; // The kept values, best first
+
+  inline ulong K() const noexcept { return k; }
+  inline bool Full() const noexcept { return size == k; }
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from TraversableContainer)
+
+  using typename TraversableContainer<Data>::TraverseFun;
+
+  void Traverse(TraverseFun) const override; // Override TraversableContainer member (heap order)
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from ClearableContainer)
+
+  void Clear() override; // Override ClearableContainer member (k is kept)
+
+protected:
+
+  template <typename Item>
+  bool Keep(Item &&);
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "topk.cpp"
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef HEAPLAYOUT_HPP
+#define HEAPLAYOUT_HPP
+
+/* ************************************************************************** */
+
+#include "../../container/container.hpp"
+
+#include <algorithm>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// A layout decides where the nodes of a HeapVec live. For Data and Arity,
+// Layout::Map gives the parent of a node (never called on the root), its
+// children and an upper bound on the nodes that have children. The children
+// of a node are next to each other, count of them from first, taken while
+// below the size, and every node comes after its parent, so the first n
+// positions always form a tree and a heap stays dense whatever its size.
+
+struct HeapChildren {
+  ulong first;
+  ulong count;
+};
+
+/* ************************************************************************** */
+
+// Level by level: the children of node i are Arity * i + 1 .. Arity * i + Arity
+// A Vector starts slot 1 on a cache line, so a group of siblings that fits
+// in a line (Arity * sizeof(Data) dividing 64) never straddles two, and a
+// larger one spans as few lines as it can when its size is a multiple of 64
+struct ImplicitLayout {
+
+  template <typename Data, ulong Arity>
+  struct Map {
+    static constexpr ulong Parent(ulong index) noexcept { return (index - 1) / Arity; }
+    static constexpr ulong FirstChild(ulong index) noexcept { return Arity * index + 1; }
+    static constexpr HeapChildren Children(ulong index) noexcept { return {FirstChild(index), Arity}; }
+    static constexpr ulong Internal(ulong size) noexcept { return (size < 2) ? 0 : Parent(size - 1) + 1; }
+  };
+
+};
+
+/* ************************************************************************** */
+
+// B-heap: after the root, the positions are cut into pages of PageBytes. A
+// page holds Arity sibling subtrees, level by level: the first PageNodes
+// nodes of a complete Arity-ary tree, less its root. The children of the
+// nodes of the last levels (the frontier) are the first Arity nodes of a page
+// of their own, and the pages are numbered as a heap of pages, with the
+// children of the root in page 0. A path from the root crosses a page about
+// every log_Arity(PageNodes) levels instead of at almost every level past
+// the first pages, so a sift touches O(log n / log PageNodes) pages (and TLB
+// entries) rather than O(log n), and siblings still share a cache line.
+// The price is depth: the last level of pages fills from the left, so a
+// path may be up to a page of levels longer than in the implicit layout.
+// Pages are sized, and aligned to cache lines only (as slot 1 of a Vector
+// is): one straddling two memory pages costs at most one more. With pages of Arity nodes (Data larger than PageBytes
+// / Arity) this is the implicit layout.
+template <ulong PageBytes = 4096>
+struct PagedLayout {
+
+  template <typename Data, ulong Arity>
+  struct Map {
+    static constexpr ulong PageNodes = std::max(PageBytes / sizeof(Data), Arity);
+    static constexpr ulong Frontier = (PageNodes - 1) / Arity; // First slot of a page whose children are a page
+    static constexpr ulong Fanout = PageNodes - Frontier; // Child pages of a page
+
+    static constexpr ulong Parent(ulong index) noexcept {
+      ulong page = (index - 1) / PageNodes, slot = (index - 1) % PageNodes;
+      if (slot >= Arity) {
+        return page * PageNodes + slot / Arity;
+      }
+      if (page == 0) {
+        return 0;
+      }
+      return ((page - 1) / Fanout) * PageNodes + Frontier + (page - 1) % Fanout + 1;
+    }
+
+    static constexpr ulong FirstChild(ulong index) noexcept { return Children(index).first; }
+
+    static constexpr HeapChildren Children(ulong index) noexcept {
+      if (index == 0) {
+        return {1, Arity};
+      }
+      ulong page = (index - 1) / PageNodes, slot = (index - 1) % PageNodes;
+      if (slot < Frontier) {
+        ulong first = Arity * (slot + 1);
+        return {page * PageNodes + first + 1, std::min(Arity, PageNodes - first)};
+      }
+      return {(page * Fanout + 1 + slot - Frontier) * PageNodes + 1, Arity};
+    }
+
+    // Parents are not monotone across pages, so no tighter bound is cheap
+    static constexpr ulong Internal(ulong size) noexcept { return size; }
+  };
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#endif
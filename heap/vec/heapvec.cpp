@@ -2,109 +2,212 @@ namespace lasd {
 
 /* ************************************************************************** */
 
-template <typename Data>
-void HeapVec<Data>::BuildHeap() {
-  for (long index = (this->size / 2) - 1; index >= 0; --index) {
+// Below two threads' worth of values the default pool is not even started.
+// A pool that cannot start its threads, or a task that throws, leaves the
+// build to the calling thread: the values were only swapped, so it starts
+// over, and Sort (noexcept) never sees an exception of the pool.
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::BuildHeap() {
+  if (std::is_same_v<Layout, ImplicitLayout> && this->size >= 2 * ParallelThreshold) {
+    try {
+      BuildHeap(ThreadPool::Default());
+      return;
+    } catch (...) {
+    }
+  }
+  for (ulong index = Shape::Internal(this->size); index-- > 0; ) {
     HeapifyDown(index);
   }
 }
 
-template <typename Data>
-void HeapVec<Data>::HeapifyUp(ulong index) {
-  while (HasParent(index) && this->elements[index] > this->elements[Parent(index)]) {
-    Swap(index, Parent(index));
-    index = Parent(index);
+// Floyd's BuildHeap on a pool: the subtrees below the nodes of one level are
+// disjoint, so the first level with a few nodes per thread is cut into
+// chunks, the pool heapifies the subtrees of every chunk bottom up, and the
+// nodes above the level follow. Every node is still heapified after its
+// children, so the result is the heap of the sequential build.
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::BuildHeap(ThreadPool& pool) {
+  if (this->size < 2) {
+    return;
+  }
+  ulong top = Shape::Internal(this->size);
+  if constexpr (std::is_same_v<Layout, ImplicitLayout>) {
+    ulong threads = std::min(pool.Concurrency(), this->size / ParallelThreshold);
+    if (threads > 1) {
+      ulong chunks = 4 * threads;
+      ulong width = 1;
+      for (top = 0; width < chunks; width *= Arity) {
+        top += width;
+      }
+      pool.ParallelFor(0, chunks, 1, [&](ulong first, ulong last) {
+        for (ulong chunk = first; chunk < last; ++chunk) {
+          BuildSubtrees(top + chunk * width / chunks, top + (chunk + 1) * width / chunks);
+        }
+      });
+    }
+  }
+  for (ulong index = top; index-- > 0; ) {
+    HeapifyDown(index);
   }
 }
 
-template <typename Data>
-void HeapVec<Data>::HeapifyDown(ulong index) {
-  ulong largest = index;
+// The children of the nodes first .. last - 1 are FirstChild(first) .. FirstChild(last) - 1
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::BuildSubtrees(ulong first, ulong last) {
+  last = std::min(last, Shape::Internal(this->size));
+  if (first >= last) {
+    return;
+  }
+  BuildSubtrees(FirstChild(first), FirstChild(last));
+  for (ulong index = last; index-- > first; ) {
+    HeapifyDown(index);
+  }
+}
 
-  if (HasLeftChild(index) && this->elements[LeftChild(index)] > this->elements[largest]) {
-    largest = LeftChild(index);
+// Both sifts lift the value out once and slide the nodes on its path into
+// the hole: one move per level instead of the three of a swap
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::HeapifyUp(ulong index) {
+  if (!HasParent(index) || !Higher(this->elements[index], this->elements[Parent(index)])) {
+    return;
   }
-  if (HasRightChild(index) && this->elements[RightChild(index)] > this->elements[largest]) {
-    largest = RightChild(index);
+  Data value = std::move(this->elements[index]);
+  SiftUpHole(index, value);
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::HeapifyDown(ulong index) {
+  if (!HasChild(index)) {
+    return;
   }
-  if (largest != index) {
-    Swap(index, largest);
-    HeapifyDown(largest);
+  Data value = std::move(this->elements[index]);
+  SiftDownHole(index, value);
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::SiftUpHole(ulong hole, Data& value) {
+  while (HasParent(hole) && Higher(value, this->elements[Parent(hole)])) {
+    ulong parent = Parent(hole);
+    this->elements[hole] = std::move(this->elements[parent]);
+    hole = parent;
   }
+  this->elements[hole] = std::move(value);
 }
 
-template <typename Data>
-ulong HeapVec<Data>::Parent(ulong index) const {
-  if (index == 0) {
-    throw std::out_of_range("No parent for root element");
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::SiftDownHole(ulong hole, Data& value) {
+  for (ulong child = HighestChild(hole); child < this->size; child = HighestChild(hole)) {
+    if (!Higher(this->elements[child], value)) {
+      break;
+    }
+    this->elements[hole] = std::move(this->elements[child]);
+    hole = child;
   }
-  return (index - 1) / 2;
+  this->elements[hole] = std::move(value);
 }
 
-template <typename Data>
-ulong HeapVec<Data>::LeftChild(ulong index) const {
-  return 2 * index + 1;
+// Wegener's bottom-up descent: the hole follows the highest children down to
+// a leaf without comparing them against the value that will fill it, which
+// almost always belongs near the bottom anyway
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+ulong HeapVec<Data, Arity, Compare, Layout>::DescendHole(ulong hole) {
+  for (ulong child = HighestChild(hole); child < this->size; child = HighestChild(hole)) {
+    this->elements[hole] = std::move(this->elements[child]);
+    hole = child;
+  }
+  return hole;
 }
 
-template <typename Data>
-ulong HeapVec<Data>::RightChild(ulong index) const {
-  return 2 * index + 2;
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+ulong HeapVec<Data, Arity, Compare, Layout>::HighestChild(ulong index) const {
+  HeapChildren children = Shape::Children(index);
+  if (children.first >= this->size) {
+    return this->size;
+  }
+  ulong last = std::min(children.first + children.count, this->size);
+  ulong highest = children.first;
+  for (ulong child = children.first + 1; child < last; ++child) {
+    if (Higher(this->elements[child], this->elements[highest])) {
+      highest = child;
+    }
+  }
+  return highest;
 }
 
-template <typename Data>
-bool HeapVec<Data>::HasParent(ulong index) const noexcept {
-  return index > 0;
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+ulong HeapVec<Data, Arity, Compare, Layout>::Parent(ulong index) const {
+  if (index == 0) {
+    throw std::out_of_range("No parent for root element");
+  }
+  return Shape::Parent(index);
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+ulong HeapVec<Data, Arity, Compare, Layout>::FirstChild(ulong index) const noexcept {
+  return Shape::FirstChild(index);
 }
 
-template <typename Data>
-bool HeapVec<Data>::HasLeftChild(ulong index) const noexcept {
-  return LeftChild(index) < this->size;
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+bool HeapVec<Data, Arity, Compare, Layout>::HasParent(ulong index) const noexcept {
+  return index > 0;
 }
 
-template <typename Data>
-bool HeapVec<Data>::HasRightChild(ulong index) const noexcept {
-  return RightChild(index) < this->size;
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+bool HeapVec<Data, Arity, Compare, Layout>::HasChild(ulong index) const noexcept {
+  return FirstChild(index) < this->size;
 }
 
-template <typename Data>
-void HeapVec<Data>::Swap(ulong index1, ulong index2) {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Swap(ulong index1, ulong index2) {
   std::swap(this->elements[index1], this->elements[index2]);
 }
 
-template <typename Data>
-HeapVec<Data>::HeapVec(const TraversableContainer<Data>& con) : Heap<Data>(), SortableVector<Data>(con) {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+HeapVec<Data, Arity, Compare, Layout>::HeapVec(const TraversableContainer<Data>& con) : Heap<Data>(), SortableVector<Data>(con) {
+  capacity = this->size;
   BuildHeap();
 }
 
-template <typename Data>
-HeapVec<Data>::HeapVec(MappableContainer<Data>&& con) : Heap<Data>(), SortableVector<Data>(std::move(con)) {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+HeapVec<Data, Arity, Compare, Layout>::HeapVec(MappableContainer<Data>&& con) : Heap<Data>(), SortableVector<Data>(std::move(con)) {
+  capacity = this->size;
   BuildHeap();
 }
 
-template <typename Data>
-HeapVec<Data>::HeapVec(const HeapVec& other) : Heap<Data>(), SortableVector<Data>(other) {
-  BuildHeap();
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+HeapVec<Data, Arity, Compare, Layout>::HeapVec(const HeapVec& other) : Heap<Data>(), SortableVector<Data>(other), capacity(other.size), state(other.state), settled(other.settled), compare(other.compare) {
+  Restore();
 }
 
-template <typename Data>
-HeapVec<Data>::HeapVec(HeapVec&& other) noexcept : Heap<Data>(), SortableVector<Data>(std::move(other)) {
-  BuildHeap();
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+HeapVec<Data, Arity, Compare, Layout>::HeapVec(HeapVec&& other) noexcept : Heap<Data>(), SortableVector<Data>(std::move(other)), capacity(other.capacity), state(other.state), settled(other.settled), compare(other.compare) {
+  other.capacity = 0;
+  other.state = HeapState::Valid;
+  other.settled = 0;
 }
 
-template <typename Data>
-HeapVec<Data>& HeapVec<Data>::operator=(const HeapVec& other) {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+HeapVec<Data, Arity, Compare, Layout>& HeapVec<Data, Arity, Compare, Layout>::operator=(const HeapVec& other) {
   SortableVector<Data>::operator=(other);
+  capacity = this->size;
+  state = other.state;
+  settled = other.settled;
+  compare = other.compare;
   return *this;
 }
 
-template <typename Data>
-HeapVec<Data>& HeapVec<Data>::operator=(HeapVec&& other) noexcept {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+HeapVec<Data, Arity, Compare, Layout>& HeapVec<Data, Arity, Compare, Layout>::operator=(HeapVec&& other) noexcept {
   SortableVector<Data>::operator=(std::move(other));
+  std::swap(capacity, other.capacity);
+  std::swap(state, other.state);
+  std::swap(settled, other.settled);
+  std::swap(compare, other.compare);
   return *this;
 }
 
-template <typename Data>
-bool HeapVec<Data>::operator==(const HeapVec& other) const noexcept {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+bool HeapVec<Data, Arity, Compare, Layout>::operator==(const HeapVec& other) const noexcept {
   if (this->size != other.size) {
     return false;
   }
@@ -116,105 +219,364 @@ bool HeapVec<Data>::operator==(const HeapVec& other) const noexcept {
   return true;
 }
 
-template <typename Data>
-bool HeapVec<Data>::operator!=(const HeapVec& other) const noexcept {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+bool HeapVec<Data, Arity, Compare, Layout>::operator!=(const HeapVec& other) const noexcept {
   return !(*this == other);
 }
 
-template <typename Data>
-bool HeapVec<Data>::IsHeap() const {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+bool HeapVec<Data, Arity, Compare, Layout>::IsHeap() const {
     if (this->size == 0) {
         throw std::length_error("Heap is empty");
     }
-    
-    // Controlla la proprietà heap per ogni nodo non foglia
-    for (ulong i = 0; i < this->size / 2; ++i) {
-        ulong leftChild = 2 * i + 1;
-        ulong rightChild = 2 * i + 2;
-        
-        // Controlla figlio sinistro
-        if (leftChild < this->size && this->elements[i] < this->elements[leftChild]) {
-            return false;
-        }
-        
-        // Controlla figlio destro (se esiste)
-        if (rightChild < this->size && this->elements[i] < this->elements[rightChild]) {
+    if (state == HeapState::Valid) {
+        return true;
+    }
+    if (state == HeapState::Broken) {
+        return false;
+    }
+
+    // Controlla la proprietà heap per ogni nodo rispetto al padre
+    for (ulong i = 1; i < this->size; ++i) {
+        if (Higher(this->elements[i], this->elements[Parent(i)])) {
             return false;
         }
     }
-    
     return true;
 }
 
-template <typename Data>
-void HeapVec<Data>::Heapify() {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Heapify() {
     if (size == 0) {
         throw std::length_error("Heap is empty");
     }
     
     // Heapify dovrebbe ricostruire l'heap, non solo controllarlo
-    BuildHeap();
+    Restore();
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::ParallelHeapify(ThreadPool& pool) {
+  if (size == 0) {
+    throw std::length_error("Heap is empty");
+  }
+  Settle();
+  if (state != HeapState::Valid) {
+    BuildHeap(pool);
+    state = HeapState::Valid;
+  }
 }
 
-template <typename Data>
-void HeapVec<Data>::Sort() noexcept {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Sort() noexcept {
   if (this->size == 0) {
     return; // Change from throw to early return for noexcept compatibility
   }
 
-  ulong originalSize = this->size;
-  BuildHeap();
+  Restore();
+  SortTail(this->size - 1);
+  // Ascending order is heap order only when the first value is the highest
+  state = Higher(this->elements[this->size - 1], this->elements[0]) ? HeapState::Broken : HeapState::Valid;
+}
 
-  for (long index = this->size - 1; index > 0; --index) {
-    Swap(0, index);
-    this->size--;
-    HeapifyDown(0);
+// Only k extraction steps: O(n + k log n) instead of O(n log n)
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::SortTopK(ulong count) {
+  if (count > this->size) {
+    throw std::out_of_range("Sorting the top " + std::to_string(count) + " values of a heap of size " + std::to_string(this->size) + ".");
+  }
+  if (count == 0) {
+    return;
+  }
+  Restore();
+  SortTail(std::min(count, this->size - 1));
+  if (Higher(this->elements[this->size - 1], this->elements[0])) {
+    state = HeapState::Broken;
+  } else if (count < this->size - 1) {
+    state = HeapState::Unknown;
+  }
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::ValuesChanged() {
+  Touch();
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+Data& HeapVec<Data, Arity, Compare, Layout>::operator[](ulong index) {
+  Data& value = SortableVector<Data>::operator[](index);
+  Touch();
+  return value;
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+Data& HeapVec<Data, Arity, Compare, Layout>::Front() {
+  Data& value = SortableVector<Data>::Front();
+  Touch();
+  return value;
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+Data& HeapVec<Data, Arity, Compare, Layout>::Back() {
+  Data& value = SortableVector<Data>::Back();
+  Touch();
+  return value;
+}
+
+// Bottom-up heapsort steps: the top moves straight to its final slot, the
+// hole it leaves descends to a leaf and the displaced last value sifts up
+// from there. The values not yet extracted stay a heap at the front.
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::SortTail(ulong steps) {
+  ulong originalSize = this->size;
+  for (ulong end = originalSize - 1; steps > 0; --end, --steps) {
+    Data value = std::move(this->elements[end]);
+    this->elements[end] = std::move(this->elements[0]);
+    this->size = end;
+    SiftUpHole(DescendHole(0), value);
   }
   this->size = originalSize;
 }
 
-template <typename Data>
-void HeapVec<Data>::Clear() {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Clear() {
   SortableVector<Data>::Clear();
+  capacity = 0;
+  state = HeapState::Valid;
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Resize(ulong newSize) {
+  ulong oldSize = this->size;
+  SortableVector<Data>::Resize(newSize);
+  capacity = this->size;
+  // Dropping the last values keeps a heap a heap; added values are arbitrary
+  if (state == HeapState::Deferred) {
+    settled = std::min(settled, this->size);
+  } else if (this->size > oldSize && state == HeapState::Valid) {
+    state = HeapState::Unknown;
+  } else if (this->size < oldSize) {
+    Reorder();
+  }
 }
 
-template <typename Data>
-const Data& HeapVec<Data>::Top() const {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+const Data& HeapVec<Data, Arity, Compare, Layout>::Top() {
   if (this->size == 0) {
     throw std::length_error("Heap is empty");
   }
+  Restore();
   return this->elements[0]; // Root element is always at index 0
 }
 
-template <typename Data>
-Data HeapVec<Data>::TopNRemove() {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+const Data& HeapVec<Data, Arity, Compare, Layout>::Top() const {
   if (this->size == 0) {
     throw std::length_error("Heap is empty");
   }
-  
-  Data top = this->elements[0];
-  this->elements[0] = this->elements[this->size - 1];
-  this->size--;
-  
-  if (this->size > 0) {
-    HeapifyDown(0);
+  return this->elements[Peak()];
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+Data HeapVec<Data, Arity, Compare, Layout>::TopNRemove() {
+  if (this->size == 0) {
+    throw std::length_error("Heap is empty");
+  }
+  Restore();
+
+  Data top = std::move(this->elements[0]);
+  if (this->size > 1) {
+    Data last = std::move(this->elements[this->size - 1]);
+    std::destroy_at(this->elements + this->size - 1);
+    this->size--;
+    SiftDownHole(0, last);
+  } else {
+    std::destroy_at(this->elements);
+    this->size--;
   }
   
   return top;
 }
 
-template <typename Data>
-void HeapVec<Data>::Insert(const Data& value) {
-  SortableVector<Data>::Resize(this->size + 1);
-  this->elements[this->size - 1] = value;
-  HeapifyUp(this->size - 1);
+// The new value is constructed in place, so Data needs neither a default
+// constructor (as Resize would) nor, for the move version, a copy; the
+// storage grows geometrically, so a push is amortised O(1) moves plus the
+// sift, which bulk-append mode postpones
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Insert(const Data& value) {
+  Grow(this->size + 1);
+  std::construct_at(this->elements + this->size, value);
+  this->size++;
+  if (state != HeapState::Deferred) {
+    Reorder();
+    HeapifyUp(this->size - 1);
+  }
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Insert(Data&& value) {
+  Grow(this->size + 1);
+  std::construct_at(this->elements + this->size, std::move(value));
+  this->size++;
+  if (state != HeapState::Deferred) {
+    Reorder();
+    HeapifyUp(this->size - 1);
+  }
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::ReplaceTop(const Data& value) {
+  if (this->size == 0) {
+    throw std::length_error("Heap is empty");
+  }
+  Restore();
+  Data copy = value;
+  SiftDownHole(0, copy);
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::ReplaceTop(Data&& value) {
+  if (this->size == 0) {
+    throw std::length_error("Heap is empty");
+  }
+  Restore();
+  SiftDownHole(0, value);
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::InsertBatch(const TraversableContainer<Data>& con) {
+  Grow(this->size + con.Size());
+  ulong first = this->size;
+  try {
+    con.Traverse(
+      [this](const Data& dat) {
+        std::construct_at(this->elements + this->size, dat);
+        ++this->size;
+      }
+    );
+  } catch (...) {
+    FinishBatch(first);
+    throw;
+  }
+  FinishBatch(first);
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::InsertBatch(MappableContainer<Data>&& con) {
+  Grow(this->size + con.Size());
+  ulong first = this->size;
+  try {
+    con.Map(
+      [this](Data& dat) {
+        std::construct_at(this->elements + this->size, std::move(dat));
+        ++this->size;
+      }
+    );
+  } catch (...) {
+    FinishBatch(first);
+    throw;
+  }
+  FinishBatch(first);
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Reserve(ulong count) {
+  if (count > capacity) {
+    this->elements = SortableVector<Data>::ReallocateElements(this->elements, this->size, count);
+    capacity = count;
+  }
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Grow(ulong count) {
+  if (count > capacity) {
+    Reserve(std::max(count, 2 * capacity));
+  }
+}
+
+// Floyd's BuildHeap costs O(size); k sift-ups cost up to k * Height(), and
+// are only sound on a prefix in heap order: one not known to be is rebuilt
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::FinishBatch(ulong first) {
+  if (state == HeapState::Deferred) {
+    return;
+  }
+  ulong count = this->size - first;
+  if (state != HeapState::Valid || count * Height() > this->size) {
+    BuildHeap();
+  } else {
+    for (ulong index = first; index < this->size; ++index) {
+      HeapifyUp(index);
+    }
+  }
+  state = HeapState::Valid;
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+ulong HeapVec<Data, Arity, Compare, Layout>::Height() const noexcept {
+  ulong height = 0;
+  for (ulong nodes = 0, level = 1; nodes < this->size; level *= Arity) {
+    nodes += level;
+    ++height;
+  }
+  return height;
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::DeferHeapify() noexcept {
+  if (state != HeapState::Deferred) {
+    settled = (state == HeapState::Valid) ? this->size : 0;
+    state = HeapState::Deferred;
+  }
 }
 
-template <typename Data>
-void HeapVec<Data>::Insert(Data&& value) {
-  SortableVector<Data>::Resize(this->size + 1);
-  this->elements[this->size - 1] = std::move(value);
-  HeapifyUp(this->size - 1);
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Settle() {
+  if (state == HeapState::Deferred) {
+    state = HeapState::Valid; // The prefix is in heap order
+    FinishBatch(settled);
+  }
+}
+
+// The root of a heap; otherwise the highest of the values after the prefix
+// in heap order, and of the root of that prefix
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+ulong HeapVec<Data, Arity, Compare, Layout>::Peak() const {
+  if (state == HeapState::Valid) {
+    return 0;
+  }
+  ulong best = 0;
+  for (ulong index = (state == HeapState::Deferred) ? std::max<ulong>(settled, 1) : 1; index < this->size; ++index) {
+    if (Higher(this->elements[index], this->elements[best])) {
+      best = index;
+    }
+  }
+  return best;
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Restore() {
+  Settle();
+  if (state != HeapState::Valid) {
+    BuildHeap();
+    state = HeapState::Valid;
+  }
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Touch() noexcept {
+  if (state == HeapState::Deferred) {
+    settled = 0;
+  } else {
+    state = HeapState::Unknown;
+  }
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void HeapVec<Data, Arity, Compare, Layout>::Reorder() noexcept {
+  if (state == HeapState::Broken) {
+    state = HeapState::Unknown;
+  }
 }
 
 /* ************************************************************************** */
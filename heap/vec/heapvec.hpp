@@ -5,7 +5,12 @@
 
 #include "../heap.hpp"
 #include "../../vector/vector.hpp"
+#include "heaplayout.hpp"
+#include "../../parallel/threadpool.hpp"
+#include <algorithm>
+#include <functional>
 #include <stdexcept>
+#include <type_traits>
 
 /* ************************************************************************** */
 
@@ -13,19 +18,52 @@ namespace lasd {
 
 /* ************************************************************************** */
 
-template <typename Data>
+// Max-heap stored level by level in a vector. Every node has Arity children,
+// stored next to each other: a wider heap is shallower, so HeapifyDown takes
+// fewer dependent (cache-missing) steps, each scanning one contiguous group.
+// Compare orders the values as std::priority_queue does: with the default
+// std::less the greatest value is on top, std::greater gives a min-heap.
+// Sifting moves a hole rather than swapping, and Sort is bottom-up heapsort.
+// The heap remembers whether its values are known to be in heap order, so
+// that IsHeap, copies and Sort skip work that the order makes redundant, and
+// it can defer heapification to load many values with a single BuildHeap.
+// Large heaps are built on a ThreadPool (ImplicitLayout only).
+// Layout places the nodes (see heaplayout.hpp): level by level by default,
+// PagedLayout keeps the subtrees of very large heaps within memory pages.
+template <typename Data, ulong Arity = 2, typename Compare = std::less<Data>, typename Layout = ImplicitLayout>
 class HeapVec : virtual public Heap<Data>,
                 public SortableVector<Data> {
 
 private:
 
-  // ...
+  static_assert(Arity >= 2, "A heap node needs at least two children");
 
 protected:
 
   using SortableVector<Data>::size;
   using SortableVector<Data>::elements;
 
+  using Shape = typename Layout::template Map<Data, Arity>;
+
+  static constexpr ulong ParallelThreshold = 1UL << 16; // Values per thread, at least, of a parallel BuildHeap
+
+  ulong capacity = 0; // Allocated slots; those past size are uninitialised
+
+  // What is known about the order of the values
+  enum class HeapState : unsigned char {
+    Valid, // A heap
+    Broken, // Not a heap
+    Unknown, // Possibly changed through a mutable reference, or a heap transformed as if it were one
+    Deferred // Bulk-append mode: the values from settled on still have to be heapified
+  };
+
+  HeapState state = HeapState::Valid; // Only non-const members change it, so const ones may run concurrently
+  ulong settled = 0; // Length of the prefix in heap order, while Deferred
+
+  [[no_unique_address]] Compare compare{};
+
+  inline bool Higher(const Data & a, const Data & b) const { return compare(b, a); } // a must be above b
+
 public:
 
   // Default constructor
@@ -46,7 +84,7 @@ public:
   // Copy constructor
   HeapVec(const HeapVec& other);
 
-  // Move constructor
+  // Move constructor (the state moves along: a pending heapification stays pending)
   HeapVec(HeapVec&& other) noexcept;
 
   /* ************************************************************************ */
@@ -73,40 +111,109 @@ public:
   // Specific member functions (inherited from Heap)
 
   // Override Heap member
-  bool IsHeap() const override; // (must throw std::length_error when empty)
+  bool IsHeap() const override; // (O(1) when the state is known, checks the values otherwise; must throw std::length_error when empty)
 
   // Override Heap member
-  void Heapify() override;
+  void Heapify() override; // (O(1) on a heap; must throw std::length_error when empty)
+
+  // Heapify on the threads of a pool; a heap of fewer than two
+  // ParallelThreshold values is heapified on the calling thread
+  void ParallelHeapify(ThreadPool& = ThreadPool::Default());
 
   /* ************************************************************************ */
 
   // Specific member function (inherited from SortableLinearContainer)
   void Sort() noexcept override;
 
+  // Moves the k highest values, in ascending order, to the last k positions
+  // and leaves the others as a heap in front of them; the vector as a whole
+  // is no longer a heap (must throw std::out_of_range when k exceeds the size)
+  void SortTopK(ulong);
+
+  // Specific member function (inherited from Vector)
+  void ValuesChanged() override; // Override Vector member (the state becomes unknown)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from MutableLinearContainer)
+
+  // A mutable reference may break the heap order: the state becomes unknown
+  using SortableVector<Data>::operator[];
+  using SortableVector<Data>::Front;
+  using SortableVector<Data>::Back;
+
+  Data& operator[](ulong) override; // Override MutableLinearContainer member (must throw std::out_of_range when out of range)
+  Data& Front() override; // Override MutableLinearContainer member (must throw std::length_error when empty)
+  Data& Back() override; // Override MutableLinearContainer member (must throw std::length_error when empty)
+
   /* ************************************************************************ */
 
   void Clear() override; // Override ClearableContainer member
+
+  void Resize(ulong) override; // Override ResizableContainer member (the heap order is not restored)
   
   // Heap-specific operations
-  const Data& Top() const; // Get the top element (max element)
-  Data TopNRemove(); // Remove and return the top element
+  // The top value (must throw std::length_error when empty): the non-const
+  // version first restores the heap if need be, the const one only reads,
+  // so on a heap that is not settled it scans the values it cannot rule out
+  const Data& Top();
+  const Data& Top() const;
+  Data TopNRemove(); // Remove and return the top element, restoring the heap first if need be
   void Insert(const Data& value); // Insert an element
   void Insert(Data&& value); // Insert an element (move version)
 
+  // Overwrites the top and sifts it down: one pass instead of TopNRemove
+  // followed by Insert, on the restored heap (must throw std::length_error when empty)
+  void ReplaceTop(const Data& value);
+  void ReplaceTop(Data&& value);
+
+  // Appends every value of the container, then restores the heap once: a
+  // full BuildHeap when the batch is large compared with the heap, one
+  // sift-up per new value otherwise
+  void InsertBatch(const TraversableContainer<Data>&);
+  void InsertBatch(MappableContainer<Data>&&);
+
+  void Reserve(ulong); // Grows the storage so that the given number of values fits without reallocation
+  inline ulong Capacity() const noexcept { return capacity; }
+
+  // Bulk-append mode: Insert and InsertBatch only append, and the heap is
+  // restored once, by the first Top, TopNRemove or other member that needs it
+  void DeferHeapify() noexcept;
+  inline bool HeapifyPending() const noexcept { return state == HeapState::Deferred; }
+
 protected:
   void Swap(ulong, ulong); // Swap elements at two indices
   // Auxiliary functions, if necessary!
   void HeapifyUp(ulong);
   void HeapifyDown(ulong);
-  void BuildHeap();
+  void BuildHeap(); // On the default pool when large enough to split, on the calling thread otherwise (or when the pool fails)
+  void BuildHeap(ThreadPool&);
+  void BuildSubtrees(ulong, ulong); // Heapifies the subtrees of a range of nodes of one level, deepest level first
+  void SortTail(ulong); // Extraction steps of heapsort on a valid heap
+
+  // The node at the given index is a hole (moved from): the value is placed
+  // on its path, moving the nodes it passes into the hole one at a time
+  void SiftUpHole(ulong, Data&);
+  void SiftDownHole(ulong, Data&);
+  ulong DescendHole(ulong); // Fills the hole from its highest children down to a leaf; returns the leaf
+  ulong HighestChild(ulong) const; // The size when the node has no children
+
+  void Grow(ulong); // Geometric growth to at least the given number of slots
+  void FinishBatch(ulong); // Restores the heap after values were appended from the given position on
+  ulong Height() const noexcept;
+
+  void Settle(); // Ends bulk-append mode, heapifying the values appended
+  void Restore(); // Makes the values a heap with the least work the state allows
+  void Touch() noexcept; // A value may have changed arbitrarily
+  void Reorder() noexcept; // The values moved as in a heap: a heap is still one, a non-heap may have become one
+
+  ulong Peak() const; // Position of a highest value, found without moving any
 
   ulong Parent(ulong) const;
-  ulong LeftChild(ulong) const;
-  ulong RightChild(ulong) const;
+  ulong FirstChild(ulong) const noexcept; // The first of the children the layout gives to a node
 
   bool HasParent(ulong) const noexcept;
-  bool HasLeftChild(ulong) const noexcept;
-  bool HasRightChild(ulong) const noexcept;
+  bool HasChild(ulong) const noexcept;
 
 };
 
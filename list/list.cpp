@@ -10,7 +10,7 @@ List<Data>::Node::Node(const Data &d) : val(d) {}
 
 // Data move constructor
 template <typename Data>
-List<Data>::Node::Node(Data &&d) noexcept { std::swap(val, d); }
+List<Data>::Node::Node(Data &&d) noexcept : val(std::move(d)) {}
 
 // Copy constructor
 template <typename Data>
@@ -18,8 +18,7 @@ List<Data>::Node::Node(const Node &other) : val(other.val) {}
 
 // Move constructor
 template <typename Data>
-List<Data>::Node::Node(Node &&other) noexcept {
-    std::swap(other.val, val);
+List<Data>::Node::Node(Node &&other) noexcept : val(std::move(other.val)) {
     std::swap(other.next, next);
 }
 
@@ -223,7 +222,7 @@ Data List<Data>::FrontNRemove() {
     if (size == 0)
         throw std::length_error("Empty list");
     
-    Data value = head->val;
+    Data value = std::move(head->val);
     RemoveFromFront();
     return value;
 }
@@ -0,0 +1,42 @@
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+template <typename Data>
+void ParallelMap(Vector<Data> & vector, typename MappableContainer<Data>::MapFun fun, ulong chunk, ThreadPool & pool) {
+  if (vector.Empty()) {
+    return;
+  }
+  try {
+    pool.ParallelFor(0, vector.Size(), chunk, [&vector, &fun](ulong first, ulong last) {
+      for (ulong index = first; index < last; ++index) {
+        fun(vector.Vector<Data>::operator[](index));
+      }
+    });
+  } catch (...) {
+    vector.ValuesChanged();
+    throw;
+  }
+  vector.ValuesChanged();
+}
+
+template <typename Accumulator, typename Data>
+Accumulator ParallelFold(const Vector<Data> & vector, typename TraversableContainer<Data>::template FoldFun<Accumulator> fun,
+                         CombineFun<Accumulator> combine, Accumulator identity, ulong chunk, ThreadPool & pool) {
+  auto fold = [&vector, &fun, &identity](ulong first, ulong last) {
+    Accumulator accumulator = identity;
+    for (ulong index = first; index < last; ++index) {
+      accumulator = fun(vector.Vector<Data>::operator[](index), accumulator);
+    }
+    return accumulator;
+  };
+  auto join = [&combine](Accumulator left, Accumulator right) {
+    return combine(left, right);
+  };
+  return pool.ParallelReduce(0, vector.Size(), chunk, identity, fold, join);
+}
+
+/* ************************************************************************** */
+
+}
@@ -0,0 +1,46 @@
+#ifndef PARALLELVECTOR_HPP
+#define PARALLELVECTOR_HPP
+
+/* ************************************************************************** */
+
+#include "../vector/vector.hpp"
+#include "threadpool.hpp"
+
+#include <functional>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Parallel loops over the values of a Vector (SortableVector, HeapVec and
+// PQHeap included), kept apart from the container so that a Vector needs
+// no threads. Values are reached by non-virtual calls; once ParallelMap is
+// done (or has thrown), Vector::ValuesChanged lets a container keeping an
+// order on its values (a heap, a min-max heap) update it.
+
+template <typename Accumulator>
+using CombineFun = std::function<Accumulator(const Accumulator &, const Accumulator &)>;
+
+// Applies the function to every value, the chunks of the given number of
+// values running concurrently on the pool (the function must be safe to
+// call from several threads on different values)
+template <typename Data>
+void ParallelMap(Vector<Data> &, typename MappableContainer<Data>::MapFun, ulong, ThreadPool & = ThreadPool::Default());
+
+// Folds every chunk from the identity, concurrently, then combines the
+// results in chunk order: equals Fold from the identity when combine is
+// associative, and the chunks depend only on the chunk size, so the result
+// is the same on any pool
+template <typename Accumulator, typename Data>
+Accumulator ParallelFold(const Vector<Data> &, typename TraversableContainer<Data>::template FoldFun<Accumulator>,
+                         CombineFun<Accumulator>, Accumulator, ulong, ThreadPool & = ThreadPool::Default());
+
+/* ************************************************************************** */
+
+}
+
+#include "parallelvector.cpp"
+
+#endif
@@ -0,0 +1,210 @@
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* THREADPOOL - CONSTRUCTORS                                                   */
+/* ************************************************************************** */
+
+inline ThreadPool::ThreadPool(ulong count) : queues(new Queue[count + 1]) {
+  workers.reserve(count);
+  try {
+    for (ulong index = 0; index < count; ++index) {
+      workers.emplace_back(&ThreadPool::Work, this, index);
+    }
+  } catch (...) {
+    Stop();
+    throw;
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  Stop();
+}
+
+inline ThreadPool & ThreadPool::Default() {
+  static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1U) - 1);
+  return pool;
+}
+
+/* ************************************************************************** */
+/* THREADPOOL - PARALLEL ALGORITHMS                                            */
+/* ************************************************************************** */
+
+// The range of chunks is halved until one chunk is left, queueing the upper
+// half every time: a thief takes the largest piece left, and the owner goes
+// on with the smallest, as in a sequential loop. A piece that cannot be
+// queued runs in place instead, so every chunk is still counted down.
+template <typename Fun>
+void ThreadPool::ParallelFor(ulong first, ulong last, ulong grain, Fun fun) {
+  if (first >= last) {
+    return;
+  }
+  grain = std::max<ulong>(grain, 1);
+  ulong chunks = (last - first - 1) / grain + 1;
+  if (chunks == 1 || Deterministic()) {
+    for (ulong chunk = 0; chunk < chunks; ++chunk) {
+      fun(first + chunk * grain, std::min(first + (chunk + 1) * grain, last));
+    }
+    return;
+  }
+
+  std::atomic<ulong> pending{chunks};
+  std::exception_ptr failure;
+  std::mutex failureLock;
+  auto record = [&failure, &failureLock]() {
+    std::lock_guard<std::mutex> guard(failureLock);
+    if (!failure) {
+      failure = std::current_exception();
+    }
+  };
+  auto split = [&](auto & split, ulong low, ulong high) -> void {
+    while (high - low > 1) {
+      ulong middle = low + (high - low) / 2;
+      try {
+        Push([&split, middle, high] { split(split, middle, high); });
+      } catch (...) {
+        record();
+        break;
+      }
+      high = middle;
+    }
+    for (ulong chunk = low; chunk < high; ++chunk) {
+      try {
+        fun(first + chunk * grain, std::min(first + (chunk + 1) * grain, last));
+      } catch (...) {
+        record();
+      }
+    }
+    pending.fetch_sub(high - low, std::memory_order_acq_rel); // Last access to the frame of the loop
+  };
+  split(split, 0, chunks);
+
+  while (pending.load(std::memory_order_acquire) > 0) {
+    if (!RunOne()) {
+      std::this_thread::yield();
+    }
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
+
+template <typename Value, typename Map, typename Combine>
+Value ThreadPool::ParallelReduce(ulong first, ulong last, ulong grain, Value identity, Map map, Combine combine) {
+  if (first >= last) {
+    return identity;
+  }
+  grain = std::max<ulong>(grain, 1);
+  ulong chunks = (last - first - 1) / grain + 1;
+  std::vector<Value> partials(chunks, identity);
+  ParallelFor(0, chunks, 1, [&](ulong begin, ulong end) {
+    for (ulong chunk = begin; chunk < end; ++chunk) {
+      partials[chunk] = map(first + chunk * grain, std::min(first + (chunk + 1) * grain, last));
+    }
+  });
+  Value result = std::move(identity);
+  for (Value & partial : partials) {
+    result = combine(std::move(result), std::move(partial));
+  }
+  return result;
+}
+
+/* ************************************************************************** */
+/* THREADPOOL - AUXILIARY FUNCTIONS                                            */
+/* ************************************************************************** */
+
+// The sleepers and queued counters are a Dekker pair: a worker going to
+// sleep counts itself before checking for work, a pusher queues before
+// checking for sleepers, so at least one of them sees the other
+inline void ThreadPool::Push(Task task) {
+  ulong index = (current == this) ? self : workers.size();
+  {
+    std::lock_guard<std::mutex> guard(queues[index].lock);
+    queues[index].tasks.push_back(std::move(task));
+  }
+  queued.fetch_add(1, std::memory_order_seq_cst);
+  if (sleepers.load(std::memory_order_seq_cst) > 0) {
+    { std::lock_guard<std::mutex> guard(sleepLock); }
+    wake.notify_one();
+  }
+}
+
+inline bool ThreadPool::RunOne() {
+  if (queued.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  Task task;
+  ulong count = workers.size();
+  ulong mine = (current == this) ? self : Nil;
+  bool found = (mine != Nil && Take(mine, true, task)) || Take(count, false, task);
+  for (ulong step = 0, start = Random() % count; !found && step < count; ++step) {
+    ulong victim = (start + step) % count;
+    if (victim != mine && Take(victim, false, task)) {
+      steals.fetch_add(1, std::memory_order_relaxed);
+      found = true;
+    }
+  }
+  if (found) {
+    task();
+  }
+  return found;
+}
+
+inline bool ThreadPool::Take(ulong index, bool back, Task & task) {
+  std::lock_guard<std::mutex> guard(queues[index].lock);
+  std::deque<Task> & tasks = queues[index].tasks;
+  if (tasks.empty()) {
+    return false;
+  }
+  if (back) {
+    task = std::move(tasks.back());
+    tasks.pop_back();
+  } else {
+    task = std::move(tasks.front());
+    tasks.pop_front();
+  }
+  queued.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+inline void ThreadPool::Work(ulong index) {
+  current = this;
+  self = index;
+  while (true) {
+    if (RunOne()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(sleepLock);
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    wake.wait(guard, [this] { return stopping || queued.load(std::memory_order_seq_cst) > 0; });
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+    if (stopping) {
+      return;
+    }
+  }
+}
+
+inline void ThreadPool::Stop() noexcept {
+  {
+    std::lock_guard<std::mutex> guard(sleepLock);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread & worker : workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+inline ulong ThreadPool::Random() noexcept {
+  thread_local std::uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+/* ************************************************************************** */
+
+}
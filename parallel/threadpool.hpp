@@ -0,0 +1,135 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+/* ************************************************************************** */
+
+#include "../container/container.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Work-stealing thread pool shared by the parallel algorithms. Every worker
+// owns a deque of tasks: it pushes and pops at the back, where the data is
+// still warm, and an idle worker steals from the front of another deque,
+// where the largest pieces of work are. Threads outside the pool queue their
+// tasks in a shared injection queue. A thread waiting for its tasks runs
+// queued tasks meanwhile, so parallel loops may nest freely. The deques are
+// behind short mutex sections, and idle workers sleep until work arrives.
+// In deterministic mode (always with no workers) every loop runs on the
+// calling thread, chunk after chunk in order.
+class ThreadPool final {
+
+private:
+
+protected:
+
+  using Task = std::function<void()>;
+
+  static constexpr ulong Nil = static_cast<ulong>(-1);
+
+  struct alignas(64) Queue { // One cache line at least, so queues never share a line
+    std::mutex lock;
+    std::deque<Task> tasks;
+  };
+
+  std::unique_ptr<Queue[]> queues; // One per worker, then the injection queue
+  std::vector<std::thread> workers;
+
+  std::atomic<ulong> queued{0}; // Tasks in all queues
+  std::atomic<ulong> sleepers{0};
+  std::atomic<ulong> steals{0};
+  std::atomic<bool> deterministic{false};
+  bool stopping = false; // Guarded by sleepLock
+
+  std::mutex sleepLock;
+  std::condition_variable wake;
+
+  static inline thread_local const ThreadPool * current = nullptr; // Pool of the calling worker
+  static inline thread_local ulong self = Nil; // Index of the calling worker
+
+public:
+
+  // Specific constructor
+  explicit ThreadPool(ulong); // A pool with the given number of workers (0: deterministic)
+
+  /* ************************************************************************ */
+
+  // Copy constructor
+  ThreadPool(const ThreadPool &) = delete;
+
+  // Move constructor
+  ThreadPool(ThreadPool &&) = delete;
+
+  /* ************************************************************************ */
+
+  // Destructor (no loop may be running)
+  virtual ~ThreadPool();
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  ThreadPool & operator=(const ThreadPool &) = delete;
+
+  // Move assignment
+  ThreadPool & operator=(ThreadPool &&) = delete;
+
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  inline ulong Workers() const noexcept { return workers.size(); }
+  inline ulong Concurrency() const noexcept { return Deterministic() ? 1 : Workers() + 1; } // The caller works too
+  inline ulong Steals() const noexcept { return steals.load(std::memory_order_relaxed); }
+
+  inline bool Deterministic() const noexcept { return workers.empty() || deterministic.load(std::memory_order_relaxed); }
+  inline void SetDeterministic(bool on) noexcept { deterministic.store(on, std::memory_order_relaxed); }
+
+  // Calls fun(begin, end) on the chunks of at most grain indices of [first,
+  // last), concurrently, and returns when all are done; the first exception
+  // thrown by a chunk is rethrown, after the other chunks have run
+  template <typename Fun>
+  void ParallelFor(ulong, ulong, ulong, Fun);
+
+  // Combines, from the identity, the values map(begin, end) of the chunks of
+  // ParallelFor in chunk order: the chunks depend only on the range and the
+  // grain, so the result does not depend on the threads (rounding included)
+  template <typename Value, typename Map, typename Combine>
+  Value ParallelReduce(ulong, ulong, ulong, Value, Map, Combine);
+
+  // Process-wide pool: one thread per hardware thread, the caller included
+  static ThreadPool & Default();
+
+protected:
+
+  void Push(Task); // To the back of the deque of the calling worker, or to the injection queue
+  bool RunOne(); // Runs a task, stolen if need be; false when none was found
+  bool Take(ulong, bool, Task &); // From the back or the front of a queue
+  void Work(ulong); // Worker loop
+  void Stop() noexcept; // Wakes the workers up to leave and joins them
+
+  static ulong Random() noexcept; // Per-thread generator, no shared state
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "threadpool.cpp"
+
+#endif
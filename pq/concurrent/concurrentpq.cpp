@@ -0,0 +1,146 @@
+
+#include <thread>
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* SPINLOCK                                                                    */
+/* ************************************************************************** */
+
+// Waits on a plain load, so only the attempt that may succeed writes the line
+inline void SpinLock::Lock() noexcept {
+  for (ulong spins = 0; !TryLock(); ++spins) {
+    if (spins >= 64) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+/* ************************************************************************** */
+/* CONCURRENTPQ - CONSTRUCTORS                                                 */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+ConcurrentPQ<Data, Compare>::ConcurrentPQ(ulong threads) {
+  if (threads == 0) {
+    throw std::invalid_argument("A concurrent priority queue needs at least one thread.");
+  }
+  count = std::max<ulong>(2, Factor * threads);
+  shards = std::make_unique<Shard[]>(count);
+}
+
+/* ************************************************************************** */
+/* CONCURRENTPQ - SPECIFIC MEMBER FUNCTIONS                                    */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void ConcurrentPQ<Data, Compare>::Insert(const Data & value) {
+  Push(value);
+}
+
+template <typename Data, typename Compare>
+void ConcurrentPQ<Data, Compare>::Insert(Data && value) {
+  Push(std::move(value));
+}
+
+// A busy shard is skipped rather than waited for; a pair with an empty shard
+// still yields the other tip, and only when a few pairs were both empty does
+// the removal fall back to sweeping every shard. An empty Size ends the search
+// at once: a value whose Insert has not returned yet may be missed.
+template <typename Data, typename Compare>
+bool ConcurrentPQ<Data, Compare>::TryTipNRemove(Data & value) {
+  for (ulong attempt = 0; attempt < 4 * count; ) {
+    if (Size() == 0) {
+      return false;
+    }
+    ulong first = Random() % count, second = Random() % (count - 1);
+    second += (second >= first);
+    Shard & a = shards[std::min(first, second)];
+    Shard & b = shards[std::max(first, second)];
+    if (!a.lock.TryLock()) {
+      continue;
+    }
+    if (!b.lock.TryLock()) {
+      a.lock.Unlock();
+      continue;
+    }
+    bool found = PopBetter(a, b, value);
+    b.lock.Unlock();
+    a.lock.Unlock();
+    if (found) {
+      return true;
+    }
+    ++attempt;
+  }
+  return Sweep(value);
+}
+
+/* ************************************************************************** */
+/* CONCURRENTPQ - AUXILIARY FUNCTIONS                                          */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+ulong ConcurrentPQ<Data, Compare>::Random() noexcept {
+  thread_local std::uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+template <typename Data, typename Compare>
+template <typename Item>
+void ConcurrentPQ<Data, Compare>::Push(Item && value) {
+  ulong index = Random() % count;
+  while (!shards[index].lock.TryLock()) {
+    index = Random() % count;
+  }
+  try {
+    shards[index].heap.Insert(std::forward<Item>(value));
+  } catch (...) {
+    shards[index].lock.Unlock();
+    throw;
+  }
+  size.fetch_add(1, std::memory_order_relaxed); // Under the lock, before any pop of the value can count it out
+  shards[index].lock.Unlock();
+}
+
+template <typename Data, typename Compare>
+bool ConcurrentPQ<Data, Compare>::PopBetter(Shard & a, Shard & b, Data & value) {
+  Shard * best = nullptr;
+  if (!a.heap.Empty()) {
+    best = &a;
+  }
+  if (!b.heap.Empty() && (best == nullptr || compare(best->heap.Tip(), b.heap.Tip()))) {
+    best = &b;
+  }
+  if (best == nullptr) {
+    return false;
+  }
+  value = best->heap.TipNRemove();
+  size.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+template <typename Data, typename Compare>
+bool ConcurrentPQ<Data, Compare>::Sweep(Data & value) {
+  ulong start = Random() % count;
+  for (ulong step = 0; step < count; ++step) {
+    Shard & shard = shards[(start + step) % count];
+    shard.lock.Lock();
+    bool found = !shard.heap.Empty();
+    if (found) {
+      value = shard.heap.TipNRemove();
+      size.fetch_sub(1, std::memory_order_relaxed);
+    }
+    shard.lock.Unlock();
+    if (found) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* ************************************************************************** */
+
+}
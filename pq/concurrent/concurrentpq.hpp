@@ -0,0 +1,126 @@
+#ifndef CONCURRENTPQ_HPP
+#define CONCURRENTPQ_HPP
+
+/* ************************************************************************** */
+
+#include "../heap/pqheap.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Test-and-test-and-set lock for critical sections of a few hundred cycles
+class SpinLock {
+
+private:
+
+  std::atomic<bool> locked{false};
+
+public:
+
+  inline bool TryLock() noexcept {
+    return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+  }
+
+  void Lock() noexcept;
+
+  inline void Unlock() noexcept { locked.store(false, std::memory_order_release); }
+
+};
+
+/* ************************************************************************** */
+
+// Relaxed concurrent priority queue (MultiQueue): Factor * threads PQHeap
+// shards, each behind its own spin lock. Insert goes to a random free shard;
+// removal locks two random shards and pops the better of their tips, so the
+// removed value is close to, though not always, the global top (its expected
+// rank is O(shards)). The queue is neither copyable nor movable, and Size is
+// only a snapshot while other threads are working on it.
+template <typename Data, typename Compare = std::less<Data>>
+class ConcurrentPQ final {
+
+private:
+
+protected:
+
+  struct alignas(64) Shard { // One cache line at least, so shards never share a line
+    SpinLock lock;
+    PQHeap<Data, 2, Compare> heap;
+  };
+
+  ulong count = 0;
+  std::unique_ptr<Shard[]> shards;
+  alignas(64) std::atomic<ulong> size{0};
+
+  [[no_unique_address]] Compare compare{};
+
+public:
+
+  static constexpr ulong Factor = 2; // Shards per thread: more shards, less contention but larger rank error
+
+  // Specific constructor
+  explicit ConcurrentPQ(ulong threads); // Queue for the given number of threads (must throw std::invalid_argument when zero)
+
+  /* ************************************************************************ */
+
+  // Copy constructor
+  ConcurrentPQ(const ConcurrentPQ &) = delete;
+
+  // Move constructor
+  ConcurrentPQ(ConcurrentPQ &&) = delete;
+
+  /* ************************************************************************ */
+
+  // Destructor
+  virtual ~ConcurrentPQ() = default;
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  ConcurrentPQ & operator=(const ConcurrentPQ &) = delete;
+
+  // Move assignment
+  ConcurrentPQ & operator=(ConcurrentPQ &&) = delete;
+
+  /* ************************************************************************ */
+
+  // Specific member functions (all thread safe)
+
+  void Insert(const Data &); // Copy of the value
+  void Insert(Data &&); // Move of the value
+
+  bool TryTipNRemove(Data &); // Moves a value close to the top out; false when the queue was found empty
+
+  inline ulong Size() const noexcept { return size.load(std::memory_order_relaxed); } // Approximate while threads are working
+  inline bool Empty() const noexcept { return Size() == 0; }
+
+  inline ulong Shards() const noexcept { return count; }
+
+protected:
+
+  static ulong Random() noexcept; // Per-thread generator, no shared state
+
+  template <typename Item>
+  void Push(Item &&);
+
+  bool PopBetter(Shard &, Shard &, Data &); // Both shards locked by the caller
+
+  bool Sweep(Data &); // Tries every shard in turn (the slow path near empty)
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "concurrentpq.cpp"
+
+#endif
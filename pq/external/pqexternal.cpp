@@ -0,0 +1,488 @@
+
+#include <algorithm>
+#include <new>
+#include <numeric>
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* PQEXTERNAL - CONSTRUCTORS                                                   */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+PQExternal<Data, Compare>::PQExternal() : PQExternal(DefaultBudget) {
+}
+
+// Half the budget for the buffer, the other half for MaxRuns run blocks, the
+// block of a new run and the output block of a merge
+template <typename Data, typename Compare>
+PQExternal<Data, Compare>::PQExternal(ulong bytes) : budget(bytes) {
+  bufferCapacity = std::max<ulong>(1, budget / 2 / sizeof(Data));
+  blockCount = std::max<ulong>(1, bufferCapacity / (MaxRuns + 2));
+  buffer.DeferHeapify();
+}
+
+template <typename Data, typename Compare>
+PQExternal<Data, Compare>::PQExternal(const TraversableContainer<Data> & container) : PQExternal() {
+  container.Traverse(
+    [this](const Data & dat) {
+      Push(dat);
+    }
+  );
+}
+
+template <typename Data, typename Compare>
+PQExternal<Data, Compare>::PQExternal(MappableContainer<Data> && container) : PQExternal() {
+  container.Map(
+    [this](Data & dat) {
+      Push(dat);
+    }
+  );
+}
+
+/* ************************************************************************** */
+/* PQEXTERNAL - COPY AND MOVE CONSTRUCTORS                                     */
+/* ************************************************************************** */
+
+// Copy constructor (the unread part of every run goes to a new file, block by block)
+template <typename Data, typename Compare>
+PQExternal<Data, Compare>::PQExternal(const PQExternal & other) : PQExternal(other.budget) {
+  buffer = other.buffer;
+  compare = other.compare;
+  runs.reserve(other.runs.size());
+  Block chunk = NewBlock();
+  for (const Run & from : other.runs) {
+    Run to;
+    to.block = NewBlock();
+    to.filled = from.filled - from.head;
+    std::copy(from.block.get() + from.head, from.block.get() + from.filled, to.block.get());
+    to.file = NewFile();
+    to.stored = from.stored - from.offset;
+    for (ulong done = 0; done < to.stored; ) {
+      ulong count = std::min(blockCount, to.stored - done);
+      Read(from, from.offset + done, count, chunk.get());
+      Write(to.file.get(), chunk.get(), count);
+      done += count;
+    }
+    runs.push_back(std::move(to));
+  }
+  heads = other.heads;
+  size = other.size;
+}
+
+// Move constructor
+template <typename Data, typename Compare>
+PQExternal<Data, Compare>::PQExternal(PQExternal && other) noexcept : PQExternal(DefaultBudget) {
+  *this = std::move(other);
+}
+
+/* ************************************************************************** */
+/* PQEXTERNAL - ASSIGNMENT OPERATORS                                           */
+/* ************************************************************************** */
+
+// Copy assignment
+template <typename Data, typename Compare>
+PQExternal<Data, Compare> & PQExternal<Data, Compare>::operator=(const PQExternal & other) {
+  if (this != &other) {
+    PQExternal temp{other};
+    *this = std::move(temp);
+  }
+  return *this;
+}
+
+// Move assignment
+template <typename Data, typename Compare>
+PQExternal<Data, Compare> & PQExternal<Data, Compare>::operator=(PQExternal && other) noexcept {
+  std::swap(budget, other.budget);
+  std::swap(bufferCapacity, other.bufferCapacity);
+  std::swap(blockCount, other.blockCount);
+  PQHeap<Data, 2, Compare> temp(std::move(buffer));
+  buffer = std::move(other.buffer);
+  other.buffer = std::move(temp);
+  std::swap(runs, other.runs);
+  std::swap(heads, other.heads);
+  std::swap(compare, other.compare);
+  std::swap(size, other.size);
+  return *this;
+}
+
+/* ************************************************************************** */
+/* PQEXTERNAL - SPECIFIC MEMBER FUNCTIONS                                      */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+ulong PQExternal<Data, Compare>::OnDisk() const noexcept {
+  ulong count = 0;
+  for (const Run & run : runs) {
+    count += run.stored - run.offset;
+  }
+  return count;
+}
+
+/* ************************************************************************** */
+/* PQEXTERNAL - PQ FUNCTIONS                                                   */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+const Data & PQExternal<Data, Compare>::Tip() const {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return FromBuffer() ? buffer.Tip() : Head(heads.front());
+}
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::RemoveTip() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  Pop();
+}
+
+template <typename Data, typename Compare>
+Data PQExternal<Data, Compare>::TipNRemove() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return Pop();
+}
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Insert(const Data & value) {
+  Push(value);
+}
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Insert(Data && value) {
+  Push(value);
+}
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Change(ulong index, const Data & value) {
+  Replace(index, value);
+}
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Change(ulong index, Data && value) {
+  Replace(index, value);
+}
+
+/* ************************************************************************** */
+/* PQEXTERNAL - LINEAR CONTAINER FUNCTIONS                                     */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+const Data & PQExternal<Data, Compare>::operator[](ulong index) const {
+  if (index >= size) {
+    throw std::out_of_range("Access at index " + std::to_string(index) + "; priority queue size " + std::to_string(size) + ".");
+  }
+  auto [run, position] = Locate(index);
+  if (run == runs.size()) {
+    return buffer[position];
+  }
+  const Run & from = runs[run];
+  ulong inBlock = from.filled - from.head;
+  if (position < inBlock) {
+    return from.block[from.head + position];
+  }
+  Data * slot = reinterpret_cast<Data *>(fetched);
+  Read(from, from.offset + position - inBlock, 1, slot);
+  return *std::launder(slot);
+}
+
+/* ************************************************************************** */
+/* PQEXTERNAL - TRAVERSABLE CONTAINER FUNCTIONS                                */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Traverse(TraverseFun fun) const {
+  PreOrderTraverse(fun);
+}
+
+// The values on disk are streamed through one block
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::PreOrderTraverse(TraverseFun fun) const {
+  buffer.PreOrderTraverse(fun);
+  Block chunk;
+  for (const Run & run : runs) {
+    for (ulong index = run.head; index < run.filled; ++index) {
+      fun(run.block[index]);
+    }
+    if (run.offset < run.stored && chunk == nullptr) {
+      chunk = NewBlock();
+    }
+    for (ulong first = run.offset; first < run.stored; ) {
+      ulong count = std::min(blockCount, run.stored - first);
+      Read(run, first, count, chunk.get());
+      for (ulong index = 0; index < count; ++index) {
+        fun(chunk[index]);
+      }
+      first += count;
+    }
+  }
+}
+
+// Reverse index order, as for every LinearContainer
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::PostOrderTraverse(TraverseFun fun) const {
+  Block chunk;
+  for (ulong which = runs.size(); which-- > 0; ) {
+    const Run & run = runs[which];
+    if (run.offset < run.stored && chunk == nullptr) {
+      chunk = NewBlock();
+    }
+    for (ulong last = run.stored; last > run.offset; ) {
+      ulong count = std::min(blockCount, last - run.offset);
+      last -= count;
+      Read(run, last, count, chunk.get());
+      for (ulong index = count; index-- > 0; ) {
+        fun(chunk[index]);
+      }
+    }
+    for (ulong index = run.filled; index > run.head; ) {
+      fun(run.block[--index]);
+    }
+  }
+  buffer.PostOrderTraverse(fun);
+}
+
+/* ************************************************************************** */
+/* PQEXTERNAL - CLEARABLE CONTAINER FUNCTIONS                                  */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Clear() {
+  Release();
+}
+
+/* ************************************************************************** */
+/* PQEXTERNAL - AUXILIARY FUNCTIONS                                            */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+bool PQExternal<Data, Compare>::FromBuffer() const {
+  return heads.empty() || (!buffer.Empty() && !Lower(buffer.Tip(), Head(heads.front())));
+}
+
+// The buffer only appends between spills (bulk-append mode), so a run costs
+// one BuildHeap and one heapsort
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Push(const Data & value) {
+  if (buffer.Size() >= bufferCapacity) {
+    Spill();
+  }
+  buffer.Insert(value);
+  ++size;
+}
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Replace(ulong index, const Data & value) {
+  if (index >= size) {
+    throw std::out_of_range("Access at index " + std::to_string(index) + "; priority queue size " + std::to_string(size) + ".");
+  }
+  auto [run, position] = Locate(index);
+  if (run == runs.size()) {
+    buffer.Change(position, value);
+    return;
+  }
+  RemoveFromRun(run, position);
+  --size;
+  Push(value);
+}
+
+template <typename Data, typename Compare>
+Data PQExternal<Data, Compare>::Pop() {
+  if (FromBuffer()) {
+    --size;
+    return buffer.TipNRemove();
+  }
+  ulong run = heads.front();
+  Data value = Head(run);
+  Advance(run);
+  --size;
+  return value;
+}
+
+// The sorted buffer is reversed in place, so a run is read highest first;
+// its first block is taken from memory rather than read back
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Spill() {
+  ulong count = buffer.Size();
+  if (count == 0) {
+    return;
+  }
+  buffer.Sort();
+  Data * values = &buffer[0];
+  std::reverse(values, values + count);
+
+  Run run;
+  run.file = NewFile();
+  Write(run.file.get(), values, count);
+  run.block = NewBlock();
+  run.filled = std::min(blockCount, count);
+  std::copy(values, values + run.filled, run.block.get());
+  run.offset = run.filled;
+  run.stored = count;
+  runs.push_back(std::move(run));
+
+  buffer.Clear();
+  buffer.Reserve(bufferCapacity);
+  buffer.DeferHeapify();
+  RebuildHeads();
+  if (runs.size() > MaxRuns) {
+    MergeRuns();
+  }
+}
+
+// A multiway merge through the heads heap; the output block becomes the
+// block of the merged run
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::MergeRuns() {
+  Run merged;
+  merged.file = NewFile();
+  Block out = NewBlock();
+  ulong count = 0;
+  while (!heads.empty()) {
+    ulong run = heads.front();
+    out[count++] = Head(run);
+    Advance(run);
+    if (count == blockCount) {
+      Write(merged.file.get(), out.get(), count);
+      merged.stored += count;
+      count = 0;
+    }
+  }
+  Write(merged.file.get(), out.get(), count);
+  merged.stored += count;
+  merged.block = std::move(out);
+  Refill(merged);
+  runs.clear();
+  runs.push_back(std::move(merged));
+  RebuildHeads();
+}
+
+// The run must be the first of the heads heap
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Advance(ulong run) {
+  auto order = [this](ulong a, ulong b) { return LowerHead(a, b); };
+  std::pop_heap(heads.begin(), heads.end(), order);
+  Run & from = runs[run];
+  if (++from.head < from.filled || Refill(from)) {
+    std::push_heap(heads.begin(), heads.end(), order);
+  } else {
+    runs.erase(runs.begin() + run);
+    RebuildHeads();
+  }
+}
+
+// Within the block the values before it shift one place; on disk the rest
+// of the run is copied to a new file without it
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::RemoveFromRun(ulong run, ulong position) {
+  Run & from = runs[run];
+  ulong inBlock = from.filled - from.head;
+  if (position < inBlock) {
+    Data * block = from.block.get();
+    std::copy_backward(block + from.head, block + from.head + position, block + from.head + position + 1);
+    ++from.head;
+  } else {
+    ulong skip = from.offset + position - inBlock;
+    File file = NewFile();
+    Block chunk = NewBlock();
+    auto copy = [&](ulong first, ulong last) {
+      while (first < last) {
+        ulong count = std::min(blockCount, last - first);
+        Read(from, first, count, chunk.get());
+        Write(file.get(), chunk.get(), count);
+        first += count;
+      }
+    };
+    copy(from.offset, skip);
+    copy(skip + 1, from.stored);
+    from.stored -= from.offset + 1;
+    from.offset = 0;
+    from.file = std::move(file);
+  }
+  if (from.head == from.filled && !Refill(from)) {
+    runs.erase(runs.begin() + run);
+  }
+  RebuildHeads();
+}
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::RebuildHeads() {
+  heads.resize(runs.size());
+  std::iota(heads.begin(), heads.end(), 0UL);
+  std::make_heap(heads.begin(), heads.end(), [this](ulong a, ulong b) { return LowerHead(a, b); });
+}
+
+template <typename Data, typename Compare>
+bool PQExternal<Data, Compare>::Refill(Run & run) {
+  run.head = run.filled = 0;
+  if (run.offset == run.stored) {
+    return false;
+  }
+  ulong count = std::min(blockCount, run.stored - run.offset);
+  Read(run, run.offset, count, run.block.get());
+  run.offset += count;
+  run.filled = count;
+  return true;
+}
+
+// Every read seeks first, so reads for operator[] and traversals do not
+// disturb the sequential refills
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Read(const Run & run, ulong position, ulong count, Data * into) const {
+  if (std::fseek(run.file.get(), static_cast<long>(position * sizeof(Data)), SEEK_SET) != 0
+      || std::fread(into, sizeof(Data), count, run.file.get()) != count) {
+    throw std::runtime_error("Cannot read a run back from its temporary file.");
+  }
+}
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Write(std::FILE * file, const Data * values, ulong count) const {
+  if (std::fwrite(values, sizeof(Data), count, file) != count) {
+    throw std::runtime_error("Cannot write a run to a temporary file.");
+  }
+}
+
+template <typename Data, typename Compare>
+typename PQExternal<Data, Compare>::File PQExternal<Data, Compare>::NewFile() const {
+  std::FILE * file = std::tmpfile();
+  if (file == nullptr) {
+    throw std::runtime_error("Cannot create a temporary file for a run.");
+  }
+  return File(file);
+}
+
+template <typename Data, typename Compare>
+typename PQExternal<Data, Compare>::Block PQExternal<Data, Compare>::NewBlock() const {
+  return Block(std::allocator<Data>().allocate(blockCount), BlockDeleter{blockCount});
+}
+
+template <typename Data, typename Compare>
+std::pair<ulong, ulong> PQExternal<Data, Compare>::Locate(ulong index) const {
+  if (index < buffer.Size()) {
+    return {runs.size(), index};
+  }
+  index -= buffer.Size();
+  ulong run = 0;
+  while (index >= Remaining(runs[run])) {
+    index -= Remaining(runs[run]);
+    ++run;
+  }
+  return {run, index};
+}
+
+template <typename Data, typename Compare>
+void PQExternal<Data, Compare>::Release() noexcept {
+  runs.clear();
+  heads.clear();
+  buffer.Clear();
+  buffer.DeferHeapify();
+  size = 0;
+}
+
+/* ************************************************************************** */
+
+}
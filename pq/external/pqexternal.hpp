@@ -0,0 +1,200 @@
+#ifndef PQEXTERNAL_HPP
+#define PQEXTERNAL_HPP
+
+/* ************************************************************************** */
+
+#include "../pq.hpp"
+#include "../heap/pqheap.hpp"
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// External-memory priority queue that keeps about Budget() bytes of values
+// in memory. New values go to an in-memory heap buffer holding half the
+// budget; a full buffer is sorted and spilled to a temporary file as a run,
+// highest value first. Every run is read sequentially through an in-memory
+// block, and a small heap of run indices, ordered by the head of their
+// block, merges the runs with the buffer: the tip is the higher of the
+// buffer top and the first run head. Beyond MaxRuns runs, all of them are
+// merged into one, so the blocks never outgrow the other half of the budget.
+// Values are written and read as raw bytes, hence Data must be trivially
+// copyable. Index i covers the buffer first, then the runs in order, so
+// operator[] and Change may read from disk; a value read from disk is
+// returned through a scratch slot, valid until the next access.
+// Compare orders the values as in PQHeap.
+template <typename Data, typename Compare = std::less<Data>>
+class PQExternal final : virtual public PQ<Data> {
+
+private:
+
+  static_assert(std::is_trivially_copyable_v<Data>, "Values spilled to disk must be trivially copyable");
+
+protected:
+
+  using Container::size;
+
+  static constexpr ulong DefaultBudget = 1UL << 26;
+  static constexpr ulong MaxRuns = 16;
+
+  struct FileCloser {
+    void operator()(std::FILE * file) const noexcept { std::fclose(file); }
+  };
+
+  struct BlockDeleter {
+    ulong count = 0;
+    void operator()(Data * block) const noexcept { std::allocator<Data>().deallocate(block, count); }
+  };
+
+  using File = std::unique_ptr<std::FILE, FileCloser>; // Temporary file, deleted when closed
+  using Block = std::unique_ptr<Data[], BlockDeleter>; // blockCount values
+
+  struct Run {
+    File file; // Unread values from offset to stored
+    ulong offset = 0;
+    ulong stored = 0;
+    Block block; // Values read from the file and not yet removed, from head to filled
+    ulong head = 0;
+    ulong filled = 0;
+  };
+
+  ulong budget = DefaultBudget;
+  ulong bufferCapacity = 0; // Values the buffer holds before spilling
+  ulong blockCount = 0; // Values per run block
+
+  PQHeap<Data, 2, Compare> buffer;
+  std::vector<Run> runs;
+  std::vector<ulong> heads; // Heap of run indices, the run with the highest head first
+
+  alignas(Data) mutable unsigned char fetched[sizeof(Data)]; // Scratch slot of operator[] for values on disk
+
+  [[no_unique_address]] Compare compare{};
+
+  inline bool Lower(const Data & a, const Data & b) const { return compare(a, b); }
+
+public:
+
+  // Default constructor
+  PQExternal();
+
+  /* ************************************************************************ */
+
+  // Specific constructors
+  explicit PQExternal(ulong); // An empty queue with the given memory budget in bytes
+  PQExternal(const TraversableContainer<Data> &); // A priority queue obtained from a TraversableContainer
+  PQExternal(MappableContainer<Data> &&); // A priority queue obtained from a MappableContainer
+
+  /* ************************************************************************ */
+
+  // Copy constructor (copies the runs to new temporary files)
+  PQExternal(const PQExternal &);
+
+  // Move constructor
+  PQExternal(PQExternal &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Destructor
+  virtual ~PQExternal() = default;
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  PQExternal & operator=(const PQExternal &);
+
+  // Move assignment
+  PQExternal & operator=(PQExternal &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  inline ulong Budget() const noexcept { return budget; }
+  inline ulong Runs() const noexcept { return runs.size(); }
+  ulong OnDisk() const noexcept; // Values in the files and not yet read into a block
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from PQ)
+
+  const Data & Tip() const override; // Override PQ member (must throw std::length_error when empty)
+  void RemoveTip() override; // Override PQ member (must throw std::length_error when empty)
+  Data TipNRemove() override; // Override PQ member (must throw std::length_error when empty)
+
+  void Insert(const Data &) override; // Override PQ member (copy of the value; must throw std::runtime_error when a spill fails)
+  void Insert(Data &&) override; // Override PQ member (move of the value; must throw std::runtime_error when a spill fails)
+
+  void Change(ulong, const Data &) override; // Override PQ member (copy of the value; must throw std::out_of_range when out of range)
+  void Change(ulong, Data &&) override; // Override PQ member (move of the value; must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from LinearContainer)
+
+  const Data & operator[](ulong) const override; // Override LinearContainer member (must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from TraversableContainer)
+
+  using typename TraversableContainer<Data>::TraverseFun;
+
+  void Traverse(TraverseFun) const override; // Override TraversableContainer member
+  void PreOrderTraverse(TraverseFun) const override; // Override PreOrderTraversableContainer member
+  void PostOrderTraverse(TraverseFun) const override; // Override PostOrderTraversableContainer member
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from ClearableContainer)
+
+  void Clear() override; // Override ClearableContainer member (also deletes the runs)
+
+protected:
+
+  inline const Data & Head(ulong run) const noexcept { return runs[run].block[runs[run].head]; }
+  inline ulong Remaining(const Run & run) const noexcept { return (run.filled - run.head) + (run.stored - run.offset); }
+
+  bool FromBuffer() const; // Whether the tip is the buffer top (the queue must not be empty)
+
+  void Push(const Data &);
+  void Replace(ulong, const Data &);
+  Data Pop();
+
+  void Spill(); // Writes the buffer out as a new run
+  void MergeRuns(); // Merges every run into one
+  void Advance(ulong); // Drops the head of a run, refilling its block, or deleting the run when it is over
+  void RemoveFromRun(ulong, ulong); // Removes the value at a position of a run
+  void RebuildHeads();
+
+  inline bool LowerHead(ulong a, ulong b) const { return Lower(Head(a), Head(b)); }
+
+  bool Refill(Run &); // Reads the next block of a run; false when the run is over
+  void Read(const Run &, ulong, ulong, Data *) const; // Reads values from the given position of the file of a run
+  void Write(std::FILE *, const Data *, ulong) const;
+
+  File NewFile() const;
+  Block NewBlock() const;
+
+  // Position of a value: the run (runs.size() for the buffer) and the position within it
+  std::pair<ulong, ulong> Locate(ulong) const;
+
+  void Release() noexcept;
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "pqexternal.cpp"
+
+#endif
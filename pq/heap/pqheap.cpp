@@ -7,41 +7,41 @@ namespace lasd {
 
 // Constructors
 
-template <typename Data>
-PQHeap<Data>::PQHeap(const TraversableContainer<Data>& container)
-  : HeapVec<Data>(container) {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+PQHeap<Data, Arity, Compare, Layout>::PQHeap(const TraversableContainer<Data>& container)
+  : HeapVec<Data, Arity, Compare, Layout>(container) {
 }
 
-template <typename Data>
-PQHeap<Data>::PQHeap(MappableContainer<Data>&& container)
-  : HeapVec<Data>(std::move(container)) {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+PQHeap<Data, Arity, Compare, Layout>::PQHeap(MappableContainer<Data>&& container)
+  : HeapVec<Data, Arity, Compare, Layout>(std::move(container)) {
 }
 
 // Copy constructor
-template <typename Data>
-PQHeap<Data>::PQHeap(const PQHeap<Data>& other)
-  : HeapVec<Data>(other) {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+PQHeap<Data, Arity, Compare, Layout>::PQHeap(const PQHeap<Data, Arity, Compare, Layout>& other)
+  : HeapVec<Data, Arity, Compare, Layout>(other) {
 }
 
 // Move constructor
-template <typename Data>
-PQHeap<Data>::PQHeap(PQHeap<Data>&& other) noexcept
-  : HeapVec<Data>(std::move(other)) {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+PQHeap<Data, Arity, Compare, Layout>::PQHeap(PQHeap<Data, Arity, Compare, Layout>&& other) noexcept
+  : HeapVec<Data, Arity, Compare, Layout>(std::move(other)) {
 }
 
 /* ************************************************************************** */
 
 // Assignment operators
 
-template <typename Data>
-PQHeap<Data>& PQHeap<Data>::operator=(const PQHeap<Data>& other) {
-  HeapVec<Data>::operator=(other);
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+PQHeap<Data, Arity, Compare, Layout>& PQHeap<Data, Arity, Compare, Layout>::operator=(const PQHeap<Data, Arity, Compare, Layout>& other) {
+  HeapVec<Data, Arity, Compare, Layout>::operator=(other);
   return *this;
 }
 
-template <typename Data>
-PQHeap<Data>& PQHeap<Data>::operator=(PQHeap<Data>&& other) noexcept {
-  HeapVec<Data>::operator=(std::move(other));
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+PQHeap<Data, Arity, Compare, Layout>& PQHeap<Data, Arity, Compare, Layout>::operator=(PQHeap<Data, Arity, Compare, Layout>&& other) noexcept {
+  HeapVec<Data, Arity, Compare, Layout>::operator=(std::move(other));
   return *this;
 }
 
@@ -49,74 +49,144 @@ PQHeap<Data>& PQHeap<Data>::operator=(PQHeap<Data>&& other) noexcept {
 
 // Specific member functions (inherited from PQ)
 
-template <typename Data>
-const Data& PQHeap<Data>::Tip() const {
-  return HeapVec<Data>::Top();
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+const Data& PQHeap<Data, Arity, Compare, Layout>::Tip() const {
+  return HeapVec<Data, Arity, Compare, Layout>::Top();
 }
 
-template <typename Data>
-void PQHeap<Data>::RemoveTip() {
-  HeapVec<Data>::TopNRemove();
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+const Data& PQHeap<Data, Arity, Compare, Layout>::Tip() {
+  return HeapVec<Data, Arity, Compare, Layout>::Top();
 }
 
-template <typename Data>
-Data PQHeap<Data>::TipNRemove() {
-  return HeapVec<Data>::TopNRemove();
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void PQHeap<Data, Arity, Compare, Layout>::RemoveTip() {
+  HeapVec<Data, Arity, Compare, Layout>::TopNRemove();
 }
 
-template <typename Data>
-void PQHeap<Data>::Insert(const Data& value) {
-  HeapVec<Data>::Insert(value);
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+Data PQHeap<Data, Arity, Compare, Layout>::TipNRemove() {
+  return HeapVec<Data, Arity, Compare, Layout>::TopNRemove();
 }
 
-template <typename Data>
-void PQHeap<Data>::Insert(Data&& value) {
-  HeapVec<Data>::Insert(std::move(value));
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void PQHeap<Data, Arity, Compare, Layout>::Insert(const Data& value) {
+  if constexpr (std::is_copy_constructible_v<Data>) {
+    HeapVec<Data, Arity, Compare, Layout>::Insert(value);
+  } else {
+    throw std::logic_error("Inserting a copy of a value that is not copy constructible.");
+  }
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void PQHeap<Data, Arity, Compare, Layout>::Insert(Data&& value) {
+  HeapVec<Data, Arity, Compare, Layout>::Insert(std::move(value));
 }
 
-template <typename Data>
-void PQHeap<Data>::Clear() {
-  HeapVec<Data>::Clear();
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void PQHeap<Data, Arity, Compare, Layout>::Clear() {
+  HeapVec<Data, Arity, Compare, Layout>::Clear();
 }
 
-template <typename Data>
-void PQHeap<Data>::Change(ulong index, const Data& value) {
+// The direction of the fix-up is decided before overwriting, so the old
+// value never needs to be copied aside; the index names a position in the
+// values as they are, so a heap not in order is restored only afterwards
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void PQHeap<Data, Arity, Compare, Layout>::Change(ulong index, const Data& value) {
   if (index >= this->size) {
     throw std::out_of_range("Index out of range");
   }
   
-  Data oldValue = this->elements[index];
-  this->elements[index] = value;
-  
-  // Se il nuovo valore è maggiore del precedente, heapify up
-  if (value > oldValue) {
-    this->HeapifyUp(index);
+  if constexpr (std::is_copy_assignable_v<Data>) {
+    if (this->state != HeapVec<Data, Arity, Compare, Layout>::HeapState::Valid) {
+      this->elements[index] = value;
+      this->Touch();
+      this->Restore();
+      return;
+    }
+    bool up = this->Higher(value, this->elements[index]);
+    bool down = !up && this->Higher(this->elements[index], value);
+    this->elements[index] = value;
+    
+    if (up) {
+      this->HeapifyUp(index);
+    } else if (down) {
+      this->HeapifyDown(index);
+    }
+  } else {
+    throw std::logic_error("Assigning a copy of a value that is not copy assignable.");
   }
-  // Se il nuovo valore è minore del precedente, heapify down
-  else if (value < oldValue) {
-    this->HeapifyDown(index);
-  }
-  // Se sono uguali, non serve fare nulla
 }
 
-template <typename Data>
-void PQHeap<Data>::Change(ulong index, Data&& value) {
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void PQHeap<Data, Arity, Compare, Layout>::Change(ulong index, Data&& value) {
   if (index >= this->size) {
     throw std::out_of_range("Index out of range");
   }
+  if (this->state != HeapVec<Data, Arity, Compare, Layout>::HeapState::Valid) {
+    this->elements[index] = std::move(value);
+    this->Touch();
+    this->Restore();
+    return;
+  }
   
-  Data oldValue = this->elements[index];
+  bool up = this->Higher(value, this->elements[index]);
+  bool down = !up && this->Higher(this->elements[index], value);
   this->elements[index] = std::move(value);
   
-  // Se il nuovo valore è maggiore del precedente, heapify up
-  if (this->elements[index] > oldValue) {
+  if (up) {
     this->HeapifyUp(index);
-  }
-  // Se il nuovo valore è minore del precedente, heapify down
-  else if (this->elements[index] < oldValue) {
+  } else if (down) {
     this->HeapifyDown(index);
   }
-  // Se sono uguali, non serve fare nulla
+}
+
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+void PQHeap<Data, Arity, Compare, Layout>::Meld(PQHeap&& other) {
+  if (this == &other || other.size == 0) {
+    return;
+  }
+  if (other.size > this->size) {
+    std::swap(this->elements, other.elements);
+    std::swap(this->size, other.size);
+    std::swap(this->capacity, other.capacity);
+    std::swap(this->state, other.state);
+    std::swap(this->settled, other.settled);
+  }
+  this->Grow(this->size + other.size);
+  ulong first = this->size;
+  try {
+    for (ulong index = 0; index < other.size; ++index) {
+      std::construct_at(this->elements + this->size, std::move(other.elements[index]));
+      ++this->size;
+    }
+  } catch (...) {
+    this->FinishBatch(first);
+    throw;
+  }
+  other.Clear();
+  this->FinishBatch(first);
+}
+
+// The popped values are moved straight into the result's buffer
+template <typename Data, ulong Arity, typename Compare, typename Layout>
+Vector<Data> PQHeap<Data, Arity, Compare, Layout>::TipNRemoveK(ulong count) {
+  if (count > this->size) {
+    throw std::length_error("Removing " + std::to_string(count) + " values from a priority queue of size " + std::to_string(this->size) + ".");
+  }
+  Data* top = HeapVec<Data, Arity, Compare, Layout>::AllocateElements(count);
+  ulong taken = 0;
+  try {
+    for (; taken < count; ++taken) {
+      std::construct_at(top + taken, HeapVec<Data, Arity, Compare, Layout>::TopNRemove());
+    }
+  } catch (...) {
+    HeapVec<Data, Arity, Compare, Layout>::ReleaseElements(top, taken);
+    throw;
+  }
+  Vector<Data> result;
+  HeapVec<Data, Arity, Compare, Layout>::Adopt(result, top, count);
+  return result;
 }
 
 /* ************************************************************************** */
@@ -5,6 +5,7 @@
 
 #include "../pq.hpp"
 #include "../../heap/vec/heapvec.hpp"
+#include "../../container/static.hpp"
 
 /* ************************************************************************** */
 
@@ -12,8 +13,10 @@ namespace lasd {
 
 /* ************************************************************************** */
 
-template <typename Data>
-class PQHeap : virtual public PQ<Data>, public HeapVec<Data> {
+// Priority queue over a HeapVec with the given arity, order and layout
+template <typename Data, ulong Arity = 2, typename Compare = std::less<Data>, typename Layout = ImplicitLayout>
+class PQHeap final : virtual public PQ<Data>, public HeapVec<Data, Arity, Compare, Layout>,
+                     public StaticLinearContainer<PQHeap<Data, Arity, Compare, Layout>, Data> {
 
 
 private:
@@ -22,8 +25,8 @@ private:
 
 protected:
 
-  using HeapVec<Data>::size;
-  using HeapVec<Data>::elements;
+  using HeapVec<Data, Arity, Compare, Layout>::size;
+  using HeapVec<Data, Arity, Compare, Layout>::elements;
 
   // ...
 
@@ -65,6 +68,7 @@ public:
   // Specific member functions (inherited from PQ)
 
   const Data& Tip() const override;
+  const Data& Tip(); // Restores the heap first if need be, as HeapVec::Top
   void RemoveTip() override;
   Data TipNRemove() override;
 
@@ -75,11 +79,17 @@ public:
   void Change(ulong index, const Data& value) override; //(Copy of the value)
   void Change(ulong index, Data&& value) override; //(Move of the value)
 
+  Vector<Data> TipNRemoveK(ulong); // The top k values in priority order (must throw std::length_error when fewer are queued)
+
+  // Takes every value of the other queue, leaving it empty: the smaller
+  // buffer is appended to the larger, then the heap is restored as InsertBatch does
+  void Meld(PQHeap&& other);
+
   void Clear() override;
 
 protected:
   // Aggiungi qui se necessario, ma HeapVec già lo ha
-  // using HeapVec<Data>::HeapifyUp;
+  // using HeapVec<Data, Arity, Compare, Layout>::HeapifyUp;
 };
 
 /* ************************************************************************** */
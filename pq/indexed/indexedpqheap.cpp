@@ -0,0 +1,265 @@
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* INDEXEDPQHEAP - COPY AND MOVE CONSTRUCTORS                                  */
+/* ************************************************************************** */
+
+// Copy constructor
+template <typename Data, typename Compare>
+IndexedPQHeap<Data, Compare>::IndexedPQHeap(const IndexedPQHeap & other)
+  : heap(other.heap), slots(other.slots), freeHead(other.freeHead), compare(other.compare) {
+  size = other.size;
+}
+
+// Move constructor
+template <typename Data, typename Compare>
+IndexedPQHeap<Data, Compare>::IndexedPQHeap(IndexedPQHeap && other) noexcept
+  : compare(other.compare) {
+  std::swap(heap, other.heap);
+  std::swap(slots, other.slots);
+  std::swap(freeHead, other.freeHead);
+  std::swap(size, other.size);
+}
+
+/* ************************************************************************** */
+/* INDEXEDPQHEAP - ASSIGNMENT OPERATORS                                        */
+/* ************************************************************************** */
+
+// Copy assignment
+template <typename Data, typename Compare>
+IndexedPQHeap<Data, Compare> & IndexedPQHeap<Data, Compare>::operator=(const IndexedPQHeap & other) {
+  if (this != &other) {
+    IndexedPQHeap temp{other};
+    *this = std::move(temp);
+  }
+  return *this;
+}
+
+// Move assignment
+template <typename Data, typename Compare>
+IndexedPQHeap<Data, Compare> & IndexedPQHeap<Data, Compare>::operator=(IndexedPQHeap && other) noexcept {
+  std::swap(heap, other.heap);
+  std::swap(slots, other.slots);
+  std::swap(freeHead, other.freeHead);
+  std::swap(size, other.size);
+  std::swap(compare, other.compare);
+  return *this;
+}
+
+/* ************************************************************************** */
+/* INDEXEDPQHEAP - SPECIFIC MEMBER FUNCTIONS                                   */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+const Data & IndexedPQHeap<Data, Compare>::Tip() const {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return heap[0].value;
+}
+
+template <typename Data, typename Compare>
+typename IndexedPQHeap<Data, Compare>::Handle IndexedPQHeap<Data, Compare>::TipHandle() const {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return Handle{heap[0].slot, slots[heap[0].slot].generation};
+}
+
+template <typename Data, typename Compare>
+void IndexedPQHeap<Data, Compare>::RemoveTip() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  RemoveAt(0);
+}
+
+template <typename Data, typename Compare>
+Data IndexedPQHeap<Data, Compare>::TipNRemove() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  Data value = std::move(heap[0].value);
+  RemoveAt(0);
+  return value;
+}
+
+template <typename Data, typename Compare>
+typename IndexedPQHeap<Data, Compare>::Handle IndexedPQHeap<Data, Compare>::Insert(const Data & value) {
+  return Push(value);
+}
+
+template <typename Data, typename Compare>
+typename IndexedPQHeap<Data, Compare>::Handle IndexedPQHeap<Data, Compare>::Insert(Data && value) {
+  return Push(std::move(value));
+}
+
+template <typename Data, typename Compare>
+bool IndexedPQHeap<Data, Compare>::Contains(Handle handle) const noexcept {
+  return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+}
+
+template <typename Data, typename Compare>
+const Data & IndexedPQHeap<Data, Compare>::Value(Handle handle) const {
+  return heap[Locate(handle)].value;
+}
+
+template <typename Data, typename Compare>
+void IndexedPQHeap<Data, Compare>::Update(Handle handle, const Data & value) {
+  Replace(handle, value);
+}
+
+template <typename Data, typename Compare>
+void IndexedPQHeap<Data, Compare>::Update(Handle handle, Data && value) {
+  Replace(handle, std::move(value));
+}
+
+template <typename Data, typename Compare>
+bool IndexedPQHeap<Data, Compare>::Remove(Handle handle) {
+  if (!Contains(handle)) {
+    return false;
+  }
+  RemoveAt(slots[handle.index].position);
+  return true;
+}
+
+/* ************************************************************************** */
+/* INDEXEDPQHEAP - LINEAR CONTAINER FUNCTIONS                                  */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+const Data & IndexedPQHeap<Data, Compare>::operator[](ulong index) const {
+  if (index >= size) {
+    throw std::out_of_range("Access at index " + std::to_string(index) + "; priority queue size " + std::to_string(size) + ".");
+  }
+  return heap[index].value;
+}
+
+/* ************************************************************************** */
+/* INDEXEDPQHEAP - CLEARABLE CONTAINER FUNCTIONS                               */
+/* ************************************************************************** */
+
+// The slots are kept and released, so that the handles given out so far stay stale
+template <typename Data, typename Compare>
+void IndexedPQHeap<Data, Compare>::Clear() {
+  for (const Entry & entry : heap) {
+    FreeSlot(entry.slot);
+  }
+  heap.clear();
+  size = 0;
+}
+
+/* ************************************************************************** */
+/* INDEXEDPQHEAP - AUXILIARY FUNCTIONS                                         */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void IndexedPQHeap<Data, Compare>::Swap(ulong index1, ulong index2) {
+  std::swap(heap[index1], heap[index2]);
+  slots[heap[index1].slot].position = index1;
+  slots[heap[index2].slot].position = index2;
+}
+
+template <typename Data, typename Compare>
+void IndexedPQHeap<Data, Compare>::HeapifyUp(ulong index) {
+  while (index > 0 && Higher(heap[index].value, heap[(index - 1) / 2].value)) {
+    Swap(index, (index - 1) / 2);
+    index = (index - 1) / 2;
+  }
+}
+
+template <typename Data, typename Compare>
+void IndexedPQHeap<Data, Compare>::HeapifyDown(ulong index) {
+  while (2 * index + 1 < size) {
+    ulong child = 2 * index + 1;
+    if (child + 1 < size && Higher(heap[child + 1].value, heap[child].value)) {
+      ++child;
+    }
+    if (!Higher(heap[child].value, heap[index].value)) {
+      return;
+    }
+    Swap(index, child);
+    index = child;
+  }
+}
+
+template <typename Data, typename Compare>
+template <typename Item>
+typename IndexedPQHeap<Data, Compare>::Handle IndexedPQHeap<Data, Compare>::Push(Item && value) {
+  ulong slot = TakeSlot();
+  try {
+    heap.push_back(Entry{std::forward<Item>(value), slot});
+  } catch (...) {
+    slots[slot].position = freeHead; // Back to the free list, the generation never handed out
+    freeHead = slot;
+    throw;
+  }
+  slots[slot].position = size;
+  ++size;
+  HeapifyUp(size - 1);
+  return Handle{slot, slots[slot].generation};
+}
+
+// The direction of the fix-up is decided before overwriting, as in PQHeap::Change
+template <typename Data, typename Compare>
+template <typename Item>
+void IndexedPQHeap<Data, Compare>::Replace(Handle handle, Item && value) {
+  ulong index = Locate(handle);
+  bool up = Higher(value, heap[index].value);
+  heap[index].value = std::forward<Item>(value);
+  if (up) {
+    HeapifyUp(index);
+  } else {
+    HeapifyDown(index);
+  }
+}
+
+template <typename Data, typename Compare>
+ulong IndexedPQHeap<Data, Compare>::Locate(Handle handle) const {
+  if (!Contains(handle)) {
+    throw std::out_of_range("Handle " + std::to_string(handle.index) + " is not in the priority queue.");
+  }
+  return slots[handle.index].position;
+}
+
+// The last entry fills the hole, then moves whichever way the order requires
+template <typename Data, typename Compare>
+void IndexedPQHeap<Data, Compare>::RemoveAt(ulong index) {
+  FreeSlot(heap[index].slot);
+  if (index != size - 1) {
+    heap[index] = std::move(heap[size - 1]);
+    slots[heap[index].slot].position = index;
+  }
+  heap.pop_back();
+  --size;
+  if (index < size) {
+    if (index > 0 && Higher(heap[index].value, heap[(index - 1) / 2].value)) {
+      HeapifyUp(index);
+    } else {
+      HeapifyDown(index);
+    }
+  }
+}
+
+template <typename Data, typename Compare>
+ulong IndexedPQHeap<Data, Compare>::TakeSlot() {
+  if (freeHead == Nil) {
+    slots.push_back(Slot{Nil});
+    return slots.size() - 1;
+  }
+  ulong slot = freeHead;
+  freeHead = slots[slot].position;
+  return slot;
+}
+
+template <typename Data, typename Compare>
+void IndexedPQHeap<Data, Compare>::FreeSlot(ulong slot) noexcept {
+  ++slots[slot].generation;
+  slots[slot].position = freeHead;
+  freeHead = slot;
+}
+
+/* ************************************************************************** */
+
+}
@@ -0,0 +1,149 @@
+#ifndef INDEXEDPQHEAP_HPP
+#define INDEXEDPQHEAP_HPP
+
+/* ************************************************************************** */
+
+#include "../../container/linear.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Addressable priority queue: Insert returns a handle that stays valid while
+// the value moves around the heap, so a queued value can be updated or
+// removed in O(log n) without searching for it. A handle is a slot index
+// and a generation: slots are recycled through a free list, so they stay
+// dense (callers can index their own arrays with them) and as many as the
+// peak size, however many values went through; a slot bumps its generation
+// when released, so a stale handle is never taken for a newer value.
+// Compare orders the values as in PQHeap (the default std::less keeps the
+// greatest value on top).
+template <typename Data, typename Compare = std::less<Data>>
+class IndexedPQHeap final : virtual public LinearContainer<Data>,
+                            virtual public ClearableContainer {
+
+private:
+
+protected:
+
+  using Container::size;
+
+  static constexpr ulong Nil = static_cast<ulong>(-1);
+
+  struct Entry {
+    Data value;
+    ulong slot;
+  };
+
+  struct Slot {
+    ulong position; // In the heap while queued, next free slot while free
+    ulong generation = 0; // Bumped on release, so stale handles are recognised
+  };
+
+  std::vector<Entry> heap;
+  std::vector<Slot> slots;
+  ulong freeHead = Nil;
+
+  [[no_unique_address]] Compare compare{};
+
+public:
+
+  // Identifies a queued value until it leaves the queue
+  struct Handle {
+    ulong index = Nil; // Slot, below Slots()
+    ulong generation = 0;
+  };
+
+  // Default constructor
+  IndexedPQHeap() = default;
+
+  /* ************************************************************************ */
+
+  // Copy constructor
+  IndexedPQHeap(const IndexedPQHeap &);
+
+  // Move constructor
+  IndexedPQHeap(IndexedPQHeap &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Destructor
+  virtual ~IndexedPQHeap() = default;
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  IndexedPQHeap & operator=(const IndexedPQHeap &);
+
+  // Move assignment
+  IndexedPQHeap & operator=(IndexedPQHeap &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  const Data & Tip() const; // (must throw std::length_error when empty)
+  Handle TipHandle() const; // (must throw std::length_error when empty)
+  void RemoveTip(); // (must throw std::length_error when empty)
+  Data TipNRemove(); // (must throw std::length_error when empty)
+
+  Handle Insert(const Data &); // Copy of the value
+  Handle Insert(Data &&); // Move of the value
+
+  bool Contains(Handle) const noexcept;
+  const Data & Value(Handle) const; // (must throw std::out_of_range when the handle is not queued)
+
+  inline ulong Slots() const noexcept { return slots.size(); } // Handle slots ever needed: the peak size
+
+  void Update(Handle, const Data &); // Copy of the value (must throw std::out_of_range when the handle is not queued)
+  void Update(Handle, Data &&); // Move of the value (must throw std::out_of_range when the handle is not queued)
+  bool Remove(Handle); // False when the handle is not queued
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from LinearContainer)
+
+  const Data & operator[](ulong) const override; // Override LinearContainer member (heap order; must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from ClearableContainer)
+
+  void Clear() override; // Override ClearableContainer member
+
+protected:
+
+  inline bool Higher(const Data & a, const Data & b) const { return compare(b, a); } // a must be above b
+
+  void Swap(ulong, ulong); // Also swaps the positions of the two slots
+  void HeapifyUp(ulong);
+  void HeapifyDown(ulong);
+
+  template <typename Item>
+  Handle Push(Item &&);
+
+  template <typename Item>
+  void Replace(Handle, Item &&);
+
+  ulong Locate(Handle) const; // Position of a queued handle
+
+  void RemoveAt(ulong);
+
+  ulong TakeSlot(); // From the free list, or a new one
+  void FreeSlot(ulong) noexcept; // Bumps the generation and returns the slot to the free list
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "indexedpqheap.cpp"
+
+#endif
@@ -0,0 +1,369 @@
+
+#include <bit>
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* PQMINMAX - CONSTRUCTORS                                                     */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+PQMinMax<Data, Compare>::PQMinMax(ulong limit) : bound(limit) {
+  Reserve(limit);
+}
+
+template <typename Data, typename Compare>
+PQMinMax<Data, Compare>::PQMinMax(const TraversableContainer<Data> & container) : SortableVector<Data>(container) {
+  capacity = size;
+  BuildHeap();
+}
+
+template <typename Data, typename Compare>
+PQMinMax<Data, Compare>::PQMinMax(MappableContainer<Data> && container) : SortableVector<Data>(std::move(container)) {
+  capacity = size;
+  BuildHeap();
+}
+
+/* ************************************************************************** */
+/* PQMINMAX - COPY AND MOVE CONSTRUCTORS                                       */
+/* ************************************************************************** */
+
+// Copy constructor
+template <typename Data, typename Compare>
+PQMinMax<Data, Compare>::PQMinMax(const PQMinMax & other)
+  : SortableVector<Data>(other), capacity(other.size), bound(other.bound), compare(other.compare) {
+}
+
+// Move constructor
+template <typename Data, typename Compare>
+PQMinMax<Data, Compare>::PQMinMax(PQMinMax && other) noexcept
+  : SortableVector<Data>(std::move(other)), capacity(other.capacity), bound(other.bound), compare(other.compare) {
+  other.capacity = 0;
+}
+
+/* ************************************************************************** */
+/* PQMINMAX - ASSIGNMENT OPERATORS                                             */
+/* ************************************************************************** */
+
+// Copy assignment
+template <typename Data, typename Compare>
+PQMinMax<Data, Compare> & PQMinMax<Data, Compare>::operator=(const PQMinMax & other) {
+  SortableVector<Data>::operator=(other);
+  capacity = size;
+  bound = other.bound;
+  compare = other.compare;
+  return *this;
+}
+
+// Move assignment
+template <typename Data, typename Compare>
+PQMinMax<Data, Compare> & PQMinMax<Data, Compare>::operator=(PQMinMax && other) noexcept {
+  SortableVector<Data>::operator=(std::move(other));
+  std::swap(capacity, other.capacity);
+  std::swap(bound, other.bound);
+  std::swap(compare, other.compare);
+  return *this;
+}
+
+/* ************************************************************************** */
+/* PQMINMAX - SPECIFIC MEMBER FUNCTIONS                                        */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+const Data & PQMinMax<Data, Compare>::TipMin() const {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return elements[0];
+}
+
+template <typename Data, typename Compare>
+const Data & PQMinMax<Data, Compare>::TipMax() const {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return elements[MaxIndex()];
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::RemoveTipMin() {
+  TipMinNRemove();
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::RemoveTipMax() {
+  TipMaxNRemove();
+}
+
+template <typename Data, typename Compare>
+Data PQMinMax<Data, Compare>::TipMinNRemove() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return RemoveAt(0);
+}
+
+template <typename Data, typename Compare>
+Data PQMinMax<Data, Compare>::TipMaxNRemove() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return RemoveAt(MaxIndex());
+}
+
+template <typename Data, typename Compare>
+std::optional<Data> PQMinMax<Data, Compare>::InsertEvict(const Data & value) {
+  if constexpr (std::is_copy_constructible_v<Data>) {
+    return Admit(value);
+  } else {
+    throw std::logic_error("Inserting a copy of a value that is not copy constructible.");
+  }
+}
+
+template <typename Data, typename Compare>
+std::optional<Data> PQMinMax<Data, Compare>::InsertEvict(Data && value) {
+  return Admit(std::move(value));
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::SetBound(ulong limit) {
+  bound = limit;
+  while (bound != 0 && size > bound) {
+    RemoveAt(0);
+  }
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::Reserve(ulong count) {
+  if (count > capacity) {
+    elements = SortableVector<Data>::ReallocateElements(elements, size, count);
+    capacity = count;
+  }
+}
+
+/* ************************************************************************** */
+/* PQMINMAX - PQ FUNCTIONS                                                     */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+const Data & PQMinMax<Data, Compare>::Tip() const {
+  return TipMax();
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::RemoveTip() {
+  TipMaxNRemove();
+}
+
+template <typename Data, typename Compare>
+Data PQMinMax<Data, Compare>::TipNRemove() {
+  return TipMaxNRemove();
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::Insert(const Data & value) {
+  InsertEvict(value);
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::Insert(Data && value) {
+  InsertEvict(std::move(value));
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::Change(ulong index, const Data & value) {
+  if constexpr (std::is_copy_assignable_v<Data>) {
+    Replace(index, value);
+  } else {
+    throw std::logic_error("Assigning a copy of a value that is not copy assignable.");
+  }
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::Change(ulong index, Data && value) {
+  Replace(index, std::move(value));
+}
+
+/* ************************************************************************** */
+/* PQMINMAX - CLEARABLE AND RESIZABLE CONTAINER FUNCTIONS                      */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::Clear() {
+  SortableVector<Data>::Clear();
+  capacity = 0;
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::Resize(ulong newSize) {
+  SortableVector<Data>::Resize(newSize);
+  capacity = size;
+}
+
+/* ************************************************************************** */
+/* PQMINMAX - VECTOR FUNCTIONS                                                 */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::ValuesChanged() {
+  BuildHeap();
+}
+
+/* ************************************************************************** */
+/* PQMINMAX - AUXILIARY FUNCTIONS                                              */
+/* ************************************************************************** */
+
+// The root is on level 0, a min level
+template <typename Data, typename Compare>
+bool PQMinMax<Data, Compare>::IsMinLevel(ulong index) noexcept {
+  return (std::bit_width(index + 1) & 1) == 1;
+}
+
+template <typename Data, typename Compare>
+ulong PQMinMax<Data, Compare>::MaxIndex() const noexcept {
+  if (size < 3) {
+    return size - 1;
+  }
+  return Lower(elements[1], elements[2]) ? 2 : 1;
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::BuildHeap() {
+  for (ulong index = size / 2; index-- > 0; ) {
+    TrickleDown(index);
+  }
+}
+
+// A value beyond its parent (higher under a min level, lower under a max
+// one) is beyond the whole subtree: it trades places with the parent, which
+// then has to sink through that subtree. A value beyond its grandparent only
+// has to rise; any other value only has to sink.
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::Fix(ulong index) {
+  if (index > 0) {
+    ulong parent = (index - 1) / 2;
+    bool min = IsMinLevel(index);
+    if (min ? Lower(elements[parent], elements[index]) : Lower(elements[index], elements[parent])) {
+      std::swap(elements[index], elements[parent]);
+      BubbleUp(parent);
+      TrickleDown(index);
+      return;
+    }
+    if (index >= 3) {
+      ulong grandparent = (parent - 1) / 2;
+      if (min ? Lower(elements[index], elements[grandparent]) : Lower(elements[grandparent], elements[index])) {
+        BubbleUp(index);
+        return;
+      }
+    }
+  }
+  TrickleDown(index);
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::BubbleUp(ulong index) {
+  bool min = IsMinLevel(index);
+  Data value = std::move(elements[index]);
+  while (index >= 3) {
+    ulong grandparent = ((index - 1) / 2 - 1) / 2;
+    if (!(min ? Lower(value, elements[grandparent]) : Lower(elements[grandparent], value))) {
+      break;
+    }
+    elements[index] = std::move(elements[grandparent]);
+    index = grandparent;
+  }
+  elements[index] = std::move(value);
+}
+
+// The extreme of the children and grandchildren either is a child (the value
+// settles there after one step) or a grandchild, in which case the value
+// continues from there, first trading places with the grandchild's parent
+// when it is beyond it
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::TrickleDown(ulong index) {
+  bool min = IsMinLevel(index);
+  auto beyond = [this, min](const Data & a, const Data & b) { return min ? Lower(a, b) : Lower(b, a); };
+  Data value = std::move(elements[index]);
+  while (2 * index + 1 < size) {
+    ulong first = 2 * index + 1;
+    ulong extreme = first;
+    if (first + 1 < size && beyond(elements[first + 1], elements[extreme])) {
+      extreme = first + 1;
+    }
+    ulong grandchild = 2 * first + 1;
+    ulong last = std::min(grandchild + 4, size);
+    for (; grandchild < last; ++grandchild) {
+      if (beyond(elements[grandchild], elements[extreme])) {
+        extreme = grandchild;
+      }
+    }
+    if (!beyond(elements[extreme], value)) {
+      break;
+    }
+    elements[index] = std::move(elements[extreme]);
+    index = extreme;
+    if (extreme <= first + 1) {
+      break;
+    }
+    ulong parent = (extreme - 1) / 2;
+    if (beyond(elements[parent], value)) {
+      std::swap(value, elements[parent]);
+    }
+  }
+  elements[index] = std::move(value);
+}
+
+template <typename Data, typename Compare>
+void PQMinMax<Data, Compare>::Grow(ulong count) {
+  if (count > capacity) {
+    Reserve(std::max(count, 2 * capacity));
+  }
+}
+
+template <typename Data, typename Compare>
+Data PQMinMax<Data, Compare>::RemoveAt(ulong index) {
+  Data value = std::move(elements[index]);
+  if (index != size - 1) {
+    elements[index] = std::move(elements[size - 1]);
+  }
+  std::destroy_at(elements + size - 1);
+  --size;
+  if (index < size) {
+    Fix(index);
+  }
+  return value;
+}
+
+// Only a value above the lowest queued one can get into a full queue
+template <typename Data, typename Compare>
+template <typename Item>
+std::optional<Data> PQMinMax<Data, Compare>::Admit(Item && value) {
+  if (bound != 0 && size >= bound) {
+    if (!Lower(elements[0], value)) {
+      return std::optional<Data>(std::forward<Item>(value));
+    }
+    std::optional<Data> evicted(std::move(elements[0]));
+    elements[0] = std::forward<Item>(value);
+    TrickleDown(0);
+    return evicted;
+  }
+  Grow(size + 1);
+  std::construct_at(elements + size, std::forward<Item>(value));
+  ++size;
+  Fix(size - 1);
+  return std::nullopt;
+}
+
+template <typename Data, typename Compare>
+template <typename Item>
+void PQMinMax<Data, Compare>::Replace(ulong index, Item && value) {
+  if (index >= size) {
+    throw std::out_of_range("Index out of range");
+  }
+  elements[index] = std::forward<Item>(value);
+  Fix(index);
+}
+
+/* ************************************************************************** */
+
+}
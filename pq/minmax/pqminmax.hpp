@@ -0,0 +1,158 @@
+#ifndef PQMINMAX_HPP
+#define PQMINMAX_HPP
+
+/* ************************************************************************** */
+
+#include "../pq.hpp"
+#include "../../vector/vector.hpp"
+#include "../../container/static.hpp"
+
+#include <functional>
+#include <optional>
+#include <stdexcept>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Double-ended priority queue as a min-max heap (Atkinson et al.) in a
+// SortableVector: the levels of the complete binary tree alternate, starting
+// from the root, between min levels, whose nodes are the lowest of their
+// subtree, and max levels, whose nodes are the highest. The lowest value is
+// the root and the highest one of its two children, so both ends are read
+// in O(1) and removed in O(log n). Tip and the other PQ members refer to the
+// highest value, as in PQHeap. With a bound, the queue never grows past it:
+// a full queue makes room for a higher value by evicting its lowest one.
+template <typename Data, typename Compare = std::less<Data>>
+class PQMinMax final : virtual public PQ<Data>,
+                       public SortableVector<Data>,
+                       public StaticLinearContainer<PQMinMax<Data, Compare>, Data> {
+
+private:
+
+protected:
+
+  using SortableVector<Data>::size;
+  using SortableVector<Data>::elements;
+
+  ulong capacity = 0; // Allocated slots; those past size are uninitialised
+  ulong bound = 0; // Most values kept, or 0 when unbounded
+
+  [[no_unique_address]] Compare compare{};
+
+  inline bool Lower(const Data & a, const Data & b) const { return compare(a, b); }
+
+public:
+
+  // Default constructor
+  PQMinMax() = default;
+
+  /* ************************************************************************ */
+
+  // Specific constructors
+  explicit PQMinMax(ulong); // An empty queue holding at most the given number of values (0 for no bound)
+  PQMinMax(const TraversableContainer<Data> &); // A priority queue obtained from a TraversableContainer
+  PQMinMax(MappableContainer<Data> &&); // A priority queue obtained from a MappableContainer
+
+  /* ************************************************************************ */
+
+  // Copy constructor
+  PQMinMax(const PQMinMax &);
+
+  // Move constructor
+  PQMinMax(PQMinMax &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Destructor
+  virtual ~PQMinMax() = default;
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  PQMinMax & operator=(const PQMinMax &);
+
+  // Move assignment
+  PQMinMax & operator=(PQMinMax &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  const Data & TipMin() const; // (must throw std::length_error when empty)
+  const Data & TipMax() const; // (must throw std::length_error when empty)
+  void RemoveTipMin(); // (must throw std::length_error when empty)
+  void RemoveTipMax(); // (must throw std::length_error when empty)
+  Data TipMinNRemove(); // (must throw std::length_error when empty)
+  Data TipMaxNRemove(); // (must throw std::length_error when empty)
+
+  // Inserts the value unless the queue is at its bound, in which case the
+  // lowest of the queued values and the new one is dropped and returned
+  std::optional<Data> InsertEvict(const Data &); // Copy of the value
+  std::optional<Data> InsertEvict(Data &&); // Move of the value
+
+  inline ulong Bound() const noexcept { return bound; }
+  void SetBound(ulong); // Evicts the lowest values beyond the new bound (0 for no bound)
+
+  void Reserve(ulong); // Grows the storage so that the given number of values fits without reallocation
+  inline ulong Capacity() const noexcept { return capacity; }
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from PQ)
+
+  const Data & Tip() const override; // Override PQ member (highest value; must throw std::length_error when empty)
+  void RemoveTip() override; // Override PQ member (must throw std::length_error when empty)
+  Data TipNRemove() override; // Override PQ member (must throw std::length_error when empty)
+
+  void Insert(const Data &) override; // Override PQ member (copy of the value; may evict, see InsertEvict)
+  void Insert(Data &&) override; // Override PQ member (move of the value; may evict, see InsertEvict)
+
+  void Change(ulong, const Data &) override; // Override PQ member (copy of the value; must throw std::out_of_range when out of range)
+  void Change(ulong, Data &&) override; // Override PQ member (move of the value; must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from ClearableContainer and ResizableContainer)
+
+  void Clear() override; // Override ClearableContainer member
+
+  void Resize(ulong) override; // Override ResizableContainer member (the heap order is not restored)
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from Vector)
+
+  void ValuesChanged() override; // Override Vector member (rebuilds the min-max order)
+
+protected:
+
+  static bool IsMinLevel(ulong) noexcept;
+
+  ulong MaxIndex() const noexcept; // Position of the highest value (size must be positive)
+
+  void BuildHeap();
+  void Fix(ulong); // Restores the order after the value at the given position changed arbitrarily
+  void BubbleUp(ulong); // Moves the value up its grandparent chain
+  void TrickleDown(ulong); // Moves the value down through its children and grandchildren
+
+  void Grow(ulong); // Geometric growth to at least the given number of slots
+  Data RemoveAt(ulong); // Removes the value at the given position (0 or MaxIndex)
+
+  template <typename Item>
+  std::optional<Data> Admit(Item &&);
+
+  template <typename Item>
+  void Replace(ulong, Item &&);
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "pqminmax.cpp"
+
+#endif
@@ -0,0 +1,549 @@
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* PQPAIRING - CONSTRUCTORS                                                    */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+PQPairing<Data, Compare>::PQPairing(const TraversableContainer<Data> & container) {
+  try {
+    container.Traverse(
+      [this](const Data & dat) {
+        Push(dat);
+      }
+    );
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+template <typename Data, typename Compare>
+PQPairing<Data, Compare>::PQPairing(MappableContainer<Data> && container) {
+  try {
+    container.Map(
+      [this](Data & dat) {
+        Push(std::move(dat));
+      }
+    );
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - COPY AND MOVE CONSTRUCTORS                                      */
+/* ************************************************************************** */
+
+// Copy constructor (same tree shape, hence the same indices)
+template <typename Data, typename Compare>
+PQPairing<Data, Compare>::PQPairing(const PQPairing & other) : compare(other.compare) {
+  try {
+    Copy(other);
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+// Move constructor
+template <typename Data, typename Compare>
+PQPairing<Data, Compare>::PQPairing(PQPairing && other) noexcept : compare(other.compare) {
+  std::swap(root, other.root);
+  std::swap(chunks, other.chunks);
+  std::swap(lastChunk, other.lastChunk);
+  std::swap(freeHead, other.freeHead);
+  std::swap(freeTail, other.freeTail);
+  std::swap(nextChunk, other.nextChunk);
+  std::swap(size, other.size);
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - DESTRUCTOR                                                      */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+PQPairing<Data, Compare>::~PQPairing() {
+  Release();
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - ASSIGNMENT OPERATORS                                            */
+/* ************************************************************************** */
+
+// Copy assignment
+template <typename Data, typename Compare>
+PQPairing<Data, Compare> & PQPairing<Data, Compare>::operator=(const PQPairing & other) {
+  if (this != &other) {
+    PQPairing temp{other};
+    *this = std::move(temp);
+  }
+  return *this;
+}
+
+// Move assignment
+template <typename Data, typename Compare>
+PQPairing<Data, Compare> & PQPairing<Data, Compare>::operator=(PQPairing && other) noexcept {
+  std::swap(root, other.root);
+  std::swap(chunks, other.chunks);
+  std::swap(lastChunk, other.lastChunk);
+  std::swap(freeHead, other.freeHead);
+  std::swap(freeTail, other.freeTail);
+  std::swap(nextChunk, other.nextChunk);
+  std::swap(size, other.size);
+  std::swap(compare, other.compare);
+  return *this;
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - COMPARISON OPERATORS                                            */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+bool PQPairing<Data, Compare>::operator==(const PQPairing & other) const noexcept {
+  if (size != other.size) {
+    return false;
+  }
+  std::vector<const Data *> values;
+  values.reserve(size);
+  other.Walk(
+    [&values](Node * node) {
+      values.push_back(&node->value);
+      return true;
+    }
+  );
+  ulong index = 0;
+  bool equal = true;
+  Walk(
+    [&values, &index, &equal](Node * node) {
+      equal = !(node->value != *values[index++]);
+      return equal;
+    }
+  );
+  return equal;
+}
+
+template <typename Data, typename Compare>
+inline bool PQPairing<Data, Compare>::operator!=(const PQPairing & other) const noexcept {
+  return !(*this == other);
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - SPECIFIC MEMBER FUNCTIONS                                       */
+/* ************************************************************************** */
+
+// The other pool's chunks and free slots are spliced onto this one, so the
+// melded nodes stay where they are
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Meld(PQPairing && other) {
+  if (this == &other) {
+    return;
+  }
+  if (other.chunks != nullptr) {
+    if (lastChunk != nullptr) {
+      lastChunk->next = other.chunks;
+    } else {
+      chunks = other.chunks;
+    }
+    lastChunk = other.lastChunk;
+  }
+  if (other.freeHead != nullptr) {
+    if (freeTail != nullptr) {
+      freeTail->next = other.freeHead;
+    } else {
+      freeHead = other.freeHead;
+    }
+    freeTail = other.freeTail;
+  }
+  nextChunk = std::max(nextChunk, other.nextChunk);
+  root = Link(root, other.root);
+  size += other.size;
+
+  other.root = nullptr;
+  other.chunks = other.lastChunk = nullptr;
+  other.freeHead = other.freeTail = nullptr;
+  other.nextChunk = MinChunk;
+  other.size = 0;
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - PQ FUNCTIONS                                                    */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+const Data & PQPairing<Data, Compare>::Tip() const {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return root->value;
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::RemoveTip() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  Pop();
+}
+
+template <typename Data, typename Compare>
+Data PQPairing<Data, Compare>::TipNRemove() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  Data value = std::move(root->value);
+  Pop();
+  return value;
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Insert(const Data & value) {
+  if constexpr (std::is_copy_constructible_v<Data>) {
+    Push(value);
+  } else {
+    throw std::logic_error("Inserting a copy of a value that is not copy constructible.");
+  }
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Insert(Data && value) {
+  Push(std::move(value));
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Change(ulong index, const Data & value) {
+  if constexpr (std::is_copy_assignable_v<Data>) {
+    Replace(index, value);
+  } else {
+    throw std::logic_error("Assigning a copy of a value that is not copy assignable.");
+  }
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Change(ulong index, Data && value) {
+  Replace(index, std::move(value));
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - LINEAR CONTAINER FUNCTIONS                                      */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+const Data & PQPairing<Data, Compare>::operator[](ulong index) const {
+  return At(index)->value;
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - TRAVERSABLE CONTAINER FUNCTIONS                                 */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Traverse(TraverseFun fun) const {
+  PreOrderTraverse(fun);
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::PreOrderTraverse(TraverseFun fun) const {
+  Walk(
+    [&fun](Node * node) {
+      fun(node->value);
+      return true;
+    }
+  );
+}
+
+// Reverse index order, as for every LinearContainer
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::PostOrderTraverse(TraverseFun fun) const {
+  std::vector<const Node *> nodes;
+  nodes.reserve(size);
+  Walk(
+    [&nodes](Node * node) {
+      nodes.push_back(node);
+      return true;
+    }
+  );
+  for (ulong index = nodes.size(); index-- > 0; ) {
+    fun(nodes[index]->value);
+  }
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - CLEARABLE CONTAINER FUNCTIONS                                   */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Clear() {
+  Release();
+}
+
+/* ************************************************************************** */
+/* PQPAIRING - AUXILIARY FUNCTIONS                                             */
+/* ************************************************************************** */
+
+template <typename Data, typename Compare>
+typename PQPairing<Data, Compare>::Node * PQPairing<Data, Compare>::Link(Node * first, Node * second) {
+  if (first == nullptr) {
+    return second;
+  }
+  if (second == nullptr) {
+    return first;
+  }
+  if (Higher(second->value, first->value)) {
+    std::swap(first, second);
+  }
+  second->sibling = first->child;
+  if (first->child != nullptr) {
+    first->child->prev = second;
+  }
+  second->prev = first;
+  first->child = second;
+  return first;
+}
+
+// First pass: link the siblings in pairs, left to right, stacking the winners
+// through their sibling links; second pass: fold the stack, right to left
+template <typename Data, typename Compare>
+typename PQPairing<Data, Compare>::Node * PQPairing<Data, Compare>::MergePairs(Node * first) {
+  Node * stack = nullptr;
+  while (first != nullptr) {
+    Node * pair = first;
+    Node * second = pair->sibling;
+    first = (second != nullptr) ? second->sibling : nullptr;
+    pair->prev = pair->sibling = nullptr;
+    if (second != nullptr) {
+      second->prev = second->sibling = nullptr;
+      pair = Link(pair, second);
+    }
+    pair->sibling = stack;
+    stack = pair;
+  }
+  Node * merged = nullptr;
+  while (stack != nullptr) {
+    Node * next = stack->sibling;
+    stack->sibling = nullptr;
+    merged = Link(stack, merged);
+    stack = next;
+  }
+  return merged;
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Cut(Node * node) {
+  if (node->prev->child == node) {
+    node->prev->child = node->sibling;
+  } else {
+    node->prev->sibling = node->sibling;
+  }
+  if (node->sibling != nullptr) {
+    node->sibling->prev = node->prev;
+  }
+  node->prev = node->sibling = nullptr;
+}
+
+template <typename Data, typename Compare>
+typename PQPairing<Data, Compare>::Node * PQPairing<Data, Compare>::At(ulong index) const {
+  if (index >= size) {
+    throw std::out_of_range("Access at index " + std::to_string(index) + "; priority queue size " + std::to_string(size) + ".");
+  }
+  Node * found = nullptr;
+  Walk(
+    [&index, &found](Node * node) {
+      if (index-- == 0) {
+        found = node;
+        return false;
+      }
+      return true;
+    }
+  );
+  return found;
+}
+
+// An explicit stack: a pairing heap can be a single path of n nodes
+template <typename Data, typename Compare>
+template <typename Visit>
+void PQPairing<Data, Compare>::Walk(Visit visit) const {
+  if (root == nullptr) {
+    return;
+  }
+  std::vector<Node *> stack{root};
+  while (!stack.empty()) {
+    Node * node = stack.back();
+    stack.pop_back();
+    if (!visit(node)) {
+      return;
+    }
+    if (node->sibling != nullptr) {
+      stack.push_back(node->sibling);
+    }
+    if (node->child != nullptr) {
+      stack.push_back(node->child);
+    }
+  }
+}
+
+template <typename Data, typename Compare>
+template <typename Item>
+void PQPairing<Data, Compare>::Push(Item && value) {
+  root = Link(root, NewNode(std::forward<Item>(value)));
+  ++size;
+}
+
+// A raised node is cut and linked to the root with its subtree; a lowered
+// one gives up its children, which are merged and linked back instead
+template <typename Data, typename Compare>
+template <typename Item>
+void PQPairing<Data, Compare>::Replace(ulong index, Item && value) {
+  Node * node = At(index);
+  bool up = Higher(value, node->value);
+  bool down = !up && Higher(node->value, value);
+  node->value = std::forward<Item>(value);
+  if (up && node != root) {
+    Cut(node);
+    root = Link(root, node);
+  } else if (down && node->child != nullptr) {
+    Node * children = node->child;
+    node->child = nullptr;
+    children->prev = nullptr;
+    Node * merged = MergePairs(children);
+    if (node == root) {
+      root = Link(merged, node);
+    } else {
+      Cut(node);
+      root = Link(root, Link(merged, node));
+    }
+  }
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Pop() {
+  Node * old = root;
+  root = MergePairs(old->child);
+  FreeNode(old);
+  --size;
+}
+
+template <typename Data, typename Compare>
+template <typename Item>
+typename PQPairing<Data, Compare>::Node * PQPairing<Data, Compare>::NewNode(Item && value) {
+  Slot * slot = TakeSlot();
+  try {
+    return std::construct_at(&slot->node, std::forward<Item>(value));
+  } catch (...) {
+    GiveSlot(slot);
+    throw;
+  }
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::FreeNode(Node * node) noexcept {
+  Slot * slot = reinterpret_cast<Slot *>(node);
+  std::destroy_at(node);
+  GiveSlot(slot);
+}
+
+// An empty free list gets a whole new chunk threaded onto it; chunks double
+// up to MaxChunk slots
+template <typename Data, typename Compare>
+typename PQPairing<Data, Compare>::Slot * PQPairing<Data, Compare>::TakeSlot() {
+  if (freeHead == nullptr) {
+    Chunk * chunk = new Chunk{nullptr, nextChunk, nullptr};
+    try {
+      chunk->slots = std::allocator<Slot>().allocate(chunk->count);
+    } catch (...) {
+      delete chunk;
+      throw;
+    }
+    if (lastChunk != nullptr) {
+      lastChunk->next = chunk;
+    } else {
+      chunks = chunk;
+    }
+    lastChunk = chunk;
+    nextChunk = std::min(2 * nextChunk, MaxChunk);
+    for (ulong index = 0; index + 1 < chunk->count; ++index) {
+      chunk->slots[index].next = chunk->slots + index + 1;
+    }
+    chunk->slots[chunk->count - 1].next = nullptr;
+    freeHead = chunk->slots;
+    freeTail = chunk->slots + chunk->count - 1;
+  }
+  Slot * slot = freeHead;
+  freeHead = slot->next;
+  if (freeHead == nullptr) {
+    freeTail = nullptr;
+  }
+  return slot;
+}
+
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::GiveSlot(Slot * slot) noexcept {
+  slot->next = freeHead;
+  freeHead = slot;
+  if (freeTail == nullptr) {
+    freeTail = slot;
+  }
+}
+
+// Every clone is linked in as soon as it exists, so Release can always find it
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Copy(const PQPairing & other) {
+  if (other.root == nullptr) {
+    return;
+  }
+  root = NewNode(other.root->value);
+  std::vector<std::pair<const Node *, Node *>> stack{{other.root, root}};
+  while (!stack.empty()) {
+    auto [from, to] = stack.back();
+    stack.pop_back();
+    Node * last = nullptr;
+    for (const Node * child = from->child; child != nullptr; child = child->sibling) {
+      Node * node = NewNode(child->value);
+      if (last != nullptr) {
+        last->sibling = node;
+      } else {
+        to->child = node;
+      }
+      node->prev = (last != nullptr) ? last : to;
+      last = node;
+      stack.push_back({child, node});
+    }
+  }
+  size = other.size;
+}
+
+// Each child list is spliced in after its parent, turning the tree into one
+// list that is destroyed front to back without a stack
+template <typename Data, typename Compare>
+void PQPairing<Data, Compare>::Release() noexcept {
+  for (Node * node = root; node != nullptr; ) {
+    if (node->child != nullptr) {
+      Node * last = node->child;
+      while (last->sibling != nullptr) {
+        last = last->sibling;
+      }
+      last->sibling = node->sibling;
+      node->sibling = node->child;
+    }
+    Node * next = node->sibling;
+    std::destroy_at(node);
+    node = next;
+  }
+  while (chunks != nullptr) {
+    Chunk * next = chunks->next;
+    std::allocator<Slot>().deallocate(chunks->slots, chunks->count);
+    delete chunks;
+    chunks = next;
+  }
+  root = nullptr;
+  lastChunk = nullptr;
+  freeHead = freeTail = nullptr;
+  nextChunk = MinChunk;
+  size = 0;
+}
+
+/* ************************************************************************** */
+
+}
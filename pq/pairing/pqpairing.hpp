@@ -0,0 +1,193 @@
+#ifndef PQPAIRING_HPP
+#define PQPAIRING_HPP
+
+/* ************************************************************************** */
+
+#include "../pq.hpp"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Meldable priority queue as a pairing heap: every node keeps its children
+// in a list (first child, next sibling, and a back link to the previous
+// sibling or to the parent). Insert and Meld link two roots in O(1); removing
+// the tip merges its children pairwise, left to right, then folds the pairs
+// right to left, in amortised O(log n). Nodes come from a pool of geometrically
+// growing chunks that Meld splices in O(1), so neither operation calls malloc
+// in the steady state. Index i is the i-th node of a pre-order walk, so
+// operator[] and Change cost O(n), as in List. Compare orders the values as
+// in PQHeap (the default std::less keeps the greatest value on top).
+template <typename Data, typename Compare = std::less<Data>>
+class PQPairing final : virtual public PQ<Data> {
+
+private:
+
+protected:
+
+  using Container::size;
+
+  struct Node {
+    Data value;
+    Node * child = nullptr;
+    Node * sibling = nullptr;
+    Node * prev = nullptr; // Previous sibling, or parent of a first child; null for the root
+
+    template <typename Item>
+    explicit Node(Item && item) : value(std::forward<Item>(item)) {}
+  };
+
+  union Slot { // Pool storage: a live node, or a link of the free list
+    Slot * next;
+    Node node;
+
+    Slot() {}
+    ~Slot() {}
+  };
+
+  struct Chunk {
+    Chunk * next;
+    ulong count;
+    Slot * slots;
+  };
+
+  static constexpr ulong MinChunk = 32;
+  static constexpr ulong MaxChunk = 8192;
+
+  Node * root = nullptr;
+
+  Chunk * chunks = nullptr;
+  Chunk * lastChunk = nullptr;
+  Slot * freeHead = nullptr;
+  Slot * freeTail = nullptr;
+  ulong nextChunk = MinChunk;
+
+  [[no_unique_address]] Compare compare{};
+
+public:
+
+  // Default constructor
+  PQPairing() = default;
+
+  /* ************************************************************************ */
+
+  // Specific constructors
+  PQPairing(const TraversableContainer<Data> &); // A priority queue obtained from a TraversableContainer
+  PQPairing(MappableContainer<Data> &&); // A priority queue obtained from a MappableContainer
+
+  /* ************************************************************************ */
+
+  // Copy constructor
+  PQPairing(const PQPairing &);
+
+  // Move constructor
+  PQPairing(PQPairing &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Destructor
+  virtual ~PQPairing();
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  PQPairing & operator=(const PQPairing &);
+
+  // Move assignment
+  PQPairing & operator=(PQPairing &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Comparison operators
+  bool operator==(const PQPairing &) const noexcept;
+  inline bool operator!=(const PQPairing &) const noexcept;
+
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  void Meld(PQPairing &&); // Takes every value (and node) of the other queue in O(1), leaving it empty
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from PQ)
+
+  const Data & Tip() const override; // Override PQ member (must throw std::length_error when empty)
+  void RemoveTip() override; // Override PQ member (must throw std::length_error when empty)
+  Data TipNRemove() override; // Override PQ member (must throw std::length_error when empty)
+
+  void Insert(const Data &) override; // Override PQ member (copy of the value)
+  void Insert(Data &&) override; // Override PQ member (move of the value)
+
+  void Change(ulong, const Data &) override; // Override PQ member (copy of the value; must throw std::out_of_range when out of range)
+  void Change(ulong, Data &&) override; // Override PQ member (move of the value; must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from LinearContainer)
+
+  const Data & operator[](ulong) const override; // Override LinearContainer member (must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from TraversableContainer)
+
+  using typename TraversableContainer<Data>::TraverseFun;
+
+  void Traverse(TraverseFun) const override; // Override TraversableContainer member
+  void PreOrderTraverse(TraverseFun) const override; // Override PreOrderTraversableContainer member
+  void PostOrderTraverse(TraverseFun) const override; // Override PostOrderTraversableContainer member
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from ClearableContainer)
+
+  void Clear() override; // Override ClearableContainer member (also releases the pool)
+
+protected:
+
+  inline bool Higher(const Data & a, const Data & b) const { return compare(b, a); } // a must be above b
+
+  Node * Link(Node *, Node *); // Links two roots (or null); the lower one becomes the first child of the other
+  Node * MergePairs(Node *); // Merges a sibling list into one root (two-pass)
+  void Cut(Node *); // Detaches a non-root node, with its subtree, from its parent or sibling
+
+  Node * At(ulong) const; // Node at a pre-order position
+
+  template <typename Visit>
+  void Walk(Visit) const; // Pre-order over the nodes; stops when the visitor returns false
+
+  template <typename Item>
+  void Push(Item &&);
+
+  template <typename Item>
+  void Replace(ulong, Item &&);
+
+  void Pop(); // Removes the root
+
+  template <typename Item>
+  Node * NewNode(Item &&);
+  void FreeNode(Node *) noexcept;
+
+  Slot * TakeSlot();
+  void GiveSlot(Slot *) noexcept;
+
+  void Copy(const PQPairing &); // Clones the tree of another (empty) queue
+  void Release() noexcept; // Destroys every value and frees the pool
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "pqpairing.cpp"
+
+#endif
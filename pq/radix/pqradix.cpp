@@ -0,0 +1,319 @@
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* PQRADIX - CONSTRUCTORS                                                      */
+/* ************************************************************************** */
+
+template <typename Data, typename Key>
+PQRadix<Data, Key>::PQRadix(const TraversableContainer<Data> & container) {
+  container.Traverse(
+    [this](const Data & dat) {
+      Push(dat);
+    }
+  );
+}
+
+template <typename Data, typename Key>
+PQRadix<Data, Key>::PQRadix(MappableContainer<Data> && container) {
+  container.Map(
+    [this](Data & dat) {
+      Push(std::move(dat));
+    }
+  );
+}
+
+/* ************************************************************************** */
+/* PQRADIX - COPY AND MOVE CONSTRUCTORS                                        */
+/* ************************************************************************** */
+
+// Copy constructor
+template <typename Data, typename Key>
+PQRadix<Data, Key>::PQRadix(const PQRadix & other)
+  : buckets(other.buckets), occupied(other.occupied), last(other.last), lowest(other.lowest), key(other.key) {
+  size = other.size;
+}
+
+// Move constructor
+template <typename Data, typename Key>
+PQRadix<Data, Key>::PQRadix(PQRadix && other) noexcept {
+  std::swap(buckets, other.buckets);
+  std::swap(occupied, other.occupied);
+  std::swap(last, other.last);
+  std::swap(lowest, other.lowest);
+  std::swap(key, other.key);
+  std::swap(size, other.size);
+}
+
+/* ************************************************************************** */
+/* PQRADIX - ASSIGNMENT OPERATORS                                              */
+/* ************************************************************************** */
+
+// Copy assignment
+template <typename Data, typename Key>
+PQRadix<Data, Key> & PQRadix<Data, Key>::operator=(const PQRadix & other) {
+  if (this != &other) {
+    PQRadix temp{other};
+    *this = std::move(temp);
+  }
+  return *this;
+}
+
+// Move assignment
+template <typename Data, typename Key>
+PQRadix<Data, Key> & PQRadix<Data, Key>::operator=(PQRadix && other) noexcept {
+  std::swap(buckets, other.buckets);
+  std::swap(occupied, other.occupied);
+  std::swap(last, other.last);
+  std::swap(lowest, other.lowest);
+  std::swap(key, other.key);
+  std::swap(size, other.size);
+  return *this;
+}
+
+/* ************************************************************************** */
+/* PQRADIX - PQ FUNCTIONS                                                      */
+/* ************************************************************************** */
+
+// Peeking does not move anything: the last removed key, hence the bound on
+// later insertions, only changes on removal
+template <typename Data, typename Key>
+const Data & PQRadix<Data, Key>::Tip() const {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  if (!buckets[0].empty()) {
+    return buckets[0].back();
+  }
+  return buckets[LowestBucket()][LowestIndex()];
+}
+
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::RemoveTip() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  Pop();
+}
+
+template <typename Data, typename Key>
+Data PQRadix<Data, Key>::TipNRemove() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return Pop();
+}
+
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::Insert(const Data & value) {
+  if constexpr (std::is_copy_constructible_v<Data>) {
+    Push(value);
+  } else {
+    throw std::logic_error("Inserting a copy of a value that is not copy constructible.");
+  }
+}
+
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::Insert(Data && value) {
+  Push(std::move(value));
+}
+
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::Change(ulong index, const Data & value) {
+  if constexpr (std::is_copy_assignable_v<Data>) {
+    Replace(index, value);
+  } else {
+    throw std::logic_error("Assigning a copy of a value that is not copy assignable.");
+  }
+}
+
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::Change(ulong index, Data && value) {
+  Replace(index, std::move(value));
+}
+
+/* ************************************************************************** */
+/* PQRADIX - LINEAR CONTAINER FUNCTIONS                                        */
+/* ************************************************************************** */
+
+template <typename Data, typename Key>
+const Data & PQRadix<Data, Key>::operator[](ulong index) const {
+  auto [bucket, position] = Find(index);
+  return buckets[bucket][position];
+}
+
+/* ************************************************************************** */
+/* PQRADIX - TRAVERSABLE CONTAINER FUNCTIONS                                   */
+/* ************************************************************************** */
+
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::Traverse(TraverseFun fun) const {
+  PreOrderTraverse(fun);
+}
+
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::PreOrderTraverse(TraverseFun fun) const {
+  for (const std::vector<Data> & bucket : buckets) {
+    for (const Data & value : bucket) {
+      fun(value);
+    }
+  }
+}
+
+// Reverse index order, as for every LinearContainer
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::PostOrderTraverse(TraverseFun fun) const {
+  for (ulong bucket = buckets.size(); bucket-- > 0; ) {
+    for (ulong position = buckets[bucket].size(); position-- > 0; ) {
+      fun(buckets[bucket][position]);
+    }
+  }
+}
+
+/* ************************************************************************** */
+/* PQRADIX - CLEARABLE CONTAINER FUNCTIONS                                     */
+/* ************************************************************************** */
+
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::Clear() {
+  for (auto & bucket : buckets) {
+    bucket.clear();
+  }
+  occupied = 0;
+  last = 0;
+  lowest = Absent;
+  size = 0;
+}
+
+/* ************************************************************************** */
+/* PQRADIX - AUXILIARY FUNCTIONS                                               */
+/* ************************************************************************** */
+
+template <typename Data, typename Key>
+ulong PQRadix<Data, Key>::LowestBucket() const noexcept {
+  return std::countr_zero(occupied) + 1;
+}
+
+template <typename Data, typename Key>
+ulong PQRadix<Data, Key>::LowestIndex() const {
+  if (lowest == Absent) {
+    const std::vector<Data> & bucket = buckets[LowestBucket()];
+    ulong best = 0;
+    Code bestCode = CodeOf(bucket[0]);
+    for (ulong index = 1; index < bucket.size(); ++index) {
+      Code code = CodeOf(bucket[index]);
+      if (code < bestCode) {
+        best = index;
+        bestCode = code;
+      }
+    }
+    lowest = best;
+  }
+  return lowest;
+}
+
+// Every value of bucket b shares the bits of the new last key above bit
+// b - 1, so it lands in a bucket below b
+template <typename Data, typename Key>
+void PQRadix<Data, Key>::Redistribute() {
+  ulong from = LowestBucket();
+  std::vector<Data> & bucket = buckets[from];
+  last = CodeOf(bucket[LowestIndex()]);
+  for (Data & value : bucket) {
+    ulong to = Bucket(CodeOf(value));
+    buckets[to].push_back(std::move(value));
+    if (to > 0) {
+      occupied |= std::uint64_t{1} << (to - 1);
+    }
+  }
+  bucket.clear();
+  occupied &= ~(std::uint64_t{1} << (from - 1));
+  lowest = Absent;
+}
+
+template <typename Data, typename Key>
+typename PQRadix<Data, Key>::Code PQRadix<Data, Key>::Admit(const Data & value) const {
+  Priority priority = key(value);
+  Code code = Encode(priority);
+  if (code < last) {
+    throw std::invalid_argument("Inserting key " + std::to_string(priority) + " below the last removed key "
+                                + std::to_string(Floor()) + " of a monotone priority queue.");
+  }
+  return code;
+}
+
+template <typename Data, typename Key>
+template <typename Item>
+void PQRadix<Data, Key>::Push(Item && value) {
+  Code code = Admit(value);
+  ulong to = Bucket(code);
+  ulong before = (lowest != Absent) ? LowestBucket() : 0;
+  buckets[to].push_back(std::forward<Item>(value));
+  ++size;
+  if (to == 0) {
+    lowest = Absent;
+    return;
+  }
+  occupied |= std::uint64_t{1} << (to - 1);
+  if (lowest != Absent) {
+    if (to < before || (to == before && code < CodeOf(buckets[to][lowest]))) {
+      lowest = buckets[to].size() - 1;
+    }
+  }
+}
+
+// The new value enters its bucket before the old one leaves (by a move of
+// the last value of its bucket into its place), so a throwing copy leaves the
+// queue as it was
+template <typename Data, typename Key>
+template <typename Item>
+void PQRadix<Data, Key>::Replace(ulong index, Item && value) {
+  auto [from, position] = Find(index);
+  ulong to = Bucket(Admit(value));
+  if (to == from) {
+    buckets[from][position] = std::forward<Item>(value);
+  } else {
+    buckets[to].push_back(std::forward<Item>(value));
+    if (to > 0) {
+      occupied |= std::uint64_t{1} << (to - 1);
+    }
+    std::vector<Data> & bucket = buckets[from];
+    if (position + 1 < bucket.size()) {
+      bucket[position] = std::move(bucket.back());
+    }
+    bucket.pop_back();
+    if (from > 0 && bucket.empty()) {
+      occupied &= ~(std::uint64_t{1} << (from - 1));
+    }
+  }
+  lowest = Absent;
+}
+
+template <typename Data, typename Key>
+Data PQRadix<Data, Key>::Pop() {
+  if (buckets[0].empty()) {
+    Redistribute();
+  }
+  Data value = std::move(buckets[0].back());
+  buckets[0].pop_back();
+  --size;
+  return value;
+}
+
+// Buckets are skipped whole, so at most Bits + 1 steps
+template <typename Data, typename Key>
+std::pair<ulong, ulong> PQRadix<Data, Key>::Find(ulong index) const {
+  if (index >= size) {
+    throw std::out_of_range("Access at index " + std::to_string(index) + "; priority queue size " + std::to_string(size) + ".");
+  }
+  ulong bucket = 0;
+  while (index >= buckets[bucket].size()) {
+    index -= buckets[bucket].size();
+    ++bucket;
+  }
+  return {bucket, index};
+}
+
+/* ************************************************************************** */
+
+}
@@ -0,0 +1,172 @@
+#ifndef PQRADIX_HPP
+#define PQRADIX_HPP
+
+/* ************************************************************************** */
+
+#include "../pq.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Radix heap: a min-priority queue for values with an integer key (Key maps
+// a value to it) that never goes below the key of the last removed value
+// (event times, Dijkstra distances). Bucket 0 holds the values whose key
+// equals the last removed one; bucket b > 0 those whose key first differs
+// from it in bit b - 1. Removing from an empty bucket 0 moves the lowest
+// non-empty bucket down once its minimum becomes the new last key, and every
+// value only ever moves to a lower bucket: O(1) Insert and amortised
+// O(log C) removal, with C the key range, and no comparisons between queued
+// values. Inserting a key below the last removed one throws. Index i is the
+// i-th value in bucket order, so operator[] and Change cost O(log C) to find
+// the bucket, and Change moves the value to the bucket of its new key.
+template <typename Data, typename Key = std::identity>
+class PQRadix final : virtual public PQ<Data> {
+
+private:
+
+protected:
+
+  using Container::size;
+
+  using Priority = std::remove_cvref_t<std::invoke_result_t<Key, const Data &>>;
+
+  static_assert(std::is_integral_v<Priority> && !std::is_same_v<Priority, bool>, "A radix heap needs integer keys");
+
+  using Code = std::make_unsigned_t<Priority>; // Order-preserving unsigned image of a key
+
+  static constexpr ulong Bits = std::numeric_limits<Code>::digits;
+  static constexpr ulong Absent = static_cast<ulong>(-1);
+
+  static_assert(Bits <= 64, "Bucket occupancy is kept in 64 bits");
+
+  std::array<std::vector<Data>, Bits + 1> buckets;
+  std::uint64_t occupied = 0; // Bit b - 1 set when bucket b > 0 is not empty
+  Code last = 0; // Code of the last removed key (the smallest key when none was removed)
+
+  mutable ulong lowest = Absent; // Index of the minimum in the lowest non-empty bucket, when known and bucket 0 is empty
+
+  [[no_unique_address]] Key key{};
+
+public:
+
+  // Default constructor
+  PQRadix() = default;
+
+  /* ************************************************************************ */
+
+  // Specific constructors
+  PQRadix(const TraversableContainer<Data> &); // A priority queue obtained from a TraversableContainer
+  PQRadix(MappableContainer<Data> &&); // A priority queue obtained from a MappableContainer
+
+  /* ************************************************************************ */
+
+  // Copy constructor
+  PQRadix(const PQRadix &);
+
+  // Move constructor
+  PQRadix(PQRadix &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Destructor
+  virtual ~PQRadix() = default;
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  PQRadix & operator=(const PQRadix &);
+
+  // Move assignment
+  PQRadix & operator=(PQRadix &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  inline Priority Floor() const noexcept { return Decode(last); } // Smallest key Insert accepts
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from PQ)
+
+  const Data & Tip() const override; // Override PQ member (smallest key; must throw std::length_error when empty)
+  void RemoveTip() override; // Override PQ member (must throw std::length_error when empty)
+  Data TipNRemove() override; // Override PQ member (must throw std::length_error when empty)
+
+  void Insert(const Data &) override; // Override PQ member (copy of the value; must throw std::invalid_argument when the key is below Floor())
+  void Insert(Data &&) override; // Override PQ member (move of the value; must throw std::invalid_argument when the key is below Floor())
+
+  void Change(ulong, const Data &) override; // Override PQ member (copy of the value; must throw std::out_of_range when out of range)
+  void Change(ulong, Data &&) override; // Override PQ member (move of the value; must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from LinearContainer)
+
+  const Data & operator[](ulong) const override; // Override LinearContainer member (must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from TraversableContainer)
+
+  using typename TraversableContainer<Data>::TraverseFun;
+
+  void Traverse(TraverseFun) const override; // Override TraversableContainer member
+  void PreOrderTraverse(TraverseFun) const override; // Override PreOrderTraversableContainer member
+  void PostOrderTraverse(TraverseFun) const override; // Override PostOrderTraversableContainer member
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from ClearableContainer)
+
+  void Clear() override; // Override ClearableContainer member (also resets Floor())
+
+protected:
+
+  static constexpr Code SignBit = std::is_signed_v<Priority> ? static_cast<Code>(Code{1} << (Bits - 1)) : Code{0};
+
+  inline static Code Encode(Priority priority) noexcept { return static_cast<Code>(static_cast<Code>(priority) ^ SignBit); }
+  inline static Priority Decode(Code code) noexcept { return static_cast<Priority>(static_cast<Code>(code ^ SignBit)); }
+
+  inline Code CodeOf(const Data & value) const { return Encode(key(value)); }
+  inline ulong Bucket(Code code) const noexcept { return std::bit_width(static_cast<Code>(code ^ last)); }
+
+  ulong LowestBucket() const noexcept; // Lowest non-empty bucket above 0 (there must be one)
+  ulong LowestIndex() const; // Index of the minimum of LowestBucket()
+
+  void Redistribute(); // Refills bucket 0 from the lowest non-empty bucket
+
+  Code Admit(const Data &) const; // Code of the key of a value, checked against Floor()
+
+  template <typename Item>
+  void Push(Item &&);
+
+  template <typename Item>
+  void Replace(ulong, Item &&);
+
+  Data Pop(); // Removes the back of bucket 0, refilling it when needed
+
+  std::pair<ulong, ulong> Find(ulong) const; // Bucket and position of an index
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "pqradix.cpp"
+
+#endif
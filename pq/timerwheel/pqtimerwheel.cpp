@@ -0,0 +1,526 @@
+
+namespace lasd {
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - CONSTRUCTORS                                                 */
+/* ************************************************************************** */
+
+template <typename Data, typename Deadline>
+PQTimerWheel<Data, Deadline>::PQTimerWheel() {
+  for (auto & level : heads) {
+    level.fill(Nil);
+  }
+}
+
+template <typename Data, typename Deadline>
+PQTimerWheel<Data, Deadline>::PQTimerWheel(const TraversableContainer<Data> & container) : PQTimerWheel() {
+  container.Traverse(
+    [this](const Data & dat) {
+      Push(dat);
+    }
+  );
+}
+
+template <typename Data, typename Deadline>
+PQTimerWheel<Data, Deadline>::PQTimerWheel(MappableContainer<Data> && container) : PQTimerWheel() {
+  container.Map(
+    [this](Data & dat) {
+      Push(std::move(dat));
+    }
+  );
+}
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - COPY AND MOVE CONSTRUCTORS                                   */
+/* ************************************************************************** */
+
+// Copy constructor (node by node: a node counts as live only once its value
+// is built, so the destructor cleans up after a throwing copy)
+template <typename Data, typename Deadline>
+PQTimerWheel<Data, Deadline>::PQTimerWheel(const PQTimerWheel & other) : PQTimerWheel() {
+  deadline = other.deadline;
+  chunks.reserve(other.chunks.size());
+  for (ulong chunk = 0; chunk < other.chunks.size(); ++chunk) {
+    chunks.push_back(std::unique_ptr<Node[]>(new Node[ChunkSize]));
+    for (ulong index = 0; index < ChunkSize; ++index) {
+      const Node & from = other.chunks[chunk][index];
+      Node & to = chunks[chunk][index];
+      to.code = from.code;
+      to.prev = from.prev;
+      to.next = from.next;
+      to.generation = from.generation;
+      if (from.where != Nil) {
+        std::construct_at(&to.value, from.value);
+        to.where = from.where;
+      }
+    }
+  }
+  freeHead = other.freeHead;
+  heads = other.heads;
+  occupied = other.occupied;
+  levels = other.levels;
+  now = other.now;
+  lowest = other.lowest;
+  size = other.size;
+}
+
+// Move constructor
+template <typename Data, typename Deadline>
+PQTimerWheel<Data, Deadline>::PQTimerWheel(PQTimerWheel && other) noexcept : PQTimerWheel() {
+  *this = std::move(other);
+}
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - DESTRUCTOR                                                   */
+/* ************************************************************************** */
+
+template <typename Data, typename Deadline>
+PQTimerWheel<Data, Deadline>::~PQTimerWheel() {
+  Release();
+}
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - ASSIGNMENT OPERATORS                                         */
+/* ************************************************************************** */
+
+// Copy assignment
+template <typename Data, typename Deadline>
+PQTimerWheel<Data, Deadline> & PQTimerWheel<Data, Deadline>::operator=(const PQTimerWheel & other) {
+  if (this != &other) {
+    PQTimerWheel temp{other};
+    *this = std::move(temp);
+  }
+  return *this;
+}
+
+// Move assignment
+template <typename Data, typename Deadline>
+PQTimerWheel<Data, Deadline> & PQTimerWheel<Data, Deadline>::operator=(PQTimerWheel && other) noexcept {
+  std::swap(chunks, other.chunks);
+  std::swap(freeHead, other.freeHead);
+  std::swap(heads, other.heads);
+  std::swap(occupied, other.occupied);
+  std::swap(levels, other.levels);
+  std::swap(now, other.now);
+  std::swap(lowest, other.lowest);
+  std::swap(deadline, other.deadline);
+  std::swap(size, other.size);
+  return *this;
+}
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - SPECIFIC MEMBER FUNCTIONS                                    */
+/* ************************************************************************** */
+
+template <typename Data, typename Deadline>
+typename PQTimerWheel<Data, Deadline>::Handle PQTimerWheel<Data, Deadline>::Schedule(const Data & value) {
+  if constexpr (std::is_copy_constructible_v<Data>) {
+    return Push(value);
+  } else {
+    throw std::logic_error("Inserting a copy of a value that is not copy constructible.");
+  }
+}
+
+template <typename Data, typename Deadline>
+typename PQTimerWheel<Data, Deadline>::Handle PQTimerWheel<Data, Deadline>::Schedule(Data && value) {
+  return Push(std::move(value));
+}
+
+template <typename Data, typename Deadline>
+bool PQTimerWheel<Data, Deadline>::Cancel(Handle handle) {
+  if (!Pending(handle)) {
+    return false;
+  }
+  Unlink(handle.index);
+  FreeNode(handle.index);
+  --size;
+  return true;
+}
+
+template <typename Data, typename Deadline>
+bool PQTimerWheel<Data, Deadline>::Pending(Handle handle) const noexcept {
+  return handle.index < chunks.size() * ChunkSize && At(handle.index).where != Nil
+         && At(handle.index).generation == handle.generation;
+}
+
+template <typename Data, typename Deadline>
+ulong PQTimerWheel<Data, Deadline>::Expire(Time time, ExpireFun fun) {
+  Code limit = Encode(time);
+  ulong count = 0;
+  while (size != 0 && At(Earliest()).code <= limit) {
+    fun(Pop());
+    ++count;
+  }
+  return count;
+}
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - PQ FUNCTIONS                                                 */
+/* ************************************************************************** */
+
+template <typename Data, typename Deadline>
+const Data & PQTimerWheel<Data, Deadline>::Tip() const {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return At(Earliest()).value;
+}
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::RemoveTip() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  Pop();
+}
+
+template <typename Data, typename Deadline>
+Data PQTimerWheel<Data, Deadline>::TipNRemove() {
+  if (size == 0) {
+    throw std::length_error("Priority queue is empty");
+  }
+  return Pop();
+}
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Insert(const Data & value) {
+  Schedule(value);
+}
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Insert(Data && value) {
+  Schedule(std::move(value));
+}
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Change(ulong index, const Data & value) {
+  if constexpr (std::is_copy_assignable_v<Data>) {
+    Replace(index, value);
+  } else {
+    throw std::logic_error("Assigning a copy of a value that is not copy assignable.");
+  }
+}
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Change(ulong index, Data && value) {
+  Replace(index, std::move(value));
+}
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - LINEAR CONTAINER FUNCTIONS                                   */
+/* ************************************************************************** */
+
+template <typename Data, typename Deadline>
+const Data & PQTimerWheel<Data, Deadline>::operator[](ulong index) const {
+  return At(Find(index)).value;
+}
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - TRAVERSABLE CONTAINER FUNCTIONS                              */
+/* ************************************************************************** */
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Traverse(TraverseFun fun) const {
+  PreOrderTraverse(fun);
+}
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::PreOrderTraverse(TraverseFun fun) const {
+  Walk(
+    [this, &fun](ulong node) {
+      fun(At(node).value);
+      return true;
+    }
+  );
+}
+
+// Reverse index order, as for every LinearContainer
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::PostOrderTraverse(TraverseFun fun) const {
+  std::vector<ulong> nodes;
+  nodes.reserve(size);
+  Walk(
+    [&nodes](ulong node) {
+      nodes.push_back(node);
+      return true;
+    }
+  );
+  for (ulong index = nodes.size(); index-- > 0; ) {
+    fun(At(nodes[index]).value);
+  }
+}
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - CLEARABLE CONTAINER FUNCTIONS                                */
+/* ************************************************************************** */
+
+// The nodes are kept and freed one by one, so that the handles given out so
+// far stay stale, as after Cancel
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Clear() {
+  for (ulong index = 0; index < chunks.size() * ChunkSize; ++index) {
+    if (At(index).where != Nil) {
+      FreeNode(index);
+    }
+  }
+  for (auto & level : heads) {
+    level.fill(Nil);
+  }
+  occupied.fill(0);
+  levels = 0;
+  now = 0;
+  lowest = Nil;
+  size = 0;
+}
+
+/* ************************************************************************** */
+/* PQTIMERWHEEL - AUXILIARY FUNCTIONS                                          */
+/* ************************************************************************** */
+
+// The level is the highest base-Slots digit in which the deadline differs
+// from now; since no deadline is below now, its digit there is above now's
+template <typename Data, typename Deadline>
+ulong PQTimerWheel<Data, Deadline>::Position(Code code) const noexcept {
+  Code differ = static_cast<Code>(code ^ now);
+  ulong level = (differ == 0) ? 0 : (std::bit_width(differ) - 1) / SlotBits;
+  ulong slot = static_cast<ulong>(code >> (level * SlotBits)) & (Slots - 1);
+  return level * Slots + slot;
+}
+
+// Positions compare as the deadlines they hold: lower level first, then
+// lower slot. A node added before the cached earliest one invalidates it.
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Link(ulong index) {
+  Node & node = At(index);
+  node.where = Position(node.code);
+  ulong level = node.where / Slots;
+  ulong slot = node.where % Slots;
+  ulong head = heads[level][slot];
+  if (head == Nil) {
+    node.prev = node.next = index;
+    heads[level][slot] = index;
+    occupied[level] |= std::uint64_t{1} << slot;
+    levels |= std::uint64_t{1} << level;
+  } else {
+    ulong tail = At(head).prev;
+    node.prev = tail;
+    node.next = head;
+    At(tail).next = index;
+    At(head).prev = index;
+  }
+  if (lowest != Nil) {
+    if (node.where < At(lowest).where) {
+      lowest = Nil;
+    } else if (node.where == At(lowest).where && node.code < At(lowest).code) {
+      lowest = index;
+    }
+  }
+}
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Unlink(ulong index) noexcept {
+  Node & node = At(index);
+  ulong level = node.where / Slots;
+  ulong slot = node.where % Slots;
+  if (node.next == index) {
+    heads[level][slot] = Nil;
+    occupied[level] &= ~(std::uint64_t{1} << slot);
+    if (occupied[level] == 0) {
+      levels &= ~(std::uint64_t{1} << level);
+    }
+  } else {
+    At(node.prev).next = node.next;
+    At(node.next).prev = node.prev;
+    if (heads[level][slot] == index) {
+      heads[level][slot] = node.next;
+    }
+  }
+  if (lowest == index) {
+    lowest = Nil;
+  }
+}
+
+// A slot of level 0 holds a single deadline, so its head is the earliest
+// (and the first inserted); a slot of a higher level has to be scanned
+template <typename Data, typename Deadline>
+ulong PQTimerWheel<Data, Deadline>::Earliest() const {
+  if (occupied[0] != 0) {
+    return heads[0][std::countr_zero(occupied[0])];
+  }
+  if (lowest == Nil) {
+    ulong level = std::countr_zero(levels);
+    ulong head = heads[level][std::countr_zero(occupied[level])];
+    lowest = head;
+    for (ulong index = At(head).next; index != head; index = At(index).next) {
+      if (At(index).code < At(lowest).code) {
+        lowest = index;
+      }
+    }
+  }
+  return lowest;
+}
+
+// Now moves to the earliest deadline of the slot. The deadlines of the other
+// slots still first differ from it in the same digit, so only the nodes of
+// this slot change position, each to a lower level.
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Cascade() {
+  now = At(Earliest()).code;
+  ulong level = std::countr_zero(levels);
+  ulong slot = std::countr_zero(occupied[level]);
+  ulong head = heads[level][slot];
+  heads[level][slot] = Nil;
+  occupied[level] &= ~(std::uint64_t{1} << slot);
+  if (occupied[level] == 0) {
+    levels &= ~(std::uint64_t{1} << level);
+  }
+  lowest = Nil;
+  ulong index = head;
+  do {
+    ulong next = At(index).next;
+    Link(index);
+    index = next;
+  } while (index != head);
+}
+
+template <typename Data, typename Deadline>
+template <typename Item>
+typename PQTimerWheel<Data, Deadline>::Handle PQTimerWheel<Data, Deadline>::Push(Item && value) {
+  Time time = deadline(value);
+  Code code = Encode(time);
+  if (code < now) {
+    throw std::invalid_argument("Scheduling deadline " + std::to_string(time) + " below the last removed deadline "
+                                + std::to_string(Floor()) + " of a timer wheel.");
+  }
+  ulong index = NewNode();
+  Node & node = At(index);
+  try {
+    std::construct_at(&node.value, std::forward<Item>(value));
+  } catch (...) {
+    node.next = freeHead;
+    freeHead = index;
+    throw;
+  }
+  node.code = code;
+  Link(index);
+  ++size;
+  return Handle{index, node.generation};
+}
+
+// The value is assigned before the node leaves its slot, so a throwing
+// assignment leaves the wheel as it was
+template <typename Data, typename Deadline>
+template <typename Item>
+void PQTimerWheel<Data, Deadline>::Replace(ulong index, Item && value) {
+  ulong found = Find(index);
+  Time time = deadline(value);
+  Code code = Encode(time);
+  if (code < now) {
+    throw std::invalid_argument("Scheduling deadline " + std::to_string(time) + " below the last removed deadline "
+                                + std::to_string(Floor()) + " of a timer wheel.");
+  }
+  Node & node = At(found);
+  node.value = std::forward<Item>(value);
+  Unlink(found);
+  node.code = code;
+  Link(found);
+}
+
+template <typename Data, typename Deadline>
+Data PQTimerWheel<Data, Deadline>::Pop() {
+  if (occupied[0] == 0) {
+    Cascade();
+  }
+  ulong index = heads[0][std::countr_zero(occupied[0])];
+  Node & node = At(index);
+  now = node.code;
+  Unlink(index);
+  Data value = std::move(node.value);
+  FreeNode(index);
+  --size;
+  return value;
+}
+
+template <typename Data, typename Deadline>
+ulong PQTimerWheel<Data, Deadline>::NewNode() {
+  if (freeHead == Nil) {
+    chunks.push_back(std::unique_ptr<Node[]>(new Node[ChunkSize]));
+    ulong base = (chunks.size() - 1) * ChunkSize;
+    for (ulong index = base + ChunkSize; index-- > base; ) {
+      At(index).next = freeHead;
+      freeHead = index;
+    }
+  }
+  ulong index = freeHead;
+  freeHead = At(index).next;
+  return index;
+}
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::FreeNode(ulong index) noexcept {
+  Node & node = At(index);
+  std::destroy_at(&node.value);
+  node.where = Nil;
+  ++node.generation;
+  node.next = freeHead;
+  freeHead = index;
+}
+
+template <typename Data, typename Deadline>
+ulong PQTimerWheel<Data, Deadline>::Find(ulong index) const {
+  if (index >= size) {
+    throw std::out_of_range("Access at index " + std::to_string(index) + "; priority queue size " + std::to_string(size) + ".");
+  }
+  ulong found = Nil;
+  Walk(
+    [&index, &found](ulong node) {
+      if (index-- == 0) {
+        found = node;
+        return false;
+      }
+      return true;
+    }
+  );
+  return found;
+}
+
+// Level by level, slot by slot, every slot list from its head
+template <typename Data, typename Deadline>
+template <typename Visit>
+void PQTimerWheel<Data, Deadline>::Walk(Visit visit) const {
+  for (ulong level = 0; level < Levels; ++level) {
+    for (std::uint64_t mask = occupied[level]; mask != 0; mask &= mask - 1) {
+      ulong head = heads[level][std::countr_zero(mask)];
+      ulong index = head;
+      do {
+        if (!visit(index)) {
+          return;
+        }
+        index = At(index).next;
+      } while (index != head);
+    }
+  }
+}
+
+template <typename Data, typename Deadline>
+void PQTimerWheel<Data, Deadline>::Release() noexcept {
+  for (ulong index = 0; index < chunks.size() * ChunkSize; ++index) {
+    if (At(index).where != Nil) {
+      std::destroy_at(&At(index).value);
+    }
+  }
+  chunks.clear();
+  freeHead = Nil;
+  for (auto & level : heads) {
+    level.fill(Nil);
+  }
+  occupied.fill(0);
+  levels = 0;
+  now = 0;
+  lowest = Nil;
+  size = 0;
+}
+
+/* ************************************************************************** */
+
+}
@@ -0,0 +1,221 @@
+#ifndef PQTIMERWHEEL_HPP
+#define PQTIMERWHEEL_HPP
+
+/* ************************************************************************** */
+
+#include "../pq.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/* ************************************************************************** */
+
+namespace lasd {
+
+/* ************************************************************************** */
+
+// Hierarchical timer wheel: a min-priority queue for values with an integer
+// deadline (Deadline maps a value to it) that never goes below the deadline
+// of the last removed value. Each level is a wheel of Slots lists and level l
+// holds the values whose deadline first differs from the current time in
+// the l-th base-Slots digit, in the slot of that digit. The earliest value is
+// in the first non-empty slot of the lowest non-empty level, both found with
+// a bit scan; a slot of a higher level is cascaded down when its turn comes,
+// and a value only ever moves to a lower level: O(1) Insert and amortised
+// O(1) removal (at most Levels moves per value), with no comparisons between
+// queued values. Values with the same deadline leave in insertion order.
+// Every value sits in a doubly linked slot list, so Schedule returns a handle
+// that Cancel uses to unlink it in O(1). Index i is the i-th value in wheel
+// order, so operator[] and Change cost O(n), as in PQPairing.
+template <typename Data, typename Deadline = std::identity>
+class PQTimerWheel final : virtual public PQ<Data> {
+
+private:
+
+protected:
+
+  using Container::size;
+
+  using Time = std::remove_cvref_t<std::invoke_result_t<Deadline, const Data &>>;
+
+  static_assert(std::is_integral_v<Time> && !std::is_same_v<Time, bool>, "A timer wheel needs integer deadlines");
+
+  using Code = std::make_unsigned_t<Time>; // Order-preserving unsigned image of a deadline
+
+  static constexpr ulong SlotBits = 6;
+  static constexpr ulong Slots = 1UL << SlotBits;
+  static constexpr ulong Bits = std::numeric_limits<Code>::digits;
+  static constexpr ulong Levels = (Bits + SlotBits - 1) / SlotBits;
+  static constexpr ulong ChunkBits = 10;
+  static constexpr ulong ChunkSize = 1UL << ChunkBits;
+  static constexpr ulong Nil = static_cast<ulong>(-1);
+
+  struct Node {
+    union {
+      Data value; // Constructed only while the node is in a slot
+    };
+    Code code = 0;
+    ulong prev = Nil; // Circular slot list
+    ulong next = Nil; // Circular slot list, or the free list
+    ulong generation = 0; // Bumped on release, so stale handles are recognised
+    ulong where = Nil; // Level * Slots + slot, or Nil when free
+
+    Node() {}
+    ~Node() {}
+  };
+
+  std::vector<std::unique_ptr<Node[]>> chunks; // Node i is chunks[i / ChunkSize][i % ChunkSize]
+  ulong freeHead = Nil;
+
+  std::array<std::array<ulong, Slots>, Levels> heads; // First node of every slot list, or Nil
+  std::array<std::uint64_t, Levels> occupied{}; // Bit s of level l set when its slot s is not empty
+  std::uint64_t levels = 0; // Bit l set when level l is not empty
+  Code now = 0; // Code of the last removed deadline (the smallest deadline when none was removed)
+
+  mutable ulong lowest = Nil; // Earliest node of the first non-empty slot, when known and level 0 is empty
+
+  [[no_unique_address]] Deadline deadline{};
+
+public:
+
+  // Identifies a scheduled value until it leaves the wheel
+  struct Handle {
+    ulong index = Nil;
+    ulong generation = 0;
+  };
+
+  // Default constructor
+  PQTimerWheel();
+
+  /* ************************************************************************ */
+
+  // Specific constructors
+  PQTimerWheel(const TraversableContainer<Data> &); // A priority queue obtained from a TraversableContainer
+  PQTimerWheel(MappableContainer<Data> &&); // A priority queue obtained from a MappableContainer
+
+  /* ************************************************************************ */
+
+  // Copy constructor (same layout, hence the same indices and handles)
+  PQTimerWheel(const PQTimerWheel &);
+
+  // Move constructor
+  PQTimerWheel(PQTimerWheel &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Destructor
+  virtual ~PQTimerWheel();
+
+  /* ************************************************************************ */
+
+  // Copy assignment
+  PQTimerWheel & operator=(const PQTimerWheel &);
+
+  // Move assignment
+  PQTimerWheel & operator=(PQTimerWheel &&) noexcept;
+
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  Handle Schedule(const Data &); // Copy of the value (must throw std::invalid_argument when the deadline is below Floor())
+  Handle Schedule(Data &&); // Move of the value (must throw std::invalid_argument when the deadline is below Floor())
+
+  bool Cancel(Handle); // Removes the value; false when it already left the wheel
+  bool Pending(Handle) const noexcept; // Whether the value is still in the wheel
+
+  using ExpireFun = std::function<void(Data &&)>;
+
+  // Removes, earliest first, every value whose deadline is at most the given
+  // time and hands it to the function; returns how many were removed
+  ulong Expire(Time, ExpireFun);
+
+  inline Time Floor() const noexcept { return Decode(now); } // Smallest deadline Schedule accepts
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from PQ)
+
+  const Data & Tip() const override; // Override PQ member (earliest deadline; must throw std::length_error when empty)
+  void RemoveTip() override; // Override PQ member (must throw std::length_error when empty)
+  Data TipNRemove() override; // Override PQ member (must throw std::length_error when empty)
+
+  void Insert(const Data &) override; // Override PQ member (copy of the value; as Schedule)
+  void Insert(Data &&) override; // Override PQ member (move of the value; as Schedule)
+
+  void Change(ulong, const Data &) override; // Override PQ member (copy of the value; must throw std::out_of_range when out of range)
+  void Change(ulong, Data &&) override; // Override PQ member (move of the value; must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from LinearContainer)
+
+  const Data & operator[](ulong) const override; // Override LinearContainer member (must throw std::out_of_range when out of range)
+
+  /* ************************************************************************ */
+
+  // Specific member functions (inherited from TraversableContainer)
+
+  using typename TraversableContainer<Data>::TraverseFun;
+
+  void Traverse(TraverseFun) const override; // Override TraversableContainer member
+  void PreOrderTraverse(TraverseFun) const override; // Override PreOrderTraversableContainer member
+  void PostOrderTraverse(TraverseFun) const override; // Override PostOrderTraversableContainer member
+
+  /* ************************************************************************ */
+
+  // Specific member function (inherited from ClearableContainer)
+
+  void Clear() override; // Override ClearableContainer member (also resets Floor() and invalidates every handle; keeps the nodes)
+
+protected:
+
+  static constexpr Code SignBit = std::is_signed_v<Time> ? static_cast<Code>(Code{1} << (Bits - 1)) : Code{0};
+
+  inline static Code Encode(Time time) noexcept { return static_cast<Code>(static_cast<Code>(time) ^ SignBit); }
+  inline static Time Decode(Code code) noexcept { return static_cast<Time>(static_cast<Code>(code ^ SignBit)); }
+
+  inline Node & At(ulong index) const noexcept { return chunks[index >> ChunkBits][index & (ChunkSize - 1)]; }
+
+  ulong Position(Code) const noexcept; // Level * Slots + slot of a deadline, relative to now
+
+  void Link(ulong); // Appends a node to the slot list of its deadline
+  void Unlink(ulong) noexcept; // Removes a node from its slot list
+
+  ulong Earliest() const; // Node with the earliest deadline (the wheel must not be empty)
+  void Cascade(); // Moves the first non-empty slot down to lower levels (level 0 must be empty)
+
+  template <typename Item>
+  Handle Push(Item &&);
+
+  template <typename Item>
+  void Replace(ulong, Item &&);
+
+  Data Pop(); // Removes the earliest node
+
+  ulong NewNode();
+  void FreeNode(ulong) noexcept; // Destroys the value and returns the node to the free list
+
+  ulong Find(ulong) const; // Node at a position of the wheel order
+
+  template <typename Visit>
+  void Walk(Visit) const; // Nodes in wheel order; stops when the visitor returns false
+
+  void Release() noexcept; // Destroys every value and frees the nodes
+
+};
+
+/* ************************************************************************** */
+
+}
+
+#include "pqtimerwheel.cpp"
+
+#endif
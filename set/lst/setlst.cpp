@@ -2,57 +2,49 @@ namespace lasd {
 
 
   /* ******************************* Auxiliary protected functions ******************************* */
-  template <typename Data>
-  void SetLst<Data>::InsertInOrder(const Data& data) {
-    if (size == 0 || data <= head->val) {
-      this->InsertAtFront(data);
-      return;
+  // The search runs before any allocation, so a throwing comparison or
+  // allocation leaves the set as it was
+  template <typename Data, typename Compare>
+  bool SetLst<Data, Compare>::InsertInOrder(const Data& data) {
+    Link* path[MaxHeight];
+    ulong ranks[MaxHeight];
+    Tower* before = Seek(data, path, ranks);
+    if (path[0]->next != nullptr && !Less(data, path[0]->next->node->val)) {
+      return false;
     }
-    typename List<Data>::Node* current = head;
-    while (current->next != nullptr && current->next->val < data) {
-      current = current->next;
-    }
-    typename List<Data>::Node* newNode = new typename List<Data>::Node(data);
-    newNode->next = current->next;
-    current->next = newNode;
-    if (newNode->next == nullptr) {
-      tail = newNode;
-    }
-    size++;
+    std::unique_ptr<Tower> tower(new Tower{nullptr, std::vector<Link>(NewHeight())});
+    tower->node = new typename List<Data>::Node(data);
+    Splice(before, tower.release(), path, ranks);
+    return true;
   }
 
-  template <typename Data>
-  void SetLst<Data>::InsertInOrder(Data&& data) {
-    if (size == 0 || data <= head->val) {
-      this->InsertAtFront(std::move(data));
-      return;
+  template <typename Data, typename Compare>
+  bool SetLst<Data, Compare>::InsertInOrder(Data&& data) {
+    Link* path[MaxHeight];
+    ulong ranks[MaxHeight];
+    Tower* before = Seek(data, path, ranks);
+    if (path[0]->next != nullptr && !Less(data, path[0]->next->node->val)) {
+      return false;
     }
-    typename List<Data>::Node* current = head;
-    while (current->next != nullptr && current->next->val < data) {
-      current = current->next;
-    }
-    typename List<Data>::Node* newNode = new typename List<Data>::Node(std::move(data));
-    newNode->next = current->next;
-    current->next = newNode;
-    if (newNode->next == nullptr) {
-      tail = newNode;
-    }
-    size++;
+    std::unique_ptr<Tower> tower(new Tower{nullptr, std::vector<Link>(NewHeight())});
+    tower->node = new typename List<Data>::Node(std::move(data));
+    Splice(before, tower.release(), path, ranks);
+    return true;
   }
 
 
   /* ******************************* Specific Constructors ******************************* */
   // Construct from TraversableContainer
-  template <typename Data>
-  SetLst<Data>::SetLst(const TraversableContainer<Data>& container) {
+  template <typename Data, typename Compare>
+  SetLst<Data, Compare>::SetLst(const TraversableContainer<Data>& container) {
     container.Traverse([this](const Data& data) {
       this->Insert(data);
     });
   }
 
   // Construct from MappableContainer (move)
-  template <typename Data>
-  SetLst<Data>::SetLst(MappableContainer<Data>&& container) {
+  template <typename Data, typename Compare>
+  SetLst<Data, Compare>::SetLst(MappableContainer<Data>&& container) {
     container.Map([this](Data& data) {
       this->Insert(std::move(data));
     });
@@ -61,24 +53,35 @@ namespace lasd {
 
   /* ******************************* Copy/move constructors ******************************* */
   // Copy constructor
-  template <typename Data>
-  SetLst<Data>::SetLst(const SetLst<Data>& other) : List<Data>() {
+  template <typename Data, typename Compare>
+  SetLst<Data, Compare>::SetLst(const SetLst<Data, Compare>& other) : List<Data>(), compare(other.compare) {
     other.Traverse([this](const Data& data) {
       this->Insert(data);
     });
   }
 
   // Move constructor
-  template <typename Data>
-  SetLst<Data>::SetLst(SetLst<Data>&& other) noexcept : List<Data>(std::move(other)) {}
+  template <typename Data, typename Compare>
+  SetLst<Data, Compare>::SetLst(SetLst<Data, Compare>&& other) noexcept : List<Data>(std::move(other)), compare(other.compare) {
+    std::swap(lanes, other.lanes);
+    std::swap(height, other.height);
+  }
+
+
+  /* ******************************* Destructor ******************************* */
+  template <typename Data, typename Compare>
+  SetLst<Data, Compare>::~SetLst() {
+    ClearIndex();
+  }
 
 
   /* ******************************* Assignment operators ******************************* */
   // Copy assignment
-  template <typename Data>
-  SetLst<Data>& SetLst<Data>::operator=(const SetLst<Data>& other) {
+  template <typename Data, typename Compare>
+  SetLst<Data, Compare>& SetLst<Data, Compare>::operator=(const SetLst<Data, Compare>& other) {
     if (this != &other) {
-      this->Clear();
+      Clear();
+      compare = other.compare;
       other.Traverse([this](const Data& data) {
         this->Insert(data);
       });
@@ -87,349 +90,413 @@ namespace lasd {
   }
 
   // Move assignment
-  template <typename Data>
-  SetLst<Data>& SetLst<Data>::operator=(SetLst<Data>&& other) noexcept {
+  template <typename Data, typename Compare>
+  SetLst<Data, Compare>& SetLst<Data, Compare>::operator=(SetLst<Data, Compare>&& other) noexcept {
     List<Data>::operator=(std::move(other));
+    std::swap(compare, other.compare);
+    std::swap(lanes, other.lanes);
+    std::swap(height, other.height);
     return *this;
   }
 
 
   /* ******************************* Comparison operators ******************************* */
-  template <typename Data>
-  bool SetLst<Data>::operator==(const SetLst<Data>& other) const noexcept {
+  template <typename Data, typename Compare>
+  bool SetLst<Data, Compare>::operator==(const SetLst<Data, Compare>& other) const noexcept {
     return List<Data>::operator==(other);
   }
 
-  template <typename Data>
-  inline bool SetLst<Data>::operator!=(const SetLst<Data>& other) const noexcept {
+  template <typename Data, typename Compare>
+  inline bool SetLst<Data, Compare>::operator!=(const SetLst<Data, Compare>& other) const noexcept {
     return !(*this == other);
   }
 
   /* ******************************* Ordered Dictionary Functions ******************************* */
   // Min/Max functions
-  template <typename Data>
-  const Data& SetLst<Data>::Min() const {
+  template <typename Data, typename Compare>
+  const Data& SetLst<Data, Compare>::Min() const {
     if (size == 0) throw std::length_error("Empty set");
     return head->val;
   }
 
-  template <typename Data>
-  Data SetLst<Data>::MinNRemove() {
+  template <typename Data, typename Compare>
+  Data SetLst<Data, Compare>::MinNRemove() {
     if (size == 0) throw std::length_error("Empty set");
-    return this->FrontNRemove();
+    return TakeAt(0);
   }
 
-  template <typename Data>
-  void SetLst<Data>::RemoveMin() {
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::RemoveMin() {
     if (size == 0) throw std::length_error("Empty set");
-    this->RemoveFromFront();
+    TakeAt(0);
   }
 
-  template <typename Data>
-  const Data& SetLst<Data>::Max() const {
+  template <typename Data, typename Compare>
+  const Data& SetLst<Data, Compare>::Max() const {
     if (size == 0) throw std::length_error("Empty set");
     return tail->val;
   }
 
-  template <typename Data>
-  Data SetLst<Data>::MaxNRemove() {
+  template <typename Data, typename Compare>
+  Data SetLst<Data, Compare>::MaxNRemove() {
     if (size == 0) throw std::length_error("Empty set");
     return this->BackNRemove();
   }
 
-  template <typename Data>
-  void SetLst<Data>::RemoveMax() {
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::RemoveMax() {
     if (size == 0) throw std::length_error("Empty set");
     this->RemoveFromBack();
   }
 
 
   /* ******************************* List Auxiliary operations ******************************* */
-  // BackNRemove
-  template <typename Data>
-  Data SetLst<Data>::BackNRemove() {
+  // The last node is reached through the index, not by walking the list
+  template <typename Data, typename Compare>
+  Data SetLst<Data, Compare>::BackNRemove() {
     if (size == 0) throw std::length_error("Empty list");
-
-    Data value = tail->val;
-
-    if (head == tail) {
-      delete head;
-      head = tail = nullptr;
-    } else {
-      typename List<Data>::Node* current = head;
-      while (current->next != tail) {
-        current = current->next;
-      }
-      delete tail;
-      tail = current;
-      current->next = nullptr;
-    }
-
-    size--;
-    return value;
+    return TakeAt(size - 1);
   }
 
-  // RemoveFromBack
-  template <typename Data>
-  void SetLst<Data>::RemoveFromBack() {
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::RemoveFromBack() {
     if (size == 0) throw std::length_error("Empty list");
-
-    if (head == tail) {
-      delete head;
-      head = tail = nullptr;
-    } else {
-      typename List<Data>::Node* current = head;
-      while (current->next != tail) {
-        current = current->next;
-      }
-      delete tail;
-      tail = current;
-      current->next = nullptr;
-    }
-
-    size--;
+    TakeAt(size - 1);
   }
 
 
   /* ******************************* Successor/Predecessor operations ******************************* */
   // Predecessor operations
-  template <typename Data>
-  const Data& SetLst<Data>::Predecessor(const Data& data) const {
+  template <typename Data, typename Compare>
+  const Data& SetLst<Data, Compare>::Predecessor(const Data& data) const {
     if (size == 0) throw std::length_error("Empty set");
     typename List<Data>::Node* pred = FindPointerToPredecessor(data);
     if (pred == nullptr) throw std::length_error("Predecessor not found");
     return pred->val;
   }
 
-  template <typename Data>
-  Data SetLst<Data>::PredecessorNRemove(const Data& data) {
+  template <typename Data, typename Compare>
+  Data SetLst<Data, Compare>::PredecessorNRemove(const Data& data) {
     if (size == 0) throw std::length_error("Empty set");
-    typename List<Data>::Node* pred = FindPointerToPredecessor(data);
-    if (pred == nullptr) throw std::length_error("Predecessor not found");
-    
-    Data value = pred->val;
-    
-    if (pred == head) {
-      return this->FrontNRemove();
-    } else {
-      typename List<Data>::Node* current = head;
-      while (current->next != pred) {
-        current = current->next;
-      }
-      current->next = pred->next;
-      if (pred == tail) {
-        tail = current;
-      }
-      delete pred;
-      size--;
-    }
-    return value;
+    ulong rank = Count(data, false);
+    if (rank == 0) throw std::length_error("Predecessor not found");
+    return TakeAt(rank - 1);
   }
 
-  template <typename Data>
-  void SetLst<Data>::RemovePredecessor(const Data& data) {
-    if (size == 0) throw std::length_error("Empty set");
-    typename List<Data>::Node* pred = FindPointerToPredecessor(data);
-    if (pred == nullptr) throw std::length_error("Predecessor not found");
-    
-    if (pred == head) {
-      this->RemoveFromFront();
-    } else {
-      typename List<Data>::Node* current = head;
-      while (current->next != pred) {
-        current = current->next;
-      }
-      current->next = pred->next;
-      if (pred == tail) {
-        tail = current;
-      }
-      delete pred;
-      size--;
-    }
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::RemovePredecessor(const Data& data) {
+    PredecessorNRemove(data);
   }
 
   // Successor operations
-  template <typename Data>
-  const Data& SetLst<Data>::Successor(const Data& data) const {
+  template <typename Data, typename Compare>
+  const Data& SetLst<Data, Compare>::Successor(const Data& data) const {
     if (size == 0) throw std::length_error("Empty set");
     typename List<Data>::Node* succ = FindPointerToSuccessor(data);
     if (succ == nullptr) throw std::length_error("Successor not found");
     return succ->val;
   }
 
-  template <typename Data>
-  Data SetLst<Data>::SuccessorNRemove(const Data& data) {
+  template <typename Data, typename Compare>
+  Data SetLst<Data, Compare>::SuccessorNRemove(const Data& data) {
     if (size == 0) throw std::length_error("Empty set");
-    typename List<Data>::Node* succ = FindPointerToSuccessor(data);
-    if (succ == nullptr) throw std::length_error("Successor not found");
-    
-    Data value = succ->val;
-    
-    if (succ == head) {
-      return this->FrontNRemove();
-    } else {
-      typename List<Data>::Node* current = head;
-      while (current->next != succ) {
-        current = current->next;
-      }
-      current->next = succ->next;
-      if (succ == tail) {
-        tail = current;
-      }
-      delete succ;
-      size--;
-    }
-    return value;
+    ulong rank = Count(data, true);
+    if (rank == size) throw std::length_error("Successor not found");
+    return TakeAt(rank);
   }
 
-  template <typename Data>
-  void SetLst<Data>::RemoveSuccessor(const Data& data) {
-    if (size == 0) throw std::length_error("Empty set");
-    typename List<Data>::Node* succ = FindPointerToSuccessor(data);
-    if (succ == nullptr) throw std::length_error("Successor not found");
-    
-    if (succ == head) {
-      this->RemoveFromFront();
-    } else {
-      typename List<Data>::Node* current = head;
-      while (current->next != succ) {
-        current = current->next;
-      }
-      current->next = succ->next;
-      if (succ == tail) {
-        tail = current;
-      }
-      delete succ;
-      size--;
-    }
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::RemoveSuccessor(const Data& data) {
+    SuccessorNRemove(data);
   }
 
 
   /* ******************************* Dictionary Container  ******************************* */
   // Insert operations
-  template <typename Data>
-  bool SetLst<Data>::Insert(const Data& data) {
-    if (this->Exists(data)) return false;
-    InsertInOrder(data);
-    return true;
+  template <typename Data, typename Compare>
+  bool SetLst<Data, Compare>::Insert(const Data& data) {
+    if constexpr (std::is_copy_constructible_v<Data>) {
+      return InsertInOrder(data);
+    } else {
+      throw std::logic_error("Inserting a copy of a value that is not copy constructible.");
+    }
   }
 
-  template <typename Data>
-  bool SetLst<Data>::Insert(Data&& data) {
-    if (this->Exists(data)) return false;
-    InsertInOrder(std::move(data));
-    return true;
+  template <typename Data, typename Compare>
+  bool SetLst<Data, Compare>::Insert(Data&& data) {
+    return InsertInOrder(std::move(data));
   }
 
   // Remove operation
-  template <typename Data>
-  bool SetLst<Data>::Remove(const Data& data) {
+  template <typename Data, typename Compare>
+  bool SetLst<Data, Compare>::Remove(const Data& data) {
     if (size == 0) return false;
-    if (head->val == data) {
-      this->RemoveFromFront();
-      return true;
+    Link* path[MaxHeight];
+    ulong ranks[MaxHeight];
+    Tower* before = Seek(data, path, ranks);
+    Tower* found = path[0]->next;
+    if (found == nullptr || Less(data, found->node->val)) return false;
+    Cut(before, found, path);
+    return true;
+  }
+
+
+  /* ******************************* Testable Container ******************************* */
+  template <typename Data, typename Compare>
+  bool SetLst<Data, Compare>::Exists(const Data& data) const noexcept {
+    return FindPointerTo(data) != nullptr;
+  }
+
+
+  /* ******************************* Range operations (Set) ******************************* */
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::TraverseRange(const Data& lo, const Data& hi, TraverseFun fun) const {
+    ulong first = Count(lo, false);
+    typename List<Data>::Node* current = (first < size) ? At(first)->node : nullptr;
+    for (; current != nullptr && Less(current->val, hi); current = current->next) {
+      fun(current->val);
     }
-    
-    typename List<Data>::Node* current = head;
-    while (current->next != nullptr && current->next->val != data) {
-      current = current->next;
+  }
+
+  template <typename Data, typename Compare>
+  ulong SetLst<Data, Compare>::CountRange(const Data& lo, const Data& hi) const {
+    if (!Less(lo, hi)) return 0;
+    return Count(hi, false) - Count(lo, false);
+  }
+
+  // Both ends are found through the index; each removal then costs O(log n)
+  template <typename Data, typename Compare>
+  ulong SetLst<Data, Compare>::RemoveRange(const Data& lo, const Data& hi) {
+    if (size == 0 || !Less(lo, hi)) return 0;
+    ulong first = Count(lo, false);
+    ulong removed = Count(hi, false) - first;
+    Link* path[MaxHeight];
+    for (ulong count = 0; count < removed; count++) {
+      Tower* before = Seek(first, path);
+      Cut(before, path[0]->next, path);
     }
-    
-    if (current->next == nullptr) return false;
-    
-    typename List<Data>::Node* temp = current->next;
-    current->next = temp->next;
-    
-    if (temp == tail) {
-      tail = current;
+    return removed;
+  }
+
+
+  /* ******************************* Order statistics (Set) ******************************* */
+  template <typename Data, typename Compare>
+  ulong SetLst<Data, Compare>::Rank(const Data& data) const {
+    return Count(data, false);
+  }
+
+  template <typename Data, typename Compare>
+  const Data& SetLst<Data, Compare>::Select(ulong rank) const {
+    if (rank >= size) {
+      throw std::out_of_range("Rank " + std::to_string(rank) + " out of range; set size " + std::to_string(size) + ".");
     }
-    
-    delete temp;
-    size--;
-    return true;
+    return At(rank)->node->val;
+  }
+
+
+  /* ******************************* Clearable Container ******************************* */
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::Clear() {
+    ClearIndex();
+    List<Data>::Clear();
   }
 
 
   /* ******************************* Auxiliary finder methods ******************************* */
-  template <typename Data>
-  typename List<Data>::Node* SetLst<Data>::FindPointerToMin() const {
+  template <typename Data, typename Compare>
+  typename List<Data>::Node* SetLst<Data, Compare>::FindPointerToMin() const {
     return head;
   }
 
-  template <typename Data>
-  typename List<Data>::Node* SetLst<Data>::FindPointerToMax() const {
+  template <typename Data, typename Compare>
+  typename List<Data>::Node* SetLst<Data, Compare>::FindPointerToMax() const {
     return tail;
   }
 
-  template <typename Data>
-  typename List<Data>::Node* SetLst<Data>::FindPointerToPredecessor(const Data& data) const {
-    if (size == 0 || data <= head->val) return nullptr;
-    
-    typename List<Data>::Node* current = head;
-    typename List<Data>::Node* predecessor = nullptr;
-    
-    while (current != nullptr && current->val < data) {
-      predecessor = current;
-      current = current->next;
+  template <typename Data, typename Compare>
+  typename List<Data>::Node* SetLst<Data, Compare>::FindPointerToPredecessor(const Data& data) const {
+    ulong rank = Count(data, false);
+    return (rank == 0) ? nullptr : At(rank - 1)->node;
+  }
+
+  template <typename Data, typename Compare>
+  typename List<Data>::Node* SetLst<Data, Compare>::FindPointerToSuccessor(const Data& data) const {
+    ulong rank = Count(data, true);
+    return (rank == size) ? nullptr : At(rank)->node;
+  }
+
+  template <typename Data, typename Compare>
+  typename List<Data>::Node* SetLst<Data, Compare>::FindPointerTo(const Data& data) const {
+    ulong rank = Count(data, false);
+    if (rank == size) return nullptr;
+    typename List<Data>::Node* node = At(rank)->node;
+    return Less(data, node->val) ? nullptr : node;
+  }
+
+
+  /* ******************************* Skip list index ******************************* */
+  // Each level is walked while the next tower still precedes (or, inclusive,
+  // does not follow) the value, adding up the spans passed over
+  template <typename Data, typename Compare>
+  ulong SetLst<Data, Compare>::Count(const Data& data, bool inclusive) const {
+    ulong rank = 0;
+    const Tower* at = nullptr;
+    for (ulong level = height; level-- > 0; ) {
+      const Link* link = (at == nullptr) ? &lanes[level] : &at->links[level];
+      while (link->next != nullptr && (inclusive ? !Less(data, link->next->node->val) : Less(link->next->node->val, data))) {
+        rank += link->span;
+        at = link->next;
+        link = &at->links[level];
+      }
+    }
+    return rank;
+  }
+
+  template <typename Data, typename Compare>
+  const typename SetLst<Data, Compare>::Tower* SetLst<Data, Compare>::At(ulong rank) const noexcept {
+    ulong passed = 0;
+    const Tower* at = nullptr;
+    for (ulong level = height; level-- > 0; ) {
+      const Link* link = (at == nullptr) ? &lanes[level] : &at->links[level];
+      while (link->next != nullptr && passed + link->span <= rank + 1) {
+        passed += link->span;
+        at = link->next;
+        link = &at->links[level];
+      }
+    }
+    return at;
+  }
+
+  template <typename Data, typename Compare>
+  typename SetLst<Data, Compare>::Tower* SetLst<Data, Compare>::Seek(const Data& data, Link** path, ulong* ranks) {
+    ulong rank = 0;
+    Tower* at = nullptr;
+    for (ulong level = height; level-- > 0; ) {
+      Link* link = (at == nullptr) ? &lanes[level] : &at->links[level];
+      while (link->next != nullptr && Less(link->next->node->val, data)) {
+        rank += link->span;
+        at = link->next;
+        link = &at->links[level];
+      }
+      path[level] = link;
+      ranks[level] = rank;
+    }
+    return at;
+  }
+
+  template <typename Data, typename Compare>
+  typename SetLst<Data, Compare>::Tower* SetLst<Data, Compare>::Seek(ulong rank, Link** path) noexcept {
+    ulong passed = 0;
+    Tower* at = nullptr;
+    for (ulong level = height; level-- > 0; ) {
+      Link* link = (at == nullptr) ? &lanes[level] : &at->links[level];
+      while (link->next != nullptr && passed + link->span <= rank) {
+        passed += link->span;
+        at = link->next;
+        link = &at->links[level];
+      }
+      path[level] = link;
+    }
+    return at;
+  }
+
+  // A link entering the new tower spans up to it; the tower's own link takes
+  // over the rest; links passing above it span one more node
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::Splice(Tower* before, Tower* tower, Link** path, ulong* ranks) noexcept {
+    typename List<Data>::Node* node = tower->node;
+    if (before == nullptr) {
+      node->next = head;
+      head = node;
+    } else {
+      node->next = before->node->next;
+      before->node->next = node;
+    }
+    if (node->next == nullptr) {
+      tail = node;
+    }
+
+    ulong levels = tower->links.size();
+    for (; height < levels; ++height) {
+      path[height] = &lanes[height];
+      ranks[height] = 0;
+      lanes[height].span = size;
+    }
+    for (ulong level = 0; level < height; ++level) {
+      if (level < levels) {
+        ulong gap = ranks[0] - ranks[level];
+        tower->links[level].next = path[level]->next;
+        tower->links[level].span = path[level]->span - gap;
+        path[level]->next = tower;
+        path[level]->span = gap + 1;
+      } else {
+        path[level]->span++;
+      }
     }
-    
-    return predecessor;
+    size++;
   }
 
-  template <typename Data>
-  typename List<Data>::Node* SetLst<Data>::FindPointerToSuccessor(const Data& data) const {
-    if (size == 0 || data >= tail->val) return nullptr;
-    
-    typename List<Data>::Node* current = head;
-    while (current != nullptr && current->val <= data) {
-      current = current->next;
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::Cut(Tower* before, Tower* tower, Link** path) noexcept {
+    typename List<Data>::Node* node = tower->node;
+    if (before == nullptr) {
+      head = node->next;
+    } else {
+      before->node->next = node->next;
+    }
+    if (tail == node) {
+      tail = (before == nullptr) ? nullptr : before->node;
+    }
+
+    for (ulong level = 0; level < height; ++level) {
+      if (path[level]->next == tower) {
+        path[level]->span += tower->links[level].span - 1;
+        path[level]->next = tower->links[level].next;
+      } else {
+        path[level]->span--;
+      }
+    }
+    while (height > 1 && lanes[height - 1].next == nullptr) {
+      lanes[--height].span = 0;
     }
-    
-    return current;
+    node->next = nullptr;
+    delete node;
+    delete tower;
+    size--;
   }
 
-  template <typename Data>
-  typename List<Data>::Node* SetLst<Data>::FindPointerTo(const Data& data) const {
-    return BinarySearch(data);
+  template <typename Data, typename Compare>
+  Data SetLst<Data, Compare>::TakeAt(ulong rank) {
+    Link* path[MaxHeight];
+    Tower* before = Seek(rank, path);
+    Tower* tower = path[0]->next;
+    Data value = std::move(tower->node->val);
+    Cut(before, tower, path);
+    return value;
   }
 
+  // A tower reaches each level above the first with probability 1/4
+  template <typename Data, typename Compare>
+  ulong SetLst<Data, Compare>::NewHeight() noexcept {
+    draw ^= draw << 13;
+    draw ^= draw >> 7;
+    draw ^= draw << 17;
+    return 1 + std::countr_zero(draw | (1UL << 62)) / 2;
+  }
 
-  /* ******************************* Binary search auxiliary functions ******************************* */
-  template <typename Data>
-  typename List<Data>::Node* SetLst<Data>::Reach(typename List<Data>::Node* startNode, unsigned int steps) const {
-    if (startNode == nullptr) return nullptr;
-    
-    typename List<Data>::Node* current = startNode;
-    for (unsigned int i = 0; i < steps && current != nullptr; ++i) {
-        current = current->next;
+  // The list keeps its nodes; only the towers are freed
+  template <typename Data, typename Compare>
+  void SetLst<Data, Compare>::ClearIndex() noexcept {
+    Tower* at = lanes[0].next;
+    while (at != nullptr) {
+      Tower* next = at->links[0].next;
+      delete at;
+      at = next;
     }
-    return current;
-  }
-
-  template <typename Data>
-  typename List<Data>::Node* SetLst<Data>::BinarySearch(const Data& data) const {
-    if (size == 0) return nullptr;
-    
-    unsigned int length = size;
-    typename List<Data>::Node* current = head;
-    
-    while (length > 0) {
-        unsigned int step = length / 2;
-        typename List<Data>::Node* mid = Reach(current, step);
-        
-        if (mid == nullptr) break;
-        
-        if (mid->val == data) {
-            return mid;
-        } else if (mid->val < data) {
-            current = mid->next;
-            length = length - step - 1;
-        } else {
-            length = step;
-        }
+    for (ulong level = 0; level < MaxHeight; ++level) {
+      lanes[level] = Link();
     }
-    
-    return nullptr;  // Element not found
+    height = 1;
   }
 
-}
\ No newline at end of file
+}
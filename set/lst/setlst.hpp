@@ -4,22 +4,56 @@
 #include "../set.hpp"
 #include "../../list/list.hpp"
 
+#include <bit>
+#include <functional>
+#include <memory>
+#include <vector>
+
 /* ************************************************************************** */
 
 namespace lasd {
 
 
-    template<typename Data>
-    class SetLst : virtual public Set<Data>,
-                   virtual public List<Data> {
+    // Sorted by Compare (a strict weak order), as SetVec
+    template<typename Data, typename Compare = std::less<Data>>
+    class SetLst final : virtual public Set<Data>,
+                         virtual public List<Data> {
     protected:
         using Container::size;
         using List<Data>::head;
         using List<Data>::tail;
 
-        // Funzione ausiliaria per mantenere elementi ordinati
-        void InsertInOrder(const Data &);
-        void InsertInOrder(Data &&);
+        // Indexable skip list over the nodes, updated along with the list: each
+        // link records how many nodes it passes over, so Rank, Select and the
+        // search for the place of a value take O(log n) expected steps
+        struct Tower;
+        struct Link {
+            Tower * next = nullptr;
+            ulong span = 0;
+        };
+        struct Tower {
+            typename List<Data>::Node * node;
+            std::vector<Link> links;
+        };
+
+        static constexpr ulong MaxHeight = 32;
+        Link lanes[MaxHeight]; // The links leaving the head, one per level
+        ulong height = 1; // Levels in use
+        ulong draw = 0x9E3779B97F4A7C15UL; // Xorshift state for the tower heights
+
+        [[no_unique_address]] Compare compare{};
+
+        inline bool Less(const Data & a, const Data & b) const { return compare(a, b); }
+
+        // The list mutators would bypass both the order and the index
+        using List<Data>::InsertAtFront;
+        using List<Data>::InsertAtBack;
+        using List<Data>::RemoveFromFront;
+        using List<Data>::FrontNRemove;
+
+        // Funzione ausiliaria per mantenere elementi ordinati (false if already present)
+        bool InsertInOrder(const Data &);
+        bool InsertInOrder(Data &&);
 
         Data BackNRemove();
         void RemoveFromBack();
@@ -45,7 +79,7 @@ namespace lasd {
         /* ************************************************************************ */
 
         // Destructor
-        virtual ~SetLst() = default;
+        virtual ~SetLst();
 
         /* ************************************************************************ */
 
@@ -117,6 +151,31 @@ namespace lasd {
         bool Insert(Data &&) override; // Override DictionaryContainer member (move of the value)
         bool Remove(const Data &) override; // Override DictionaryContainer member
 
+        /* ************************************************************************ */
+
+        // Specific member function (inherited from TestableContainer)
+
+        bool Exists(const Data &) const noexcept override; // Override TestableContainer member
+
+        /* ************************************************************************ */
+
+        // Specific member functions (inherited from Set)
+
+        using typename Set<Data>::TraverseFun;
+
+        void TraverseRange(const Data &, const Data &, TraverseFun) const override; // Override Set member
+        ulong CountRange(const Data &, const Data &) const override; // Override Set member
+        ulong RemoveRange(const Data &, const Data &) override; // Override Set member
+
+        ulong Rank(const Data &) const override; // Override Set member
+        const Data &Select(ulong) const override; // Override Set member (must throw std::out_of_range when out of range)
+
+        /* ************************************************************************ */
+
+        // Specific member function (inherited from ClearableContainer)
+
+        void Clear() override; // Override ClearableContainer member
+
     protected:
         // Auxiliary functions, if necessary!
         typename List<Data>::Node *FindPointerToMin() const;
@@ -129,9 +188,17 @@ namespace lasd {
 
         typename List<Data>::Node *FindPointerTo(const Data &) const;
         
-        typename List<Data>::Node *Reach(typename List<Data>::Node* startNode, unsigned int steps) const;
-        
-        typename List<Data>::Node *BinarySearch(const Data& data) const;
+
+        ulong Count(const Data &, bool) const; // Values before the given one (or not after it, if inclusive)
+        const Tower *At(ulong) const noexcept; // The tower of the value of the given rank
+
+        Tower *Seek(const Data &, Link **, ulong *); // Last tower before the value (nullptr for the head), with the path to it
+        Tower *Seek(ulong, Link **) noexcept; // Last tower before the given rank, with the path to it
+        void Splice(Tower *, Tower *, Link **, ulong *) noexcept; // Links a new tower and its node after the first one
+        void Cut(Tower *, Tower *, Link **) noexcept; // Unlinks and frees a tower and its node, found after the first one
+        Data TakeAt(ulong); // Removes the value of the given rank
+        ulong NewHeight() noexcept;
+        void ClearIndex() noexcept;
     };
 
     /* ************************************************************************** */
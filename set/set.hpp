@@ -24,6 +24,24 @@ namespace lasd {
 
         // Move assignment
         Set &operator=(Set &&) noexcept = delete; // Move assignment of abstract types is not possible.
+
+        /* ************************************************************************ */
+
+        // Specific member functions (ranges are half-open: [lo, hi))
+
+        using typename TraversableContainer<Data>::TraverseFun;
+
+        virtual void TraverseRange(const Data &, const Data &, TraverseFun) const = 0; // Visits the values of the range in ascending order
+
+        virtual ulong CountRange(const Data &, const Data &) const = 0;
+
+        virtual ulong RemoveRange(const Data &, const Data &) = 0; // Returns the number of removed values
+
+        // Order statistics
+
+        virtual ulong Rank(const Data &) const = 0; // Number of values strictly less than the given one
+
+        virtual const Data &Select(ulong) const = 0; // Value of the given rank, from 0 (concrete function must throw std::out_of_range when out of range)
     };
 
     /* ************************************************************************** */
@@ -1,8 +1,12 @@
+
+#include <cstring>
+#include <memory>
+
 namespace lasd {
 
     /* ******************************* Binary search utility functions ******************************* */
-    template <typename Data>
-    ulong SetVec<Data>::BinarySearch(const Data& data) const {
+    template <typename Data, typename Compare>
+    ulong SetVec<Data, Compare>::BinarySearch(const Data& data) const {
         if (size == 0 || Vector<Data>::elements == nullptr) {
             return size;
         }
@@ -14,25 +18,23 @@ namespace lasd {
             ulong mid = left + (right - left) / 2;
             ulong physMid = physicalIndex(mid);
             
-            if (Vector<Data>::elements[physMid] == data) {
-                return mid; // Ritorna l'indice logico
-            }
-            
-            if (Vector<Data>::elements[physMid] < data) {
+            if (Less(Vector<Data>::elements[physMid], data)) {
                 left = mid + 1;
-            } else {
+            } else if (Less(data, Vector<Data>::elements[physMid])) {
                 if (mid == 0) {
                     break;
                 }
                 right = mid - 1;
+            } else {
+                return mid; // Ritorna l'indice logico
             }
         }
         
         return size;
     }
     
-    template <typename Data>
-    ulong SetVec<Data>::BinarySearchInsertion(const Data& data) const {
+    template <typename Data, typename Compare>
+    ulong SetVec<Data, Compare>::BinarySearchInsertion(const Data& data) const {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         return 0;
       }
@@ -42,18 +44,17 @@ namespace lasd {
     
       while (left <= right) {
         ulong mid = left + (right - left) / 2;
+        ulong physMid = physicalIndex(mid);
     
-        if (Vector<Data>::elements[mid] == data) {
-          return mid;
-        }
-    
-        if (Vector<Data>::elements[mid] < data) {
+        if (Less(Vector<Data>::elements[physMid], data)) {
           left = mid + 1;
-        } else {
+        } else if (Less(data, Vector<Data>::elements[physMid])) {
           if (mid == 0) {
             break;
           }
           right = mid - 1;
+        } else {
+          return mid;
         }
       }
     
@@ -61,74 +62,134 @@ namespace lasd {
     }
     
     /* ******************************* Array manipulation functions  ******************************* */
-    // ShiftRight
-    template <typename Data>
-    void SetVec<Data>::ShiftRight(ulong logicalIndex) {
+    // ShiftRight: opens an uninitialised slot at the given logical index
+    template <typename Data, typename Compare>
+    void SetVec<Data, Compare>::ShiftRight(ulong logicalIndex) {
         if (size >= capacity || Vector<Data>::elements == nullptr) {
             ulong newCapacity = (capacity == 0) ? 1 : capacity * 2;
-            Data* newElements = new Data[newCapacity]{};
             
-            for (ulong i = 0; i < size; i++) {
-                ulong oldPhysIdx = physicalIndex(i);
+            if (Vector<Data>::UseRealloc && head == 0) {
+                // Grown in place; the shift below then runs on the larger buffer
+                Vector<Data>::elements = Vector<Data>::ReallocateElements(Vector<Data>::elements, size, newCapacity);
+                capacity = newCapacity;
+                tail = size;
+            } else {
+                Data* newElements = Vector<Data>::AllocateElements(newCapacity);
                 
-                if (i < logicalIndex) {
-                    newElements[i] = Vector<Data>::elements[oldPhysIdx];
-                } else {
-                    newElements[i + 1] = Vector<Data>::elements[oldPhysIdx];
+                for (ulong i = 0; i < size; i++) {
+                    Data* oldElement = Vector<Data>::elements + physicalIndex(i);
+                    std::construct_at(newElements + ((i < logicalIndex) ? i : i + 1), std::move(*oldElement));
+                    std::destroy_at(oldElement);
                 }
+                
+                Vector<Data>::ReleaseElements(Vector<Data>::elements, 0);
+                Vector<Data>::elements = newElements;
+                capacity = newCapacity;
+                head = 0;
+                tail = size + 1;
+                size++;
+                return;
             }
-            
-            delete[] Vector<Data>::elements;
-            Vector<Data>::elements = newElements;
-            capacity = newCapacity;
-            head = 0;
-            tail = size + 1;
-        } else {
-            tail = (tail + 1) % capacity;
-            
-            for (ulong i = size; i > logicalIndex; i--) {
+        }
+        
+        tail = (tail + 1) & (capacity - 1);
+        
+        if constexpr (IsTriviallyRelocatable<Data>::value) {
+            Relocate(logicalIndex, logicalIndex + 1, size - logicalIndex);
+        } else if (logicalIndex < size) {
+            std::construct_at(Vector<Data>::elements + physicalIndex(size),
+                              std::move(Vector<Data>::elements[physicalIndex(size - 1)]));
+            for (ulong i = size - 1; i > logicalIndex; i--) {
                 Vector<Data>::elements[physicalIndex(i)] = 
-                    Vector<Data>::elements[physicalIndex(i-1)];
+                    std::move(Vector<Data>::elements[physicalIndex(i-1)]);
             }
+            std::destroy_at(Vector<Data>::elements + physicalIndex(logicalIndex));
         }
         
         size++;
     }
     
-    // ShiftLeft
-    template <typename Data>
-    void SetVec<Data>::ShiftLeft(ulong logicalIndex) {
+    // ShiftLeft: destroys the value at the given logical index and closes the gap
+    template <typename Data, typename Compare>
+    void SetVec<Data, Compare>::ShiftLeft(ulong logicalIndex) {
         if (size == 0) return;
         
-        for (ulong i = logicalIndex; i < size - 1; i++) {
-            Vector<Data>::elements[physicalIndex(i)] = 
-                Vector<Data>::elements[physicalIndex(i+1)];
+        if constexpr (IsTriviallyRelocatable<Data>::value) {
+            std::destroy_at(Vector<Data>::elements + physicalIndex(logicalIndex));
+            Relocate(logicalIndex + 1, logicalIndex, size - 1 - logicalIndex);
+        } else {
+            for (ulong i = logicalIndex; i < size - 1; i++) {
+                Vector<Data>::elements[physicalIndex(i)] = 
+                    std::move(Vector<Data>::elements[physicalIndex(i+1)]);
+            }
+            std::destroy_at(Vector<Data>::elements + physicalIndex(size - 1));
         }
         
-        tail = (tail - 1 + capacity) % capacity;
+        tail = (tail + capacity - 1) & (capacity - 1);
         size--;
         
-        if (size > 0 && size <= capacity / 4 && capacity > 1) {
-            ulong newCapacity = capacity / 2;
-            Data* newElements = new Data[newCapacity]{};
+        Shrink();
+    }
+    
+    // Shrink
+    template <typename Data, typename Compare>
+    void SetVec<Data, Compare>::Shrink() {
+        ulong newCapacity = capacity;
+        while (size > 0 && size <= newCapacity / 4 && newCapacity > 1) {
+            newCapacity /= 2;
+        }
+        if (newCapacity == capacity) return;
+        
+        if (Vector<Data>::UseRealloc && head == 0) {
+            Vector<Data>::elements = Vector<Data>::ReallocateElements(Vector<Data>::elements, size, newCapacity);
+        } else {
+            Data* newElements = Vector<Data>::AllocateElements(newCapacity);
             
             for (ulong i = 0; i < size; i++) {
-                newElements[i] = Vector<Data>::elements[physicalIndex(i)];
+                Data* oldElement = Vector<Data>::elements + physicalIndex(i);
+                std::construct_at(newElements + i, std::move(*oldElement));
+                std::destroy_at(oldElement);
             }
             
-            delete[] Vector<Data>::elements;
+            Vector<Data>::ReleaseElements(Vector<Data>::elements, 0);
             Vector<Data>::elements = newElements;
-            capacity = newCapacity;
             head = 0;
-            tail = size;
+        }
+        capacity = newCapacity;
+        tail = size & (capacity - 1);
+    }
+    
+    // Relocate (trivially relocatable types only): memmove of count logical slots
+    // from one position to another, one call per contiguous physical segment
+    template <typename Data, typename Compare>
+    void SetVec<Data, Compare>::Relocate(ulong from, ulong to, ulong count) {
+        Data* elements = Vector<Data>::elements;
+        if (to < from) {
+            while (count > 0) {
+                ulong src = physicalIndex(from);
+                ulong dst = physicalIndex(to);
+                ulong chunk = std::min({count, capacity - src, capacity - dst});
+                std::memmove(static_cast<void*>(elements + dst), elements + src, chunk * sizeof(Data));
+                from += chunk;
+                to += chunk;
+                count -= chunk;
+            }
+        } else {
+            while (count > 0) {
+                ulong srcEnd = physicalIndex(from + count - 1) + 1;
+                ulong dstEnd = physicalIndex(to + count - 1) + 1;
+                ulong chunk = std::min({count, srcEnd, dstEnd});
+                std::memmove(static_cast<void*>(elements + dstEnd - chunk), elements + srcEnd - chunk, chunk * sizeof(Data));
+                count -= chunk;
+            }
         }
     }
     
 
     /* ******************************* Constructors ******************************* */
     // Specific constructors
-    template <typename Data>
-    SetVec<Data>::SetVec(const TraversableContainer<Data>& container) 
+    template <typename Data, typename Compare>
+    SetVec<Data, Compare>::SetVec(const TraversableContainer<Data>& container) 
         : Vector<Data>(), capacity(0) {
         std::vector<Data> tempElements;
     
@@ -141,8 +202,8 @@ namespace lasd {
         }
     }
     
-    template <typename Data>
-    SetVec<Data>::SetVec(MappableContainer<Data>&& container)
+    template <typename Data, typename Compare>
+    SetVec<Data, Compare>::SetVec(MappableContainer<Data>&& container)
         : Vector<Data>(), capacity(0) {
         std::vector<Data> tempElements;
     
@@ -157,56 +218,74 @@ namespace lasd {
     
 
     /* ******************************* Copy and move constructors ******************************* */
-    template <typename Data>
-    SetVec<Data>::SetVec(const SetVec<Data>& other)
-        : Vector<Data>(other), capacity(other.capacity) {
+    // Same capacity as the source, values unrolled from its head
+    template <typename Data, typename Compare>
+    SetVec<Data, Compare>::SetVec(const SetVec<Data, Compare>& other)
+        : Vector<Data>(), capacity(other.capacity), compare(other.compare) {
+        Vector<Data>::elements = Vector<Data>::AllocateElements(capacity);
+        try {
+            for (; size < other.size; size++) {
+                std::construct_at(Vector<Data>::elements + size, other.elements[other.physicalIndex(size)]);
+            }
+        } catch (...) {
+            Vector<Data>::ReleaseElements(Vector<Data>::elements, size);
+            Vector<Data>::elements = nullptr;
+            size = 0;
+            capacity = 0;
+            throw;
+        }
+        tail = (capacity == 0) ? 0 : size & (capacity - 1);
     }
     
-    template <typename Data>
-    SetVec<Data>::SetVec(SetVec<Data>&& other) noexcept
-        : Vector<Data>(std::move(other)), capacity(other.capacity) {
+    template <typename Data, typename Compare>
+    SetVec<Data, Compare>::SetVec(SetVec<Data, Compare>&& other) noexcept
+        : Vector<Data>(std::move(other)), capacity(other.capacity), head(other.head), tail(other.tail), compare(other.compare) {
         other.capacity = 0;
+        other.head = 0;
+        other.tail = 0;
     }
     
 
     /* ******************************* Assignment operators ******************************* */
     // Copy assignment
-    template <typename Data>
-    SetVec<Data>& SetVec<Data>::operator=(const SetVec<Data>& other) {
+    template <typename Data, typename Compare>
+    SetVec<Data, Compare>& SetVec<Data, Compare>::operator=(const SetVec<Data, Compare>& other) {
         if (this != &other) {
-            Vector<Data>::operator=(other);
-            capacity = other.capacity;
+            SetVec<Data, Compare> temp(other);
+            *this = std::move(temp);
         }
         return *this;
     }
     
     // Move assignment
-    template <typename Data>
-    SetVec<Data>& SetVec<Data>::operator=(SetVec<Data>&& other) noexcept {
+    template <typename Data, typename Compare>
+    SetVec<Data, Compare>& SetVec<Data, Compare>::operator=(SetVec<Data, Compare>&& other) noexcept {
         if (this != &other) {
             Vector<Data>::operator=(std::move(other));
-            capacity = other.capacity;
-            other.capacity = 0;
+            std::swap(capacity, other.capacity);
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            std::swap(compare, other.compare);
         }
         return *this;
     }
     
 
     /* ******************************* Comparison operators ******************************* */
-    template <typename Data>
-    bool SetVec<Data>::operator==(const SetVec<Data>& other) const noexcept {
+    template <typename Data, typename Compare>
+    bool SetVec<Data, Compare>::operator==(const SetVec<Data, Compare>& other) const noexcept {
       return Vector<Data>::operator==(other);
     }
     
-    template <typename Data>
-    inline bool SetVec<Data>::operator!=(const SetVec<Data>& other) const noexcept {
+    template <typename Data, typename Compare>
+    inline bool SetVec<Data, Compare>::operator!=(const SetVec<Data, Compare>& other) const noexcept {
       return !(*this == other);
     }
     
 
     /* ******************************* Min/Max operations (OrderedDictionaryContainer) ******************************* */
-    template <typename Data>
-    const Data& SetVec<Data>::Min() const {
+    template <typename Data, typename Compare>
+    const Data& SetVec<Data, Compare>::Min() const {
         if (size == 0 || Vector<Data>::elements == nullptr) {
             throw std::length_error("Empty set");
         }
@@ -214,8 +293,8 @@ namespace lasd {
         return Vector<Data>::elements[head];
     }
     
-    template <typename Data>
-    const Data& SetVec<Data>::Max() const {
+    template <typename Data, typename Compare>
+    const Data& SetVec<Data, Compare>::Max() const {
         if (size == 0 || Vector<Data>::elements == nullptr) {
             throw std::length_error("Empty set");
         }
@@ -223,20 +302,20 @@ namespace lasd {
         return Vector<Data>::elements[physicalIndex(size - 1)];
     }
     
-    template <typename Data>
-    Data SetVec<Data>::MinNRemove() {
+    template <typename Data, typename Compare>
+    Data SetVec<Data, Compare>::MinNRemove() {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
     
-      Data min = Vector<Data>::elements[0];
+      Data min = std::move(Vector<Data>::elements[physicalIndex(0)]);
       ShiftLeft(0);
     
       return min;
     }
     
-    template <typename Data>
-    void SetVec<Data>::RemoveMin() {
+    template <typename Data, typename Compare>
+    void SetVec<Data, Compare>::RemoveMin() {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
@@ -244,20 +323,20 @@ namespace lasd {
       ShiftLeft(0);
     }
     
-    template <typename Data>
-    Data SetVec<Data>::MaxNRemove() {
+    template <typename Data, typename Compare>
+    Data SetVec<Data, Compare>::MaxNRemove() {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
     
-      Data max = Vector<Data>::elements[size - 1];
+      Data max = std::move(Vector<Data>::elements[physicalIndex(size - 1)]);
       ShiftLeft(size - 1);
     
       return max;
     }
     
-    template <typename Data>
-    void SetVec<Data>::RemoveMax() {
+    template <typename Data, typename Compare>
+    void SetVec<Data, Compare>::RemoveMax() {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
@@ -267,8 +346,8 @@ namespace lasd {
     
 
     /* ******************************* Predecessor operations (OrderedDictionaryContainer) ******************************* */
-    template <typename Data>
-    const Data& SetVec<Data>::Predecessor(const Data& data) const {
+    template <typename Data, typename Compare>
+    const Data& SetVec<Data, Compare>::Predecessor(const Data& data) const {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
@@ -282,8 +361,8 @@ namespace lasd {
       return Vector<Data>::elements[index - 1];
     }
     
-    template <typename Data>
-    Data SetVec<Data>::PredecessorNRemove(const Data& data) {
+    template <typename Data, typename Compare>
+    Data SetVec<Data, Compare>::PredecessorNRemove(const Data& data) {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
@@ -294,14 +373,14 @@ namespace lasd {
         throw std::length_error("Predecessor not found");
       }
     
-      Data pred = Vector<Data>::elements[index - 1];
+      Data pred = std::move(Vector<Data>::elements[physicalIndex(index - 1)]);
       ShiftLeft(index - 1);
     
       return pred;
     }
     
-    template <typename Data>
-    void SetVec<Data>::RemovePredecessor(const Data& data) {
+    template <typename Data, typename Compare>
+    void SetVec<Data, Compare>::RemovePredecessor(const Data& data) {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
@@ -317,15 +396,15 @@ namespace lasd {
     
 
     /* ******************************* Successor operations (OrderedDictionaryContainer) ******************************* */
-    template <typename Data>
-    const Data& SetVec<Data>::Successor(const Data& data) const {
+    template <typename Data, typename Compare>
+    const Data& SetVec<Data, Compare>::Successor(const Data& data) const {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
     
       ulong index = BinarySearchInsertion(data);
     
-      if (index >= size || Vector<Data>::elements[index] == data) {
+      if (index >= size || Equivalent(Vector<Data>::elements[index], data)) {
         if (index + 1 >= size) {
           throw std::length_error("Successor not found");
         }
@@ -335,36 +414,36 @@ namespace lasd {
       return Vector<Data>::elements[index];
     }
     
-    template <typename Data>
-    Data SetVec<Data>::SuccessorNRemove(const Data& data) {
+    template <typename Data, typename Compare>
+    Data SetVec<Data, Compare>::SuccessorNRemove(const Data& data) {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
     
       ulong index = BinarySearchInsertion(data);
     
-      if (index >= size || Vector<Data>::elements[index] == data) {
+      if (index >= size || Equivalent(Vector<Data>::elements[index], data)) {
         if (index + 1 >= size) {
           throw std::length_error("Successor not found");
         }
         index++;
       }
     
-      Data succ = Vector<Data>::elements[index];
+      Data succ = std::move(Vector<Data>::elements[physicalIndex(index)]);
       ShiftLeft(index);
     
       return succ;
     }
     
-    template <typename Data>
-    void SetVec<Data>::RemoveSuccessor(const Data& data) {
+    template <typename Data, typename Compare>
+    void SetVec<Data, Compare>::RemoveSuccessor(const Data& data) {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         throw std::length_error("Empty set");
       }
     
       ulong index = BinarySearchInsertion(data);
     
-      if (index >= size || Vector<Data>::elements[index] == data) {
+      if (index >= size || Equivalent(Vector<Data>::elements[index], data)) {
         if (index + 1 >= size) {
           throw std::length_error("Successor not found");
         }
@@ -377,50 +456,62 @@ namespace lasd {
 
     /* ******************************* Insert/Remove operations (DictionaryContainer) ******************************* */
     // Insert
-    template <typename Data>
-    bool SetVec<Data>::Insert(const Data& data) {
+    template <typename Data, typename Compare>
+    bool SetVec<Data, Compare>::Insert(const Data& data) {
+      if constexpr (std::is_copy_constructible_v<Data>) {
         if (size > 0 && Vector<Data>::elements != nullptr) {
-            ulong index = BinarySearchInsertion(data);
-            
-            if (index < size && Vector<Data>::elements[index] == data) {
-                return false;
-            }
-            
-            ShiftRight(index);
-            Vector<Data>::elements[index] = data;
+          ulong index = BinarySearchInsertion(data);
+    
+          if (index < size && Equivalent(Vector<Data>::elements[physicalIndex(index)], data)) {
+            return false;
+          }
+    
+          ShiftRight(index);
+          std::construct_at(Vector<Data>::elements + physicalIndex(index), data);
         } else {
-            capacity = 1;
-            Vector<Data>::elements = new Data[capacity]{};
-            Vector<Data>::elements[0] = data;
-            size = 1;
+          Vector<Data>::ReleaseElements(Vector<Data>::elements, 0);
+          Vector<Data>::elements = nullptr;
+          capacity = 1;
+          head = 0;
+          tail = 0;
+          Vector<Data>::elements = Vector<Data>::AllocateElements(capacity);
+          std::construct_at(Vector<Data>::elements, data);
+          size = 1;
         }
-        
+    
         return true;
+      } else {
+        throw std::logic_error("Inserting a copy of a value that is not copy constructible.");
+      }
     }
     
-    template <typename Data>
-    bool SetVec<Data>::Insert(Data&& data) {
+    template <typename Data, typename Compare>
+    bool SetVec<Data, Compare>::Insert(Data&& data) {
       if (size > 0 && Vector<Data>::elements != nullptr) {
         ulong index = BinarySearchInsertion(data);
     
-        if (index < size && Vector<Data>::elements[index] == data) {
+        if (index < size && Equivalent(Vector<Data>::elements[physicalIndex(index)], data)) {
           return false;
         }
     
         ShiftRight(index);
-        Vector<Data>::elements[index] = std::move(data);
+        std::construct_at(Vector<Data>::elements + physicalIndex(index), std::move(data));
       } else {
+        Vector<Data>::ReleaseElements(Vector<Data>::elements, 0);
+        Vector<Data>::elements = nullptr;
         capacity = 1;
-        Vector<Data>::elements = new Data[capacity]{};
-        Vector<Data>::elements[0] = std::move(data);
+        head = 0;
+        tail = 0;
+        Vector<Data>::elements = Vector<Data>::AllocateElements(capacity);
+        std::construct_at(Vector<Data>::elements, std::move(data));
         size = 1;
       }
     
       return true;
     }
     
-    template <typename Data>
-    bool SetVec<Data>::Remove(const Data& data) {
+    template <typename Data, typename Compare>
+    bool SetVec<Data, Compare>::Remove(const Data& data) {
       if (size == 0 || Vector<Data>::elements == nullptr) {
         return false;
       }
@@ -435,6 +526,75 @@ namespace lasd {
       return true;
     }
     
+    /* ******************************* Exists (TestableContainer) ******************************* */
+    template <typename Data, typename Compare>
+    bool SetVec<Data, Compare>::Exists(const Data& data) const noexcept {
+      return BinarySearch(data) < size;
+    }
+    
+    /* ******************************* Range operations (Set) ******************************* */
+    // One binary search for lo, then a sequential scan of the range
+    template <typename Data, typename Compare>
+    void SetVec<Data, Compare>::TraverseRange(const Data& lo, const Data& hi, TraverseFun fun) const {
+      for (ulong i = BinarySearchInsertion(lo); i < size; i++) {
+        const Data& value = Vector<Data>::elements[physicalIndex(i)];
+        if (!Less(value, hi)) {
+          break;
+        }
+        fun(value);
+      }
+    }
+    
+    template <typename Data, typename Compare>
+    ulong SetVec<Data, Compare>::CountRange(const Data& lo, const Data& hi) const {
+      if (!Less(lo, hi)) {
+        return 0;
+      }
+      return BinarySearchInsertion(hi) - BinarySearchInsertion(lo);
+    }
+    
+    // Moves the values after the range down over it, then shrinks once
+    template <typename Data, typename Compare>
+    ulong SetVec<Data, Compare>::RemoveRange(const Data& lo, const Data& hi) {
+      if (size == 0 || !Less(lo, hi)) {
+        return 0;
+      }
+    
+      ulong first = BinarySearchInsertion(lo);
+      ulong last = BinarySearchInsertion(hi);
+      if (last <= first) {
+        return 0;
+      }
+    
+      for (ulong i = last; i < size; i++) {
+        Vector<Data>::elements[physicalIndex(first + i - last)] =
+            std::move(Vector<Data>::elements[physicalIndex(i)]);
+      }
+    
+      ulong removed = last - first;
+      for (ulong i = size - removed; i < size; i++) {
+        std::destroy_at(Vector<Data>::elements + physicalIndex(i));
+      }
+      size -= removed;
+      tail = (head + size) % capacity;
+      Shrink();
+      return removed;
+    }
+    
+    /* ******************************* Order statistics (Set) ******************************* */
+    template <typename Data, typename Compare>
+    ulong SetVec<Data, Compare>::Rank(const Data& data) const {
+      return BinarySearchInsertion(data);
+    }
+    
+    template <typename Data, typename Compare>
+    const Data& SetVec<Data, Compare>::Select(ulong rank) const {
+      if (rank >= size) {
+        throw std::out_of_range("Rank " + std::to_string(rank) + " out of range; set size " + std::to_string(size) + ".");
+      }
+      return Vector<Data>::elements[physicalIndex(rank)];
+    }
+    
     /* ************************************************************************** */
     
-    }
\ No newline at end of file
+    }
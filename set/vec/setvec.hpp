@@ -3,15 +3,21 @@
 
 #include "../set.hpp"
 #include "../../vector/vector.hpp"
+#include "../../container/static.hpp"
+
+#include <functional>
 
 /* ************************************************************************** */
 
 namespace lasd {
 
-    template<typename Data>
-    class SetVec : virtual public Set<Data>,
-                   virtual public Vector<Data>,
-                   virtual public ResizableContainer {
+    // Ordered by Compare (a strict weak order); two values are the same element
+    // when neither precedes the other. The comparator takes no storage when stateless.
+    template<typename Data, typename Compare = std::less<Data>>
+    class SetVec final : virtual public Set<Data>,
+                         virtual public Vector<Data>,
+                         virtual public ResizableContainer,
+                         public StaticLinearContainer<SetVec<Data, Compare>, Data> {
     protected:
         using Container::size;
 
@@ -19,9 +25,14 @@ namespace lasd {
         unsigned long head = 0;
         unsigned long tail = 0;
 
-        // Utility function for conversion
+        [[no_unique_address]] Compare compare{};
+
+        inline bool Less(const Data & a, const Data & b) const { return compare(a, b); }
+        inline bool Equivalent(const Data & a, const Data & b) const { return !compare(a, b) && !compare(b, a); }
+
+        // Utility function for conversion (capacity is always a power of two)
         inline ulong physicalIndex(ulong logicalIndex) const {
-            return (head + logicalIndex) % capacity;
+            return (head + logicalIndex) & (capacity - 1);
         }
 
         // Utility function to maintain sorted order
@@ -119,6 +130,25 @@ namespace lasd {
         bool Insert(Data &&) override; // Override DictionaryContainer member (move of the value)
         bool Remove(const Data &) override; // Override DictionaryContainer member
 
+        /* ************************************************************************ */
+
+        // Specific member function (inherited from TestableContainer)
+
+        bool Exists(const Data &) const noexcept override; // Override TestableContainer member (binary search)
+
+        /* ************************************************************************ */
+
+        // Specific member functions (inherited from Set)
+
+        using typename Set<Data>::TraverseFun;
+
+        void TraverseRange(const Data &, const Data &, TraverseFun) const override; // Override Set member
+        ulong CountRange(const Data &, const Data &) const override; // Override Set member
+        ulong RemoveRange(const Data &, const Data &) override; // Override Set member
+
+        ulong Rank(const Data &) const override; // Override Set member
+        const Data &Select(ulong) const override; // Override Set member (must throw std::out_of_range when out of range)
+
     protected:
 
         // Auxiliary functions for InsertOrder
@@ -127,6 +157,10 @@ namespace lasd {
         void ShiftRight(ulong);
 
         void ShiftLeft(ulong);
+
+        void Shrink(); // Halves the capacity while at most a quarter of it is in use
+
+        void Relocate(ulong, ulong, ulong); // memmove of a logical range (trivially relocatable types only)
     };
 
     /* ************************************************************************** */
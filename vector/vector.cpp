@@ -1,31 +1,129 @@
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
 namespace lasd {
 
+/* ************************************************************************** */
+/* VECTOR - BUFFER MANAGEMENT                                                  */
+/* ************************************************************************** */
+
+template<typename Data>
+Data* Vector<Data>::AllocateElements(const unsigned long count) {
+    if (count == 0) {
+        return nullptr;
+    }
+    const std::size_t bytes = Skew + count * sizeof(Data);
+    if constexpr (UseRealloc) {
+        // aligned_alloc wants a multiple of the alignment; the block is freed
+        // and regrown by free and realloc as any malloc'd one
+        void* block = std::aligned_alloc(LineBytes, (bytes + LineBytes - 1) / LineBytes * LineBytes);
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+        return reinterpret_cast<Data*>(static_cast<unsigned char*>(block) + Skew);
+    } else {
+        void* block = ::operator new(bytes, std::align_val_t(LineBytes));
+        return reinterpret_cast<Data*>(static_cast<unsigned char*>(block) + Skew);
+    }
+}
+
+template<typename Data>
+Data* Vector<Data>::ReallocateElements(Data* buffer, const unsigned long live, const unsigned long newCount) {
+    if (newCount == 0) {
+        ReleaseElements(buffer, live);
+        return nullptr;
+    }
+    if constexpr (UseRealloc) {
+        const std::size_t bytes = Skew + newCount * sizeof(Data);
+        void* block = (buffer == nullptr) ? nullptr : reinterpret_cast<unsigned char*>(buffer) - Skew;
+        block = std::realloc(block, bytes);
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+        Data* newBuffer = reinterpret_cast<Data*>(static_cast<unsigned char*>(block) + Skew);
+        // realloc only keeps the alignment of malloc: a block it moved off a
+        // line boundary is copied once more, or kept as it is if that fails
+        if (reinterpret_cast<std::uintptr_t>(block) % LineBytes != 0) {
+            void* aligned = std::aligned_alloc(LineBytes, (bytes + LineBytes - 1) / LineBytes * LineBytes);
+            if (aligned != nullptr) {
+                std::memcpy(static_cast<unsigned char*>(aligned) + Skew, newBuffer, std::min(live, newCount) * sizeof(Data));
+                std::free(block);
+                newBuffer = reinterpret_cast<Data*>(static_cast<unsigned char*>(aligned) + Skew);
+            }
+        }
+        return newBuffer;
+    } else {
+        Data* newBuffer = AllocateElements(newCount);
+        unsigned long index = 0;
+        try {
+            for (; index < live; ++index) {
+                std::construct_at(newBuffer + index, std::move_if_noexcept(buffer[index]));
+            }
+        } catch (...) {
+            ReleaseElements(newBuffer, index);
+            throw;
+        }
+        ReleaseElements(buffer, live);
+        return newBuffer;
+    }
+}
+
+template<typename Data>
+void Vector<Data>::ReleaseElements(Data* buffer, const unsigned long live) noexcept {
+    if (buffer == nullptr) {
+        return;
+    }
+    std::destroy_n(buffer, live);
+    void* block = reinterpret_cast<unsigned char*>(buffer) - Skew;
+    if constexpr (UseRealloc) {
+        std::free(block);
+    } else {
+        ::operator delete(block, std::align_val_t(LineBytes));
+    }
+}
+
+template<typename Data>
+void Vector<Data>::Adopt(Vector<Data>& vector, Data* buffer, const unsigned long count) noexcept {
+    ReleaseElements(vector.elements, vector.size);
+    vector.elements = buffer;
+    vector.size = count;
+}
+
 /* ************************************************************************** */
 /* VECTOR - SPECIFIC CONSTRUCTORS                                              */
 /* ************************************************************************** */
 
 template<typename Data>
 Vector<Data>::Vector(const unsigned long newsize) {
-    size = newsize;
-    if (size > 0) {
-        elements = new Data[size]{};
-    } else {
+    elements = AllocateElements(newsize);
+    try {
+        std::uninitialized_value_construct_n(elements, newsize);
+    } catch (...) {
+        ReleaseElements(elements, 0);
         elements = nullptr;
+        throw;
     }
+    size = newsize;
 }
 
 template<typename Data>
-Vector<Data>::Vector(const TraversableContainer<Data>& container)
-  : Vector(container.Size()) {
+Vector<Data>::Vector(const TraversableContainer<Data>& container) {
+    elements = AllocateElements(container.Size());
     try {
-        unsigned long index = 0;
         container.Traverse(
-            [this, &index](const Data& dat) {
-                elements[index++] = dat;
+            [this](const Data& dat) {
+                std::construct_at(elements + size, dat);
+                ++size;
             }
         );
     } catch (...) {
-        delete[] elements;
+        ReleaseElements(elements, size);
         elements = nullptr;
         size = 0;
         throw;
@@ -33,17 +131,17 @@ Vector<Data>::Vector(const TraversableContainer<Data>& container)
 }
 
 template<typename Data>
-Vector<Data>::Vector(MappableContainer<Data>&& container)
-  : Vector(container.Size()) {
+Vector<Data>::Vector(MappableContainer<Data>&& container) {
+    elements = AllocateElements(container.Size());
     try {
-        unsigned long index = 0;
         container.Map(
-            [this, &index](Data& dat) {
-                elements[index++] = std::move(dat);
+            [this](Data& dat) {
+                std::construct_at(elements + size, std::move(dat));
+                ++size;
             }
         );
     } catch (...) {
-        delete[] elements;
+        ReleaseElements(elements, size);
         elements = nullptr;
         size = 0;
         throw;
@@ -56,16 +154,16 @@ Vector<Data>::Vector(MappableContainer<Data>&& container)
 
 // Copy constructor
 template<typename Data>
-Vector<Data>::Vector(const Vector<Data>& vector)
-  : Vector(vector.size) {
+Vector<Data>::Vector(const Vector<Data>& vector) {
+    elements = AllocateElements(vector.size);
     try {
-        std::uninitialized_copy(vector.elements, vector.elements + size, elements);
+        std::uninitialized_copy_n(vector.elements, vector.size, elements);
     } catch (...) {
-        delete[] elements;
+        ReleaseElements(elements, 0);
         elements = nullptr;
-        size = 0;
         throw;
     }
+    size = vector.size;
 }
 
 // Move constructor
@@ -81,7 +179,7 @@ Vector<Data>::Vector(Vector<Data>&& vector) noexcept {
 
 template<typename Data>
 Vector<Data>::~Vector() {
-    delete[] elements;
+    ReleaseElements(elements, size);
 }
 
 /* ************************************************************************** */
@@ -185,22 +283,18 @@ void Vector<Data>::Resize(unsigned long newSize) {
             Clear();
             return;
         }
-        
-        Data* newElements = new Data[newSize]{};
-        unsigned long minSize = (newSize < size) ? newSize : size;
-        
-        try {
-            for (unsigned long i = 0; i < minSize; ++i) {
-                newElements[i] = std::move_if_noexcept(elements[i]);
-            }
-        } catch (...) {
-            delete[] newElements;
-            throw;
+
+        if (newSize < size) {
+            std::destroy(elements + newSize, elements + size);
+            size = newSize;
+            elements = ReallocateElements(elements, size, newSize);
+        } else if constexpr (std::is_default_constructible_v<Data>) {
+            elements = ReallocateElements(elements, size, newSize);
+            std::uninitialized_value_construct_n(elements + size, newSize - size);
+            size = newSize;
+        } else {
+            throw std::logic_error("Growing a vector of values that are not default constructible.");
         }
-        
-        delete[] elements;
-        elements = newElements;
-        size = newSize;
     }
 }
 
@@ -210,7 +304,7 @@ void Vector<Data>::Resize(unsigned long newSize) {
 
 template<typename Data>
 void Vector<Data>::Clear() {
-    delete[] elements;
+    ReleaseElements(elements, size);
     elements = nullptr;
     size = 0;
 }
@@ -233,4 +327,177 @@ SortableVector<Data>& SortableVector<Data>::operator=(SortableVector<Data>&& vec
     return *this;
 }
 
+/* ************************************************************************** */
+/* SORTABLE VECTOR - SPECIFIC MEMBER FUNCTIONS                                 */
+/* ************************************************************************** */
+
+// Selecting the k-th smallest leaves the k smallest in front: only they are sorted
+template<typename Data>
+void SortableVector<Data>::PartialSort(unsigned long count) {
+    if (count > size) {
+        throw std::out_of_range("Partial sort of " + std::to_string(count) + " values; vector size " + std::to_string(size) + ".");
+    }
+    if (count == 0) {
+        return;
+    }
+    try {
+        SelectRange(this->elements, this->elements + count - 1, this->elements + size);
+        SortRange(this->elements, this->elements + count - 1, 2 * std::bit_width(count));
+    } catch (...) {
+        this->ValuesChanged();
+        throw;
+    }
+    this->ValuesChanged();
+}
+
+template<typename Data>
+void SortableVector<Data>::NthElement(unsigned long index) {
+    if (index >= size) {
+        throw std::out_of_range("Selection at index " + std::to_string(index) + "; vector size " + std::to_string(size) + ".");
+    }
+    try {
+        SelectRange(this->elements, this->elements + index, this->elements + size);
+    } catch (...) {
+        this->ValuesChanged();
+        throw;
+    }
+    this->ValuesChanged();
+}
+
+/* ************************************************************************** */
+/* SORTABLE VECTOR - RANGE ALGORITHMS                                          */
+/* ************************************************************************** */
+
+template<typename Data>
+void SortableVector<Data>::SelectRange(Data* first, Data* nth, Data* last) {
+    unsigned long depth = 2 * std::bit_width(static_cast<unsigned long>(last - first));
+    while (last - first > Cutoff) {
+        if (depth == 0) {
+            HeapSelectRange(first, nth + 1, last);
+            std::swap(*first, *nth);
+            return;
+        }
+        --depth;
+        Data* cut = PartitionRange(first, last);
+        if (cut <= nth) {
+            first = cut;
+        } else {
+            last = cut;
+        }
+    }
+    InsertionSortRange(first, last);
+}
+
+template<typename Data>
+void SortableVector<Data>::SortRange(Data* first, Data* last, unsigned long depth) {
+    while (last - first > Cutoff) {
+        if (depth == 0) {
+            HeapSortRange(first, last);
+            return;
+        }
+        --depth;
+        Data* cut = PartitionRange(first, last);
+        SortRange(cut, last, depth);
+        last = cut;
+    }
+    InsertionSortRange(first, last);
+}
+
+// The median of the second, middle and last values becomes the pivot at the
+// front; the other two stop both scans, which therefore need no bound checks
+template<typename Data>
+Data* SortableVector<Data>::PartitionRange(Data* first, Data* last) {
+    Data* a = first + 1;
+    Data* b = first + (last - first) / 2;
+    Data* c = last - 1;
+    Data* median;
+    if (*a < *b) {
+        median = (*b < *c) ? b : ((*a < *c) ? c : a);
+    } else {
+        median = (*a < *c) ? a : ((*b < *c) ? c : b);
+    }
+    std::swap(*first, *median);
+
+    Data* low = first + 1;
+    Data* high = last;
+    while (true) {
+        while (*low < *first) {
+            ++low;
+        }
+        --high;
+        while (*first < *high) {
+            --high;
+        }
+        if (!(low < high)) {
+            return low;
+        }
+        std::swap(*low, *high);
+        ++low;
+    }
+}
+
+template<typename Data>
+void SortableVector<Data>::InsertionSortRange(Data* first, Data* last) {
+    if (last - first < 2) {
+        return;
+    }
+    for (Data* next = first + 1; next < last; ++next) {
+        Data value = std::move(*next);
+        Data* hole = next;
+        while (hole > first && value < *(hole - 1)) {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        }
+        *hole = std::move(value);
+    }
+}
+
+template<typename Data>
+void SortableVector<Data>::HeapifyRange(Data* first, unsigned long length) {
+    for (unsigned long index = length / 2; index-- > 0; ) {
+        Data value = std::move(first[index]);
+        SiftRange(first, index, length, value);
+    }
+}
+
+template<typename Data>
+void SortableVector<Data>::SiftRange(Data* first, unsigned long hole, unsigned long length, Data& value) {
+    while (2 * hole + 1 < length) {
+        unsigned long child = 2 * hole + 1;
+        if (child + 1 < length && first[child] < first[child + 1]) {
+            ++child;
+        }
+        if (!(value < first[child])) {
+            break;
+        }
+        first[hole] = std::move(first[child]);
+        hole = child;
+    }
+    first[hole] = std::move(value);
+}
+
+template<typename Data>
+void SortableVector<Data>::HeapSortRange(Data* first, Data* last) {
+    unsigned long length = last - first;
+    HeapifyRange(first, length);
+    for (unsigned long end = length; end-- > 1; ) {
+        Data value = std::move(first[end]);
+        first[end] = std::move(first[0]);
+        SiftRange(first, 0, end, value);
+    }
+}
+
+template<typename Data>
+void SortableVector<Data>::HeapSelectRange(Data* first, Data* middle, Data* last) {
+    unsigned long length = middle - first;
+    HeapifyRange(first, length);
+    for (Data* next = middle; next < last; ++next) {
+        if (*next < *first) {
+            Data value = std::move(*next);
+            *next = std::move(*first);
+            SiftRange(first, 0, length, value);
+        }
+    }
+}
+
 }
\ No newline at end of file
@@ -2,12 +2,25 @@
 #define VECTOR_HPP
 
 #include "../container/linear.hpp"
+#include <cstddef>
 #include <stdexcept>
+#include <type_traits>
 
 /* ************************************************************************** */
 
 namespace lasd {
 
+/* ************************************************************************** */
+
+// Types whose objects may be moved to another address with memmove, leaving
+// the source bytes to be reused as raw storage. Containers use it to shift and
+// grow their buffers with memmove/realloc instead of element-wise moves.
+// Specialise it to std::true_type for other types with the same guarantee.
+template <typename Data>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<Data>> {};
+
+/* ************************************************************************** */
+
 template <typename Data>
 class Vector : virtual public MutableLinearContainer<Data>, 
                virtual public ResizableContainer {
@@ -82,7 +95,7 @@ public:
 
   // Specific member function (inherited from ResizableContainer)
 
-  inline void Resize(const unsigned long newSize) override; // Override ResizableContainer member
+  inline void Resize(const unsigned long newSize) override; // Override ResizableContainer member (growing must throw std::logic_error when Data is not default constructible)
 
   /* ************************************************************************ */
 
@@ -90,8 +103,36 @@ public:
 
   inline void Clear()override; // Override ClearableContainer member
 
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  // Called after the values were rearranged or changed in place, in bulk and
+  // not through the mutable accessors (PartialSort, NthElement, ParallelMap):
+  // a subclass keeping an order on its values updates what it knows of it
+  inline virtual void ValuesChanged() {}
+
 protected:
 
+  // Buffers of relocatable, trivially destructible types live in malloc'd
+  // memory, so that they can be grown in place by realloc.
+  static constexpr bool UseRealloc = IsTriviallyRelocatable<Data>::value
+                                     && std::is_trivially_destructible_v<Data>
+                                     && alignof(Data) <= alignof(std::max_align_t);
+
+  // Buffers are placed so that slot 1 starts a cache line: the sibling
+  // groups of an implicit heap (from Arity * i + 1) then never straddle two
+  // lines when they fit in one. Skew bytes of the block come before slot 0.
+  static constexpr std::size_t LineBytes = (alignof(Data) > 64) ? alignof(Data) : 64;
+  static constexpr std::size_t Skew = (LineBytes - sizeof(Data) % LineBytes) % LineBytes;
+
+  // Buffers are raw storage: only the first size slots hold constructed
+  // values, so neither default construction nor copies are ever required.
+  static Data * AllocateElements(unsigned long); // Uninitialised storage for the given number of values
+  static Data * ReallocateElements(Data *, unsigned long, unsigned long); // Relocates the live prefix (at most the new count)
+  static void ReleaseElements(Data *, unsigned long) noexcept; // Destroys the live prefix, then frees the buffer
+  static void Adopt(Vector<Data> &, Data *, unsigned long) noexcept; // Hands a buffer of live values over to a vector
+
 };
 
 /* ************************************************************************** */
@@ -138,8 +179,35 @@ public:
   // Move assignment
   inline SortableVector<Data> &operator=(SortableVector<Data> &&) noexcept;
 
+  /* ************************************************************************ */
+
+  // Specific member functions
+
+  // Puts the k smallest values, in ascending order, in the first k positions;
+  // the others follow in no particular order (must throw std::out_of_range when k exceeds the size)
+  void PartialSort(unsigned long);
+
+  // Puts at the given position the value a full sort would put there, with no
+  // greater value before it and no smaller one after it; expected linear time
+  // (must throw std::out_of_range when out of range)
+  void NthElement(unsigned long);
+
 protected:
 
+  // Range algorithms on [first, last), ordered by operator<
+
+  static constexpr long Cutoff = 16; // Ranges up to this length are finished by insertion sort
+
+  static void SelectRange(Data *, Data *, Data *); // Introselect: quickselect, heap selection when partitions keep coming out lopsided
+  static void SortRange(Data *, Data *, unsigned long); // Introsort with the given depth budget
+  static Data * PartitionRange(Data *, Data *); // Median-of-three pivot; no value of the left part exceeds one of the right part
+  static void InsertionSortRange(Data *, Data *);
+
+  static void HeapifyRange(Data *, unsigned long); // Max-heap of the given length
+  static void SiftRange(Data *, unsigned long, unsigned long, Data &); // Places the value from the given hole down
+  static void HeapSortRange(Data *, Data *);
+  static void HeapSelectRange(Data *, Data *, Data *); // The smallest middle - first values to the front, their maximum first
+
 };
 
 /* ************************************************************************** */
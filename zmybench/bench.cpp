@@ -0,0 +1,1220 @@
+#include "bench.hpp"
+
+#include "../vector/vector.hpp"
+#include "../set/vec/setvec.hpp"
+#include "../set/lst/setlst.hpp"
+#include "../hash/set/sethash.hpp"
+#include "../pq/heap/pqheap.hpp"
+#include "../pq/indexed/indexedpqheap.hpp"
+#include "../pq/radix/pqradix.hpp"
+#include "../pq/concurrent/concurrentpq.hpp"
+#include "../pq/pairing/pqpairing.hpp"
+#include "../heap/topk/topk.hpp"
+#include "../pq/minmax/pqminmax.hpp"
+#include "../pq/timerwheel/pqtimerwheel.hpp"
+#include "../pq/external/pqexternal.hpp"
+#include "../parallel/threadpool.hpp"
+#include "../parallel/parallelvector.hpp"
+#include "../container/static.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+using namespace lasd;
+
+/* ************************************************************************** */
+
+// SetHash against SetVec and std::unordered_set: insert, hit/miss lookups, remove
+void benchSetHash() {
+  BenchHeader("SetHash vs SetVec vs std::unordered_set (int)");
+
+  for (ulong n : {10000UL, 100000UL, 1000000UL}) {
+    BenchRandom rnd;
+    std::vector<int> keys(n);
+    for (auto & key : keys) {
+      key = static_cast<int>(rnd.Next() >> 33);
+    }
+
+    {
+      SetHash<int> set;
+      Stopwatch watch;
+      for (int key : keys) set.Insert(key);
+      BenchRow("SetHash Insert", n, watch.Millis());
+      watch.Restart();
+      ulong hits = 0;
+      for (int key : keys) hits += set.Exists(key);
+      for (int key : keys) hits += set.Exists(key ^ 0x40000000);
+      Consume(hits);
+      BenchRow("SetHash Exists (50% hit)", 2 * n, watch.Millis());
+      watch.Restart();
+      for (int key : keys) set.Remove(key);
+      BenchRow("SetHash Remove", n, watch.Millis());
+    }
+
+    {
+      std::unordered_set<int> set;
+      Stopwatch watch;
+      for (int key : keys) set.insert(key);
+      BenchRow("unordered_set insert", n, watch.Millis());
+      watch.Restart();
+      ulong hits = 0;
+      for (int key : keys) hits += set.count(key);
+      for (int key : keys) hits += set.count(key ^ 0x40000000);
+      Consume(hits);
+      BenchRow("unordered_set count (50% hit)", 2 * n, watch.Millis());
+      watch.Restart();
+      for (int key : keys) set.erase(key);
+      BenchRow("unordered_set erase", n, watch.Millis());
+    }
+
+    if (n <= 10000) { // SetVec Insert and Exists are O(n) per value
+      SetVec<int> set;
+      Stopwatch watch;
+      for (int key : keys) set.Insert(key);
+      BenchRow("SetVec Insert", n, watch.Millis());
+      watch.Restart();
+      ulong hits = 0;
+      for (int key : keys) hits += set.Exists(key);
+      for (int key : keys) hits += set.Exists(key ^ 0x40000000);
+      Consume(hits);
+      BenchRow("SetVec Exists (50% hit)", 2 * n, watch.Millis());
+      watch.Restart();
+      for (int key : keys) set.Remove(key);
+      BenchRow("SetVec Remove", n, watch.Millis());
+    }
+  }
+}
+
+// Scanning/removing [lo, hi) covering 10% of the set: range calls against Successor loops
+template <typename SetType>
+void benchSetRangeOn(const string & name, ulong n) {
+  SetType set;
+  for (ulong i = 0; i < n; ++i) {
+    set.Insert(static_cast<int>(2 * i));
+  }
+  int lo = static_cast<int>(n / 2), hi = static_cast<int>(n / 2 + n / 5);
+
+  Stopwatch watch;
+  long sum = 0;
+  set.TraverseRange(lo, hi, [&sum](const int & x) { sum += x; });
+  Consume(sum);
+  BenchRow(name + " TraverseRange (10%)", n / 10, watch.Millis());
+
+  watch.Restart();
+  sum = 0;
+  for (int x = set.Successor(lo - 1); x < hi; x = set.Successor(x)) {
+    sum += x;
+  }
+  Consume(sum);
+  BenchRow(name + " Successor loop (10%)", n / 10, watch.Millis());
+
+  watch.Restart();
+  ulong count = set.CountRange(lo, hi);
+  Consume(count);
+  BenchRow(name + " CountRange (10%)", n / 10, watch.Millis());
+
+  SetType copy(set);
+  watch.Restart();
+  count = set.RemoveRange(lo, hi);
+  Consume(count);
+  BenchRow(name + " RemoveRange (10%)", n / 10, watch.Millis());
+
+  watch.Restart();
+  for (int x = lo; x < hi; x += 2) {
+    copy.Remove(x);
+  }
+  BenchRow(name + " Remove loop (10%)", n / 10, watch.Millis());
+}
+
+void benchSetRange() {
+  BenchHeader("Set range queries vs point operations");
+  benchSetRangeOn<SetVec<int>>("SetVec", 20000);
+  benchSetRangeOn<SetLst<int>>("SetLst", 20000);
+}
+
+// Percentile dashboard: p1..p99 by Select, each after an update, and by a
+// linear operator[] walk, then Rank lookups
+template <typename SetType>
+void benchSetPercentilesOn(const string & name, ulong n) {
+  SetType set;
+  for (ulong i = 0; i < n; ++i) {
+    set.Insert(static_cast<int>(3 * i));
+  }
+
+  Stopwatch watch;
+  long sum = 0;
+  for (ulong p = 1; p < 100; ++p) {
+    set.Insert(static_cast<int>(3 * (n * p / 100) + 1));
+    sum += set.Select(n * p / 100);
+    set.Remove(static_cast<int>(3 * (n * p / 100) + 1));
+  }
+  Consume(sum);
+  BenchRow(name + " Insert + Select + Remove p1..p99", 99, watch.Millis());
+
+  watch.Restart();
+  for (ulong p = 1; p < 100; ++p) {
+    sum += set.Select(n * p / 100);
+  }
+  Consume(sum);
+  BenchRow(name + " Select p1..p99", 99, watch.Millis());
+
+  watch.Restart();
+  for (ulong p = 1; p < 100; ++p) {
+    sum += set[n * p / 100];
+  }
+  Consume(sum);
+  BenchRow(name + " operator[] p1..p99", 99, watch.Millis());
+
+  BenchRandom rnd;
+  watch.Restart();
+  ulong ranks = 0;
+  for (ulong i = 0; i < 10000; ++i) {
+    ranks += set.Rank(static_cast<int>(rnd.Next() % (3 * n)));
+  }
+  Consume(ranks);
+  BenchRow(name + " Rank (random)", 10000, watch.Millis());
+}
+
+void benchSetPercentiles() {
+  BenchHeader("Set percentiles: Rank/Select");
+  benchSetPercentilesOn<SetVec<int>>("SetVec", 50000);
+  benchSetPercentilesOn<SetLst<int>>("SetLst", 20000);
+}
+
+// int with a user-provided copy constructor: same layout, but not trivially
+// copyable, so containers take their element-wise paths
+struct PlainInt {
+  int value = 0;
+  PlainInt() = default;
+  PlainInt(int v) : value(v) {}
+  PlainInt(const PlainInt & other) : value(other.value) {}
+  PlainInt & operator=(const PlainInt & other) { value = other.value; return *this; }
+  bool operator<(const PlainInt & other) const { return value < other.value; }
+  bool operator>(const PlainInt & other) const { return value > other.value; }
+  bool operator==(const PlainInt & other) const { return value == other.value; }
+  bool operator!=(const PlainInt & other) const { return value != other.value; }
+};
+
+// Middle inserts/removes on a 10^6-element SetVec (each shifts ~n/2 slots), and Vector growth by one
+template <typename Data>
+void benchShiftOn(const string & name, ulong n, ulong ops) {
+  SetVec<Data> set;
+  for (ulong i = 0; i < n; ++i) {
+    set.Insert(Data(static_cast<int>(2 * i)));
+  }
+  BenchRandom rnd;
+  Stopwatch watch;
+  for (ulong i = 0; i < ops; ++i) {
+    int odd = static_cast<int>(2 * (n / 4 + rnd.Next() % (n / 2)) + 1);
+    set.Insert(Data(odd));
+    set.Remove(Data(odd));
+  }
+  double millis = watch.Millis();
+  BenchRow("SetVec<" + name + "> middle Insert+Remove", 2 * ops, millis);
+  cout << "    shift throughput: " << std::setprecision(2) << (2.0 * ops * (n / 2) * sizeof(Data) / (millis * 1e6)) << " GB/s" << endl;
+
+  Vector<Data> vec;
+  watch.Restart();
+  for (ulong i = 0; i < 20000; ++i) {
+    vec.Resize(i + 1);
+  }
+  BenchRow("Vector<" + name + "> Resize(+1) x 20000", 20000, watch.Millis());
+}
+
+void benchRelocation() {
+  BenchHeader("Trivially relocatable fast paths (memmove/realloc)");
+  benchShiftOn<int>("int", 1000000, 200);
+  benchShiftOn<PlainInt>("PlainInt", 1000000, 200);
+}
+
+// n random pushes into an empty queue, then n pops
+template <ulong Arity>
+void benchPQArityOn(const std::vector<int> & keys) {
+  PQHeap<int, Arity> pq;
+  Stopwatch watch;
+  for (int key : keys) pq.Insert(key);
+  BenchRow("PQHeap<int, " + to_string(Arity) + "> Insert", keys.size(), watch.Millis());
+  watch.Restart();
+  long sum = 0;
+  while (pq.Size() > 0) sum += pq.TipNRemove();
+  Consume(sum);
+  BenchRow("PQHeap<int, " + to_string(Arity) + "> TipNRemove", keys.size(), watch.Millis());
+}
+
+void benchPQArity() {
+  BenchHeader("d-ary PQHeap push/pop throughput");
+  for (ulong n = 10000; n <= BenchLargestN(); n *= 10) {
+    BenchRandom rnd;
+    std::vector<int> keys(n);
+    for (auto & key : keys) {
+      key = static_cast<int>(rnd.Next() >> 33);
+    }
+    benchPQArityOn<2>(keys);
+    benchPQArityOn<4>(keys);
+    benchPQArityOn<8>(keys);
+
+    std::priority_queue<int> reference;
+    Stopwatch watch;
+    for (int key : keys) reference.push(key);
+    BenchRow("std::priority_queue<int> push", n, watch.Millis());
+    watch.Restart();
+    long sum = 0;
+    while (!reference.empty()) { sum += reference.top(); reference.pop(); }
+    Consume(sum);
+    BenchRow("std::priority_queue<int> pop", n, watch.Millis());
+  }
+}
+
+// The pre-comparator way to get a min-queue: a wrapper with inverted operators
+struct InvertedInt {
+  int value = 0;
+  InvertedInt() = default;
+  InvertedInt(int v) : value(v) {}
+  bool operator<(const InvertedInt & other) const { return value > other.value; }
+  bool operator>(const InvertedInt & other) const { return value < other.value; }
+  bool operator==(const InvertedInt & other) const { return value == other.value; }
+  bool operator!=(const InvertedInt & other) const { return value != other.value; }
+};
+
+template <typename PQType>
+void benchMinPQOn(const string & name, const std::vector<int> & keys) {
+  PQType pq;
+  Stopwatch watch;
+  for (int key : keys) pq.Insert(key);
+  long sum = 0;
+  while (pq.Size() > 0) sum += static_cast<int>(pq.TipNRemove() == 0);
+  Consume(sum);
+  BenchRow(name + " Insert+TipNRemove", 2 * keys.size(), watch.Millis());
+}
+
+void benchComparator() {
+  BenchHeader("Min-priority queue: comparator policy vs inverted wrapper");
+  BenchRandom rnd;
+  std::vector<int> keys(1000000);
+  for (auto & key : keys) {
+    key = static_cast<int>(rnd.Next() >> 33);
+  }
+  benchMinPQOn<PQHeap<int, 2, std::greater<int>>>("PQHeap<int, 2, greater>", keys);
+  benchMinPQOn<PQHeap<InvertedInt>>("PQHeap<InvertedInt>", keys);
+  cout << "    sizeof PQHeap<int> = " << sizeof(PQHeap<int>)
+       << ", PQHeap<int, 2, greater> = " << sizeof(PQHeap<int, 2, std::greater<int>>) << endl;
+}
+
+// Random directed graph in CSR form: edges of u are target/weight[first[u] .. first[u + 1])
+struct BenchGraph {
+  ulong n = 0;
+  std::vector<ulong> first, target, weight;
+
+  BenchGraph(ulong vertices, ulong degree, ulong maxWeight) : n(vertices), first(vertices + 1) {
+    BenchRandom rnd;
+    for (ulong u = 0; u < n; ++u) {
+      first[u] = target.size();
+      for (ulong e = 0; e < degree; ++e) {
+        target.push_back(rnd.Next() % n);
+        weight.push_back(1 + rnd.Next() % maxWeight);
+      }
+    }
+    first[n] = target.size();
+  }
+};
+
+// Trivially copyable queue entry, so PQHeap grows by realloc (std::pair is not)
+struct DistVertex {
+  ulong dist, vertex;
+  bool operator<(const DistVertex & other) const { return dist < other.dist; }
+  bool operator>(const DistVertex & other) const { return dist > other.dist; }
+  bool operator==(const DistVertex & other) const { return dist == other.dist && vertex == other.vertex; }
+  bool operator!=(const DistVertex & other) const { return !(*this == other); }
+};
+
+struct DistOf {
+  ulong operator()(const DistVertex & item) const { return item.dist; }
+};
+
+void benchDijkstraOn(const BenchGraph & graph) {
+  const ulong infinity = static_cast<ulong>(-1);
+  ulong n = graph.n;
+
+  std::vector<ulong> dist(n, infinity), vertex(n); // Vertex of every handle slot
+  IndexedPQHeap<ulong, std::greater<ulong>> queue;
+  std::vector<IndexedPQHeap<ulong, std::greater<ulong>>::Handle> handle(n);
+  ulong peak = 0, pops = 0;
+  Stopwatch watch;
+  dist[0] = 0;
+  handle[0] = queue.Insert(0);
+  vertex[handle[0].index] = 0;
+  while (!queue.Empty()) {
+    peak = std::max(peak, queue.Size());
+    ulong u = vertex[queue.TipHandle().index];
+    queue.RemoveTip();
+    ++pops;
+    for (ulong e = graph.first[u]; e < graph.first[u + 1]; ++e) {
+      ulong v = graph.target[e], d = dist[u] + graph.weight[e];
+      if (d < dist[v]) {
+        dist[v] = d;
+        if (queue.Contains(handle[v])) {
+          queue.Update(handle[v], d);
+        } else {
+          handle[v] = queue.Insert(d);
+          vertex[handle[v].index] = v;
+        }
+      }
+    }
+  }
+  BenchRow("IndexedPQHeap (Update) Dijkstra", n, watch.Millis());
+  cout << "    peak queue size " << peak << ", pops " << pops << endl;
+  Consume(dist[n - 1]);
+
+  std::vector<ulong> lazyDist(n, infinity);
+  PQHeap<DistVertex, 2, std::greater<DistVertex>> lazy;
+  peak = pops = 0;
+  watch.Restart();
+  lazyDist[0] = 0;
+  lazy.Insert({0, 0});
+  while (!lazy.Empty()) {
+    peak = std::max(peak, lazy.Size());
+    auto [d, u] = lazy.TipNRemove();
+    ++pops;
+    if (d != lazyDist[u]) {
+      continue;
+    }
+    for (ulong e = graph.first[u]; e < graph.first[u + 1]; ++e) {
+      ulong v = graph.target[e], dv = d + graph.weight[e];
+      if (dv < lazyDist[v]) {
+        lazyDist[v] = dv;
+        lazy.Insert({dv, v});
+      }
+    }
+  }
+  BenchRow("PQHeap (duplicate insert) Dijkstra", n, watch.Millis());
+  cout << "    peak queue size " << peak << ", pops " << pops
+       << (lazyDist == dist ? "" : "  [distances differ!]") << endl;
+}
+
+void benchDijkstra() {
+  BenchHeader("Dijkstra: decrease-key vs duplicate inserts (degree 8)");
+  for (ulong n : {100000UL, 1000000UL}) {
+    benchDijkstraOn(BenchGraph(n, 8, 1000000));
+  }
+}
+
+// Event-loop ticks on a queue holding `resident` values: push a batch, then drain as many
+void benchBatchOn(ulong resident, ulong batch, ulong ticks) {
+  BenchRandom rnd;
+  Vector<int> keys(batch);
+  PQHeap<int> single, batched;
+  for (ulong i = 0; i < resident; ++i) {
+    int key = static_cast<int>(rnd.Next() >> 33);
+    single.Insert(key);
+    batched.Insert(key);
+  }
+  string shape = " (" + to_string(resident) + " + " + to_string(batch) + ")";
+
+  double insertMillis = 0, popMillis = 0, batchMillis = 0, popKMillis = 0;
+  long sum = 0;
+  for (ulong tick = 0; tick < ticks; ++tick) {
+    for (ulong i = 0; i < batch; ++i) {
+      keys[i] = static_cast<int>(rnd.Next() >> 33);
+    }
+    Stopwatch watch;
+    for (ulong i = 0; i < batch; ++i) single.Insert(keys[i]);
+    insertMillis += watch.Millis();
+    watch.Restart();
+    for (ulong i = 0; i < batch; ++i) sum += single.TipNRemove();
+    popMillis += watch.Millis();
+
+    watch.Restart();
+    batched.InsertBatch(keys);
+    batchMillis += watch.Millis();
+    watch.Restart();
+    Vector<int> top = batched.TipNRemoveK(batch);
+    sum += top[0];
+    popKMillis += watch.Millis();
+  }
+  Consume(sum);
+  BenchRow("Insert loop" + shape, batch * ticks, insertMillis);
+  BenchRow("InsertBatch" + shape, batch * ticks, batchMillis);
+  BenchRow("TipNRemove loop" + shape, batch * ticks, popMillis);
+  BenchRow("TipNRemoveK" + shape, batch * ticks, popKMillis);
+}
+
+void benchBatch() {
+  BenchHeader("Batched PQ insertion and removal per tick");
+  benchBatchOn(100000, 1000, 200);
+  benchBatchOn(10000, 100000, 20);
+}
+
+// Textbook heapsort with swap-based sifting (HeapVec::Sort before hole sifting)
+template <typename Value>
+void benchSwapSiftDown(std::vector<Value> & values, ulong index, ulong size) {
+  while (2 * index + 1 < size) {
+    ulong child = 2 * index + 1;
+    if (child + 1 < size && values[child] < values[child + 1]) ++child;
+    if (!(values[index] < values[child])) return;
+    std::swap(values[index], values[child]);
+    index = child;
+  }
+}
+
+template <typename Value>
+void benchSwapHeapSort(std::vector<Value> & values) {
+  ulong size = values.size();
+  for (ulong index = size / 2; index-- > 0; ) benchSwapSiftDown(values, index, size);
+  for (ulong end = size; end-- > 1; ) {
+    std::swap(values[0], values[end]);
+    benchSwapSiftDown(values, 0, end);
+  }
+}
+
+template <typename Value>
+void benchHeapSortOn(const string & name, const std::vector<Value> & keys) {
+  std::vector<Value> reference(keys);
+  Stopwatch watch;
+  benchSwapHeapSort(reference);
+  BenchRow(name + " swap heapsort", keys.size(), watch.Millis());
+
+  Vector<Value> input(keys.size());
+  for (ulong i = 0; i < keys.size(); ++i) input[i] = keys[i];
+  HeapVec<Value> heap(std::move(input));
+  watch.Restart();
+  heap.Sort();
+  BenchRow(name + " HeapVec::Sort (bottom-up)", keys.size(), watch.Millis());
+  Consume(heap[0]);
+}
+
+template <typename Value>
+void benchHeapSortCounts(const std::vector<Value> & keys) {
+  using Item = Counted<Value>;
+  ulong n = keys.size();
+  std::vector<Item> reference(keys.begin(), keys.end());
+  Item::Reset();
+  benchSwapHeapSort(reference);
+  cout << "    swap heapsort:  " << setprecision(2) << double(Item::compares) / n << " compares/n, "
+       << double(Item::moves) / n << " moves/n" << endl;
+
+  Vector<Item> input(n);
+  for (ulong i = 0; i < n; ++i) input[i] = keys[i];
+  HeapVec<Item> heap(std::move(input));
+  Item::Reset();
+  heap.Sort();
+  cout << "    HeapVec::Sort:  " << double(Item::compares) / n << " compares/n, "
+       << double(Item::moves) / n << " moves/n" << endl;
+
+  std::vector<Item> pushes(keys.begin(), keys.end());
+  HeapVec<Item> pq;
+  pq.Reserve(n);
+  Item::Reset();
+  for (auto & key : pushes) pq.Insert(std::move(key));
+  while (pq.Size() > 0) Consume(pq.TopNRemove().value);
+  cout << "    HeapVec push+pop: " << double(Item::compares) / n << " compares/n, "
+       << double(Item::moves) / n << " moves/n" << endl;
+}
+
+void benchHeapSort() {
+  BenchHeader("Hole sifting and bottom-up heapsort");
+  for (ulong n = 100000; n <= 1000000; n *= 10) {
+    BenchRandom rnd;
+    std::vector<int> ints(n);
+    std::vector<string> strings(n);
+    for (ulong i = 0; i < n; ++i) {
+      ints[i] = static_cast<int>(rnd.Next() >> 33);
+      strings[i] = to_string(rnd.Next()) + "-with-a-heap-allocated-tail";
+    }
+    benchHeapSortOn("int", ints);
+    benchHeapSortOn("string", strings);
+    benchHeapSortCounts(ints);
+  }
+}
+
+// Lazy Dijkstra (duplicate inserts, stale pops skipped) over any queue of DistVertex-like pops
+template <typename Queue, typename Push, typename Pop>
+std::vector<ulong> benchLazyDijkstra(const string & name, const BenchGraph & graph, Queue & queue, Push push, Pop pop) {
+  const ulong infinity = static_cast<ulong>(-1);
+  std::vector<ulong> dist(graph.n, infinity);
+  ulong pops = 0;
+  Stopwatch watch;
+  dist[0] = 0;
+  push(queue, 0, 0);
+  while (!queue.Empty()) {
+    auto [d, u] = pop(queue);
+    ++pops;
+    if (d != dist[u]) {
+      continue;
+    }
+    for (ulong e = graph.first[u]; e < graph.first[u + 1]; ++e) {
+      ulong v = graph.target[e], dv = d + graph.weight[e];
+      if (dv < dist[v]) {
+        dist[v] = dv;
+        push(queue, dv, v);
+      }
+    }
+  }
+  BenchRow(name, pops, watch.Millis());
+  return dist;
+}
+
+void benchRadixOn(ulong n, ulong maxWeight) {
+  BenchGraph graph(n, 8, maxWeight);
+  cout << "  n=" << n << ", max weight " << maxWeight << endl;
+
+  PQHeap<DistVertex, 2, std::greater<DistVertex>> heap;
+  auto heapDist = benchLazyDijkstra("PQHeap<DistVertex, 2, greater> pops", graph, heap,
+    [](auto & queue, ulong d, ulong v) { queue.Insert(DistVertex{d, v}); },
+    [](auto & queue) { DistVertex top = queue.TipNRemove(); return std::pair<ulong, ulong>(top.dist, top.vertex); });
+
+  PQHeap<DistVertex, 4, std::greater<DistVertex>> wide;
+  auto wideDist = benchLazyDijkstra("PQHeap<DistVertex, 4, greater> pops", graph, wide,
+    [](auto & queue, ulong d, ulong v) { queue.Insert(DistVertex{d, v}); },
+    [](auto & queue) { DistVertex top = queue.TipNRemove(); return std::pair<ulong, ulong>(top.dist, top.vertex); });
+
+  PQRadix<DistVertex, DistOf> radix;
+  auto radixDist = benchLazyDijkstra("PQRadix<DistVertex, DistOf> pops", graph, radix,
+    [](auto & queue, ulong d, ulong v) { queue.Insert(DistVertex{d, v}); },
+    [](auto & queue) { DistVertex top = queue.TipNRemove(); return std::pair<ulong, ulong>(top.dist, top.vertex); });
+
+  if (heapDist != radixDist || wideDist != radixDist) {
+    cout << "    [distances differ!]" << endl;
+  }
+}
+
+void benchRadix() {
+  BenchHeader("Dijkstra (duplicate inserts, degree 8): radix heap vs binary/4-ary heap");
+  for (ulong n : {100000UL, 1000000UL}) {
+    benchRadixOn(n, 100);
+    benchRadixOn(n, 1000000);
+  }
+}
+
+// Every thread alternates Insert and pop of random keys on one shared queue
+template <typename Setup, typename Work>
+void benchThreadsOn(const string & name, ulong threads, ulong ops, Setup setup, Work work) {
+  setup();
+  std::vector<std::thread> workers;
+  Stopwatch watch;
+  for (ulong t = 0; t < threads; ++t) {
+    workers.emplace_back([&work, t, threads, ops]() { work(t, ops / threads); });
+  }
+  for (auto & worker : workers) worker.join();
+  BenchRow(name + " x" + to_string(threads), ops, watch.Millis());
+}
+
+void benchConcurrentPQ() {
+  BenchHeader("Concurrent PQ throughput: MultiQueue vs one mutex around PQHeap");
+  const ulong prefill = 100000, ops = 2000000;
+  ulong most = std::max<ulong>(8, std::thread::hardware_concurrency());
+  cout << "  hardware threads: " << std::thread::hardware_concurrency() << endl;
+  for (ulong threads = 1; threads <= most; threads *= 2) {
+    std::mutex mutex;
+    PQHeap<ulong> locked;
+    benchThreadsOn("mutex + PQHeap<ulong>", threads, ops,
+      [&]() { BenchRandom rnd; for (ulong i = 0; i < prefill; ++i) locked.Insert(rnd.Next()); },
+      [&](ulong t, ulong count) {
+        BenchRandom rnd(t + 1);
+        ulong sum = 0;
+        for (ulong i = 0; i < count; i += 2) {
+          std::lock_guard<std::mutex> guard(mutex);
+          locked.Insert(rnd.Next());
+          sum += locked.TipNRemove();
+        }
+        Consume(sum);
+      });
+
+    ConcurrentPQ<ulong> relaxed(threads);
+    benchThreadsOn("ConcurrentPQ<ulong>", threads, ops,
+      [&]() { BenchRandom rnd; for (ulong i = 0; i < prefill; ++i) relaxed.Insert(rnd.Next()); },
+      [&](ulong t, ulong count) {
+        BenchRandom rnd(t + 1);
+        ulong sum = 0, value = 0;
+        for (ulong i = 0; i < count; i += 2) {
+          relaxed.Insert(rnd.Next());
+          sum += relaxed.TryTipNRemove(value) ? value : 0;
+        }
+        Consume(sum);
+      });
+  }
+}
+
+// `parts` queues of `each` random keys merged into one, then drained
+template <typename Queue, typename Merge>
+void benchMeldOn(const string & name, ulong parts, ulong each, Merge merge) {
+  BenchRandom rnd;
+  std::vector<Queue> queues(parts);
+  for (auto & queue : queues) {
+    for (ulong i = 0; i < each; ++i) queue.Insert(rnd.Next());
+  }
+  Stopwatch watch;
+  for (ulong part = 1; part < parts; ++part) merge(queues[0], queues[part]);
+  BenchRow(name + " merge", parts * each, watch.Millis());
+  watch.Restart();
+  ulong sum = 0;
+  while (!queues[0].Empty()) sum += queues[0].TipNRemove();
+  Consume(sum);
+  BenchRow(name + " drain", parts * each, watch.Millis());
+}
+
+void benchMeld() {
+  BenchHeader("Merging priority queues: insert-all vs Meld");
+  for (ulong parts : {16UL, 1024UL}) {
+    ulong each = 1000000 / parts;
+    cout << "  " << parts << " queues of " << each << endl;
+    benchMeldOn<PQHeap<ulong>>("PQHeap insert-all", parts, each,
+      [](auto & into, auto & from) { while (!from.Empty()) into.Insert(from.TipNRemove()); });
+    benchMeldOn<PQHeap<ulong>>("PQHeap::Meld", parts, each,
+      [](auto & into, auto & from) { into.Meld(std::move(from)); });
+    benchMeldOn<PQPairing<ulong>>("PQPairing::Meld", parts, each,
+      [](auto & into, auto & from) { into.Meld(std::move(from)); });
+  }
+}
+
+void benchTopK() {
+  BenchHeader("Top 1000 of n: full PQHeap vs streaming TopK");
+  const ulong k = 1000;
+  for (ulong n = 1000000; n <= BenchLargestN(); n *= 10) {
+    BenchRandom rnd;
+    Vector<ulong> keys(n);
+    for (ulong i = 0; i < n; ++i) keys[i] = rnd.Next();
+
+    Stopwatch watch;
+    PQHeap<ulong> all(keys);
+    Vector<ulong> fromHeap = all.TipNRemoveK(k);
+    BenchRow("PQHeap of all n + TipNRemoveK", n, watch.Millis());
+
+    watch.Restart();
+    TopK<ulong> top(k);
+    top.OfferAll(keys);
+    Vector<ulong> fromTopK = top.Result();
+    BenchRow("TopK OfferAll + Result", n, watch.Millis());
+
+    const ulong threads = 4;
+    watch.Restart();
+    std::vector<TopK<ulong>> partial(threads, TopK<ulong>(k));
+    std::vector<std::thread> workers;
+    for (ulong t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t]() {
+        for (ulong i = t * n / threads; i < (t + 1) * n / threads; ++i) partial[t].Offer(keys[i]);
+      });
+    }
+    for (auto & worker : workers) worker.join();
+    for (ulong t = 1; t < threads; ++t) partial[0].Merge(std::move(partial[t]));
+    Vector<ulong> fromThreads = partial[0].Result();
+    BenchRow("TopK x4 threads + Merge", n, watch.Millis());
+
+    if (fromHeap != fromTopK || fromTopK != fromThreads) {
+      cout << "    [results differ!]" << endl;
+    }
+  }
+}
+
+void benchSelection() {
+  BenchHeader("Partial sort and selection vs full sort");
+  ulong n = BenchLargestN();
+  BenchRandom rnd;
+  SortableVector<ulong> keys(n);
+  for (ulong i = 0; i < n; ++i) keys[i] = rnd.Next();
+
+  {
+    std::vector<ulong> reference(n);
+    for (ulong i = 0; i < n; ++i) reference[i] = keys[i];
+    Stopwatch watch;
+    std::sort(reference.begin(), reference.end());
+    BenchRow("std::sort (full)", n, watch.Millis());
+    HeapVec<ulong> heap(keys);
+    watch.Restart();
+    heap.Sort();
+    BenchRow("HeapVec::Sort (full)", n, watch.Millis());
+  }
+  for (ulong percent : {1UL, 10UL, 50UL}) {
+    ulong k = n / 100 * percent;
+    string suffix = " k=" + to_string(percent) + "%";
+    SortableVector<ulong> partial(keys);
+    Stopwatch watch;
+    partial.PartialSort(k);
+    BenchRow("SortableVector::PartialSort" + suffix, n, watch.Millis());
+
+    SortableVector<ulong> nth(keys);
+    watch.Restart();
+    nth.NthElement(k);
+    BenchRow("SortableVector::NthElement" + suffix, n, watch.Millis());
+
+    HeapVec<ulong> heap(keys);
+    watch.Restart();
+    heap.SortTopK(k);
+    BenchRow("HeapVec::SortTopK" + suffix, n, watch.Millis());
+    Consume(partial[0] + nth[k] + heap[n - 1]);
+  }
+}
+
+void benchMinMax() {
+  BenchHeader("Double-ended drain of n keys: PQMinMax vs std::multiset (and max-only vs PQHeap)");
+  for (ulong n = 100000; n <= BenchLargestN(); n *= 10) {
+    BenchRandom rnd;
+    Vector<ulong> keys(n);
+    for (ulong i = 0; i < n; ++i) keys[i] = rnd.Next();
+
+    Stopwatch watch;
+    PQMinMax<ulong> minmax(keys);
+    ulong sum = 0;
+    for (ulong i = 0; i < n; ++i) sum += (i & 1) ? minmax.TipMaxNRemove() : minmax.TipMinNRemove();
+    BenchRow("PQMinMax min/max alternating", n, watch.Millis());
+    Consume(sum);
+
+    watch.Restart();
+    std::multiset<ulong> tree;
+    keys.Traverse([&tree](const ulong & key) { tree.insert(key); });
+    ulong check = 0;
+    for (ulong i = 0; i < n; ++i) {
+      auto pos = (i & 1) ? std::prev(tree.end()) : tree.begin();
+      check += *pos;
+      tree.erase(pos);
+    }
+    BenchRow("std::multiset min/max alternating", n, watch.Millis());
+    Consume(check);
+
+    watch.Restart();
+    PQMinMax<ulong> maxOnly(keys);
+    for (ulong i = 0; i < n; ++i) sum += maxOnly.TipNRemove();
+    BenchRow("PQMinMax max only", n, watch.Millis());
+
+    watch.Restart();
+    PQHeap<ulong> heap(keys);
+    for (ulong i = 0; i < n; ++i) check += heap.TipNRemove();
+    BenchRow("PQHeap max only", n, watch.Millis());
+
+    if (sum != check) {
+      cout << "    [results differ!]" << endl;
+    }
+  }
+}
+
+void benchLazyHeap() {
+  BenchHeader("Load n keys one by one, then drain: eager sift-up vs bulk-append mode; heap copies");
+  for (ulong n = 100000; n <= BenchLargestN(); n *= 10) {
+    BenchRandom rnd;
+    Vector<ulong> keys(n);
+    for (ulong i = 0; i < n; ++i) keys[i] = rnd.Next();
+
+    Stopwatch watch;
+    PQHeap<ulong> eager;
+    for (ulong i = 0; i < n; ++i) eager.Insert(keys[i]);
+    BenchRow("PQHeap Insert (sift-up each)", n, watch.Millis());
+
+    watch.Restart();
+    PQHeap<ulong> lazy;
+    lazy.DeferHeapify();
+    for (ulong i = 0; i < n; ++i) lazy.Insert(keys[i]);
+    Consume(lazy.Tip());
+    BenchRow("PQHeap DeferHeapify + Insert + Tip", n, watch.Millis());
+
+    watch.Restart();
+    PQHeap<ulong> copy(lazy);
+    BenchRow("PQHeap copy of a known heap", n, watch.Millis());
+
+    ulong sum = 0, check = 0;
+    watch.Restart();
+    for (ulong i = 0; i < n; ++i) sum += eager.TipNRemove();
+    for (ulong i = 0; i < n; ++i) check += copy.TipNRemove();
+    BenchRow("drain both (2n pops)", n, watch.Millis());
+
+    if (sum != check) {
+      cout << "    [results differ!]" << endl;
+    }
+  }
+}
+
+using BenchTimer = std::pair<ulong, ulong>; // Deadline, id
+
+struct BenchTimerDeadline {
+  ulong operator()(const BenchTimer & timer) const { return timer.first; }
+};
+
+// Timeout trace: one timer per tick with a timeout of 1-65 s (in ms), 90% of
+// them cancelled 50 ticks later (the request completed), the rest firing
+void benchTimerWheel() {
+  BenchHeader("Timeout trace, 90% cancelled: PQTimerWheel vs PQHeap (tombstones / find + Change)");
+  const ulong lag = 50;
+  for (ulong n = 100000; n <= BenchLargestN(); n *= 10) {
+    BenchRandom rnd;
+    std::vector<ulong> timeouts(n);
+    std::vector<char> cancelled(n);
+    for (ulong i = 0; i < n; ++i) {
+      timeouts[i] = 1000 + rnd.Next() % 64000;
+      cancelled[i] = rnd.Next() % 10 != 0;
+    }
+
+    Stopwatch watch;
+    PQTimerWheel<BenchTimer, BenchTimerDeadline> wheel;
+    std::vector<PQTimerWheel<BenchTimer, BenchTimerDeadline>::Handle> handles(n);
+    ulong firedWheel = 0;
+    for (ulong tick = 0; tick < n; ++tick) {
+      handles[tick] = wheel.Schedule(BenchTimer{tick + timeouts[tick], tick});
+      if (tick >= lag && cancelled[tick - lag]) wheel.Cancel(handles[tick - lag]);
+      firedWheel += wheel.Expire(tick, [](BenchTimer &&) {});
+    }
+    BenchRow("PQTimerWheel Schedule/Cancel/Expire", n, watch.Millis());
+
+    // The usual workaround: cancelled ids are skipped when they reach the top
+    watch.Restart();
+    PQHeap<BenchTimer, 2, std::greater<BenchTimer>> lazy;
+    std::vector<char> dead(n);
+    ulong firedLazy = 0;
+    for (ulong tick = 0; tick < n; ++tick) {
+      lazy.Insert(BenchTimer{tick + timeouts[tick], tick});
+      if (tick >= lag && cancelled[tick - lag]) dead[tick - lag] = 1;
+      while (!lazy.Empty() && lazy.Tip().first <= tick) {
+        firedLazy += !dead[lazy.TipNRemove().second];
+      }
+    }
+    BenchRow("PQHeap Insert + tombstones", n, watch.Millis());
+
+    if (n <= 100000) {
+      watch.Restart();
+      PQHeap<BenchTimer, 2, std::greater<BenchTimer>> exact;
+      ulong firedExact = 0;
+      for (ulong tick = 0; tick < n; ++tick) {
+        exact.Insert(BenchTimer{tick + timeouts[tick], tick});
+        if (tick >= lag && cancelled[tick - lag]) {
+          ulong index = 0;
+          while (exact[index].second != tick - lag) ++index;
+          exact.Change(index, BenchTimer{0, tick - lag});
+          exact.RemoveTip();
+        }
+        while (!exact.Empty() && exact.Tip().first <= tick) {
+          exact.RemoveTip();
+          ++firedExact;
+        }
+      }
+      BenchRow("PQHeap Insert + find/Change cancel", n, watch.Millis());
+      if (firedExact != firedWheel) {
+        cout << "    [results differ!]" << endl;
+      }
+    }
+
+    if (firedWheel != firedLazy) {
+      cout << "    [results differ!]" << endl;
+    }
+  }
+}
+
+void benchExternal() {
+  BenchHeader("Insert n keys, then drain: PQExternal (8 MiB budget) vs PQHeap");
+  const ulong budget = 1UL << 23;
+  for (ulong n = 1000000; n <= BenchLargestN(); n *= 10) {
+    BenchRandom rnd;
+    Vector<ulong> keys(n);
+    for (ulong i = 0; i < n; ++i) keys[i] = rnd.Next();
+
+    Stopwatch watch;
+    PQHeap<ulong> heap;
+    for (ulong i = 0; i < n; ++i) heap.Insert(keys[i]);
+    ulong sum = 0;
+    for (ulong i = 0; i < n; ++i) sum += heap.TipNRemove();
+    BenchRow("PQHeap (all in memory)", n, watch.Millis());
+    heap.Clear();
+
+    watch.Restart();
+    PQExternal<ulong> external(budget);
+    for (ulong i = 0; i < n; ++i) external.Insert(keys[i]);
+    ulong runs = external.Runs();
+    ulong check = 0;
+    for (ulong i = 0; i < n; ++i) check += external.TipNRemove();
+    BenchRow("PQExternal, disk runs: " + std::to_string(runs), n, watch.Millis());
+
+    if (sum != check) {
+      cout << "    [results differ!]" << endl;
+    }
+  }
+}
+
+// Hold model (pop, push a new random key) and then pops, on a heap of n keys;
+// returns the sum of the popped keys, which must not depend on the layout
+template <typename Queue>
+ulong benchLayoutRun(const std::string & label, const Vector<ulong> & keys) {
+  Queue queue(keys);
+  ulong ops = std::min<ulong>(keys.Size(), 1000000);
+  BenchRandom rnd;
+  ulong sum = 0;
+  Stopwatch watch;
+  for (ulong i = 0; i < ops; ++i) {
+    sum += queue.TipNRemove();
+    queue.Insert(rnd.Next());
+  }
+  BenchRow(label + " pop + push", ops, watch.Millis());
+  watch.Restart();
+  for (ulong i = 0; i < ops; ++i) sum += queue.TipNRemove();
+  BenchRow(label + " pop", ops, watch.Millis());
+  return sum;
+}
+
+// One heap at a time, so that 10^8 keys (LASD_BENCH_LARGE) fit in memory;
+// run under perf stat -e dTLB-load-misses to compare the TLB misses
+void benchPagedHeap() {
+  BenchHeader("Pop latency on large heaps: implicit layout vs PagedLayout (4 KiB B-heap)");
+  for (ulong n = 1000000; n <= BenchLargestN(); n *= 10) {
+    BenchRandom rnd;
+    Vector<ulong> keys(n);
+    for (ulong i = 0; i < n; ++i) keys[i] = rnd.Next();
+    cout << "  heap of " << n << " keys:" << endl;
+
+    ulong sum = benchLayoutRun<PQHeap<ulong>>("binary, implicit", keys);
+    ulong check = benchLayoutRun<PQHeap<ulong, 2, std::less<ulong>, PagedLayout<>>>("binary, paged", keys);
+    ulong wide = benchLayoutRun<PQHeap<ulong, 4>>("4-ary, implicit", keys);
+    ulong widePaged = benchLayoutRun<PQHeap<ulong, 4, std::less<ulong>, PagedLayout<>>>("4-ary, paged", keys);
+
+    if (sum != check || sum != wide || sum != widePaged) {
+      cout << "    [results differ!]" << endl;
+    }
+  }
+}
+
+// The values are written through operator[], so each ParallelHeapify starts
+// from the same random order and really rebuilds
+void benchParallelBuild() {
+  BenchHeader("BuildHeap of n random keys on 1-8 threads (hardware threads: " + std::to_string(std::thread::hardware_concurrency()) + ")");
+  for (ulong n = 1000000; n <= BenchLargestN(); n *= 10) {
+    BenchRandom rnd;
+    Vector<ulong> keys(n);
+    for (ulong i = 0; i < n; ++i) keys[i] = rnd.Next();
+
+    HeapVec<ulong> heap(keys);
+    HeapVec<ulong> sequential(heap);
+    for (ulong threads = 1; threads <= 8; threads *= 2) {
+      ThreadPool pool(threads - 1);
+      for (ulong i = 0; i < n; ++i) heap[i] = keys[i];
+      Stopwatch watch;
+      heap.ParallelHeapify(pool);
+      BenchRow("ParallelHeapify, " + std::to_string(threads) + " thread(s)", n, watch.Millis());
+      if (threads == 1) {
+        sequential = heap;
+      } else if (heap != sequential) {
+        cout << "    [results differ!]" << endl;
+      }
+    }
+  }
+}
+
+// Per-task cost with empty chunks (grain 1), and a reduction with real
+// work; the caller is one of the threads, so 1 thread has no workers
+void benchThreadPool() {
+  BenchHeader("ThreadPool: ParallelFor spawn/steal overhead and ParallelReduce (hardware threads: " + std::to_string(std::thread::hardware_concurrency()) + ")");
+  const ulong tasks = 1000000;
+  const ulong n = BenchLargestN();
+  Vector<double> values(n);
+  for (ulong i = 0; i < n; ++i) values[i] = 1.0 / static_cast<double>(i + 1);
+  for (ulong threads = 1; threads <= 4; threads *= 2) {
+    ThreadPool pool(threads - 1);
+    std::atomic<ulong> chunks{0};
+    Stopwatch watch;
+    pool.ParallelFor(0, tasks, 1, [&chunks](ulong, ulong) { chunks.fetch_add(1, std::memory_order_relaxed); });
+    BenchRow("ParallelFor grain 1, " + std::to_string(threads) + " thread(s)", tasks, watch.Millis());
+    cout << "    steals: " << pool.Steals() << endl;
+
+    watch.Restart();
+    double sum = pool.ParallelReduce(0, n, 1UL << 16, 0.0, [&values](ulong begin, ulong end) {
+      double partial = 0.0;
+      for (ulong i = begin; i < end; ++i) partial += values[i];
+      return partial;
+    }, [](double a, double b) { return a + b; });
+    BenchRow("ParallelReduce sum, " + std::to_string(threads) + " thread(s)", n, watch.Millis());
+    Consume(sum);
+  }
+  Stopwatch watch;
+  double sum = 0.0;
+  for (ulong i = 0; i < n; ++i) sum += values[i];
+  BenchRow("sequential sum", n, watch.Millis());
+  Consume(sum);
+}
+
+// Map and Fold through the container interface against the parallel
+// versions on pools of 1-4 threads, on the largest n (10^8 with LASD_BENCH_LARGE)
+void benchParallelMap() {
+  BenchHeader("Vector<double>: Map/Fold vs ParallelMap/ParallelFold, chunks of 2^16 (hardware threads: " + std::to_string(std::thread::hardware_concurrency()) + ")");
+  const ulong n = BenchLargestN();
+  const ulong chunk = 1UL << 16;
+  Vector<double> values(n);
+  for (ulong i = 0; i < n; ++i) values[i] = static_cast<double>(i % 1000);
+  auto scale = [](double & value) { value = value * 0.5 + 1.0; };
+  auto add = [](const double & value, const double & sum) { return sum + value; };
+  auto plus = [](const double & a, const double & b) { return a + b; };
+
+  Stopwatch watch;
+  values.Map(scale);
+  BenchRow("Map", n, watch.Millis());
+  watch.Restart();
+  double sum = values.Fold<double>(add, 0.0);
+  BenchRow("Fold", n, watch.Millis());
+  Consume(sum);
+
+  for (ulong threads = 1; threads <= 4; threads *= 2) {
+    ThreadPool pool(threads - 1);
+    watch.Restart();
+    ParallelMap(values, scale, chunk, pool);
+    BenchRow("ParallelMap, " + std::to_string(threads) + " thread(s)", n, watch.Millis());
+    watch.Restart();
+    double check = ParallelFold<double>(values, add, plus, 0.0, chunk, pool);
+    BenchRow("ParallelFold, " + std::to_string(threads) + " thread(s)", n, watch.Millis());
+    Consume(check);
+  }
+}
+
+// Through the abstract interface, as generic code over LinearContainer sees
+// a container; noinline keeps the compiler from devirtualizing at the call
+[[gnu::noinline]] long benchVirtualSum(const LinearContainer<long> & container) {
+  long sum = 0;
+  for (ulong i = 0; i < container.Size(); ++i) sum += container[i];
+  return sum;
+}
+
+[[gnu::noinline]] long benchFoldSum(const LinearContainer<long> & container) {
+  return container.Fold<long>([](const long & value, const long & sum) { return sum + value; }, 0L);
+}
+
+// Through the final type: the compiler binds every call statically
+template <typename Final>
+[[gnu::noinline]] long benchFinalSum(const Final & container) {
+  long sum = 0;
+  for (ulong i = 0; i < container.Size(); ++i) sum += container[i];
+  return sum;
+}
+
+template <typename Derived>
+[[gnu::noinline]] long benchStaticSum(const StaticLinearContainer<Derived, long> & container) {
+  return container.template StaticFold<long>([](const long & value, const long & sum) { return sum + value; }, 0L);
+}
+
+template <typename Final>
+void benchStaticRows(const std::string & name, const Final & container, ulong rounds) {
+  ulong n = container.Size() * rounds;
+  long sums[4] = {0, 0, 0, 0};
+  Stopwatch watch;
+  for (ulong r = 0; r < rounds; ++r) sums[0] += benchVirtualSum(container);
+  BenchRow(name + ": virtual Size + operator[]", n, watch.Millis());
+  watch.Restart();
+  for (ulong r = 0; r < rounds; ++r) sums[1] += benchFoldSum(container);
+  BenchRow(name + ": virtual Fold", n, watch.Millis());
+  watch.Restart();
+  for (ulong r = 0; r < rounds; ++r) sums[2] += benchFinalSum(container);
+  BenchRow(name + ": final Size + operator[]", n, watch.Millis());
+  watch.Restart();
+  for (ulong r = 0; r < rounds; ++r) sums[3] += benchStaticSum(container);
+  BenchRow(name + ": StaticFold", n, watch.Millis());
+  if (sums[0] != sums[1] || sums[0] != sums[2] || sums[0] != sums[3]) {
+    cout << "    [results differ!]" << endl;
+  }
+}
+
+void benchStatic() {
+  BenchHeader("Virtual-inheritance overhead: sizeof, and a sum through virtual, final and CRTP interfaces");
+  cout << "  sizeof Vector<long>         " << sizeof(Vector<long>) << endl;
+  cout << "  sizeof SortableVector<long> " << sizeof(SortableVector<long>) << endl;
+  cout << "  sizeof List<long>           " << sizeof(List<long>) << endl;
+  cout << "  sizeof SetVec<long>         " << sizeof(SetVec<long>) << endl;
+  cout << "  sizeof SetLst<long>         " << sizeof(SetLst<long>) << endl;
+  cout << "  sizeof SetHash<long>        " << sizeof(SetHash<long>) << endl;
+  cout << "  sizeof HeapVec<long>        " << sizeof(HeapVec<long>) << endl;
+  cout << "  sizeof PQHeap<long>         " << sizeof(PQHeap<long>) << endl;
+  cout << "  sizeof PQMinMax<long>       " << sizeof(PQMinMax<long>) << endl;
+  cout << "  sizeof PQPairing<long>      " << sizeof(PQPairing<long>) << endl;
+  cout << "  sizeof std::vector<long>    " << sizeof(std::vector<long>) << endl;
+
+  const ulong n = 1000000;
+  BenchRandom rnd;
+  SortableVector<long> keys(n);
+  for (ulong i = 0; i < n; ++i) keys[i] = static_cast<long>(rnd.Next() % 1000000);
+  PQHeap<long> heap(keys);
+  PQMinMax<long> minmax(keys);
+  SetVec<long> set(keys);
+  benchStaticRows("PQHeap", heap, 20);
+  benchStaticRows("PQMinMax", minmax, 20);
+  benchStaticRows("SetVec", set, 20);
+}
+
+void benchFoldInPlace() {
+  BenchHeader("String concatenation: Fold (a new accumulator per value) vs FoldInPlace");
+  BenchRandom rnd;
+  for (ulong n : {1000UL, 4000UL, 16000UL, 32000UL, 1000000UL}) {
+    bool small = n <= 32000; // Fold is quadratic in the bytes, List traversal recursive: both only on small sizes
+    Vector<std::string> words(n);
+    List<std::string> list;
+    for (ulong i = 0; i < n; ++i) {
+      words[i] = std::to_string(rnd.Next() % 1000000) + ",";
+      if (small) list.InsertAtBack(words[i]);
+    }
+    ulong lengths[4] = {0, 0, 0, 0};
+    Stopwatch watch;
+    if (small) {
+      lengths[0] = words.Fold<std::string>([](const std::string & word, const std::string & text) { return text + word; }, std::string()).size();
+      BenchRow("Vector Fold", n, watch.Millis());
+    }
+    watch.Restart();
+    lengths[1] = words.FoldInPlace<std::string>([](const std::string & word, std::string & text) { text += word; }, std::string()).size();
+    BenchRow("Vector FoldInPlace", n, watch.Millis());
+    if (small) {
+      watch.Restart();
+      lengths[2] = list.Fold<std::string>([](const std::string & word, const std::string & text) { return text + word; }, std::string()).size();
+      BenchRow("List Fold", n, watch.Millis());
+      watch.Restart();
+      lengths[3] = list.FoldInPlace<std::string>([](const std::string & word, std::string & text) { text += word; }, std::string()).size();
+      BenchRow("List FoldInPlace", n, watch.Millis());
+    }
+    Consume(lengths[0] + lengths[2]);
+    if (small && (lengths[0] != lengths[1] || lengths[2] != lengths[1] || lengths[3] != lengths[1])) {
+      cout << "    [results differ!]" << endl;
+    }
+  }
+}
+
+/* ************************************************************************** */
+
+struct Benchmark {
+  const char * name;
+  std::function<void()> run;
+};
+
+int main(int argc, char * argv[]) {
+  const Benchmark benchmarks[] = {
+    {"sethash", benchSetHash},
+    {"setrange", benchSetRange},
+    {"setrank", benchSetPercentiles},
+    {"relocation", benchRelocation},
+    {"pqarity", benchPQArity},
+    {"comparator", benchComparator},
+    {"dijkstra", benchDijkstra},
+    {"pqbatch", benchBatch},
+    {"heapsort", benchHeapSort},
+    {"radix", benchRadix},
+    {"concurrentpq", benchConcurrentPQ},
+    {"meld", benchMeld},
+    {"topk", benchTopK},
+    {"selection", benchSelection},
+    {"minmax", benchMinMax},
+    {"lazyheap", benchLazyHeap},
+    {"timerwheel", benchTimerWheel},
+    {"external", benchExternal},
+    {"pagedheap", benchPagedHeap},
+    {"parallelbuild", benchParallelBuild},
+    {"threadpool", benchThreadPool},
+    {"parallelmap", benchParallelMap},
+    {"static", benchStatic},
+    {"foldinplace", benchFoldInPlace},
+  };
+
+  cout << "LASD Libraries 2025 - Benchmarks" << endl;
+  for (const auto & bench : benchmarks) {
+    bool selected = (argc == 1);
+    for (int arg = 1; arg < argc; ++arg) {
+      selected |= (strcmp(argv[arg], bench.name) == 0);
+    }
+    if (selected) {
+      bench.run();
+    }
+  }
+  return 0;
+}
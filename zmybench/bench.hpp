@@ -0,0 +1,100 @@
+#ifndef MYBENCH_HPP
+#define MYBENCH_HPP
+
+/* ************************************************************************** */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/* ************************************************************************** */
+
+// Wall-clock stopwatch in milliseconds
+class Stopwatch {
+
+private:
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+public:
+
+  inline void Restart() { start = std::chrono::steady_clock::now(); }
+
+  inline double Millis() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+};
+
+// Deterministic 64-bit generator (splitmix64), so every run sees the same keys
+class BenchRandom {
+
+private:
+
+  std::uint64_t state;
+
+public:
+
+  explicit BenchRandom(std::uint64_t seed = 0x5EED) : state(seed) {}
+
+  inline std::uint64_t Next() {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+};
+
+// Keeps the optimizer from discarding a benchmarked result
+template <typename Value>
+inline void Consume(const Value & value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Largest problem size for the scaling benchmarks: 10^7, or 10^8 when the
+// LASD_BENCH_LARGE environment variable is set
+inline unsigned long BenchLargestN() {
+  return (std::getenv("LASD_BENCH_LARGE") != nullptr) ? 100000000UL : 10000000UL;
+}
+
+// Value wrapper counting comparisons and moves (copies included) process-wide
+template <typename Value>
+struct Counted {
+  static inline unsigned long compares = 0;
+  static inline unsigned long moves = 0;
+
+  Value value{};
+
+  Counted() = default;
+  Counted(const Value & v) : value(v) {}
+  Counted(const Counted & other) : value(other.value) { ++moves; }
+  Counted(Counted && other) noexcept : value(std::move(other.value)) { ++moves; }
+  Counted & operator=(const Counted & other) { value = other.value; ++moves; return *this; }
+  Counted & operator=(Counted && other) noexcept { value = std::move(other.value); ++moves; return *this; }
+
+  bool operator<(const Counted & other) const { ++compares; return value < other.value; }
+  bool operator>(const Counted & other) const { ++compares; return value > other.value; }
+  bool operator==(const Counted & other) const { return value == other.value; }
+  bool operator!=(const Counted & other) const { return value != other.value; }
+
+  static void Reset() { compares = 0; moves = 0; }
+};
+
+inline void BenchHeader(const std::string & title) {
+  std::cout << std::endl << "==== " << title << " ====" << std::endl;
+}
+
+inline void BenchRow(const std::string & label, unsigned long n, double millis) {
+  std::cout << "  " << std::left << std::setw(44) << label << std::right
+            << " n=" << std::setw(10) << n
+            << std::setw(12) << std::fixed << std::setprecision(2) << millis << " ms"
+            << std::setw(10) << std::setprecision(1) << (millis * 1e6 / n) << " ns/op" << std::endl;
+}
+
+/* ************************************************************************** */
+
+#endif
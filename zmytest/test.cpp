@@ -1,10 +1,36 @@
 #include "../pq/heap/pqheap.hpp"
 #include "../heap/vec/heapvec.hpp"
 #include "../vector/vector.hpp"
+#include "../hash/set/sethash.hpp"
+#include "../pq/indexed/indexedpqheap.hpp"
+#include "../pq/radix/pqradix.hpp"
+#include "../pq/concurrent/concurrentpq.hpp"
+#include "../pq/pairing/pqpairing.hpp"
+#include "../heap/topk/topk.hpp"
+#include "../pq/minmax/pqminmax.hpp"
+#include "../pq/timerwheel/pqtimerwheel.hpp"
+#include "../pq/external/pqexternal.hpp"
+#include "../parallel/threadpool.hpp"
+#include "../parallel/parallelvector.hpp"
+#include "../container/static.hpp"
+#include "../set/vec/setvec.hpp"
+#include "../set/lst/setlst.hpp"
 #include <iostream>
 #include <string>
 #include <functional>
 #include <stdexcept>  // Aggiungi questa riga
+#include <set>
+#include <map>
+#include <random>
+#include <memory>
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
 
 using namespace std;
 using namespace lasd;
@@ -411,16 +437,2263 @@ void testPQHeapString() {
     cout << "\n======= END OF PQHEAP STRING TESTS =======" << endl;
 }
 
+// Hasher sending every value to the same home slot: a single long probe run
+struct CollidingHash {
+    ulong operator()(const int&) const noexcept { return 0x2A; }
+};
+
+// Test SetHash con interi e stringhe
+void testSetHash() {
+    cout << "\n======= TESTS FOR SETHASH CLASS =======" << endl;
+
+    cout << "\n=== SetHash Insert/Exists/Remove Test ===" << endl;
+    SetHash<int> sh;
+    bool insertTest = true;
+    for (int i = 0; i < 1000; i++) {
+        insertTest &= sh.Insert(i * 7);
+    }
+    insertTest &= (sh.Size() == 1000);
+    printTestResult("Insert 1000 distinct values", insertTest);
+
+    bool duplicateTest = !sh.Insert(0) && !sh.Insert(6993) && sh.Size() == 1000;
+    printTestResult("Insert duplicates rejected", duplicateTest);
+
+    bool existsTest = sh.Exists(693) && !sh.Exists(694) && !sh.Exists(-7);
+    printTestResult("Exists", existsTest);
+
+    bool removeTest = true;
+    for (int i = 0; i < 1000; i += 2) {
+        removeTest &= sh.Remove(i * 7);
+    }
+    removeTest &= !sh.Remove(0) && sh.Size() == 500;
+    for (int i = 0; i < 1000; i++) {
+        removeTest &= (sh.Exists(i * 7) == (i % 2 == 1));
+    }
+    printTestResult("Remove half, remaining still reachable", removeTest);
+
+    long sum = sh.Fold<long>([](const int& x, const long& acc) -> long { return acc + x; }, 0);
+    bool foldTest = (sum == 7L * 250000L);
+    printTestResult("Traverse/Fold over occupied slots", foldTest);
+    cout << "  - Expected sum: " << 7L * 250000L << ", Actual sum: " << sum << endl;
+
+    cout << "\n=== SetHash Copy/Move/Compare Test ===" << endl;
+    SetHash<int> copy(sh);
+    bool copyTest = (copy == sh) && copy.Size() == 500;
+    copy.Remove(7);
+    copyTest &= (copy != sh) && sh.Exists(7);
+    printTestResult("Copy constructor and comparison", copyTest);
+
+    SetHash<int> moved(std::move(copy));
+    bool moveTest = moved.Size() == 499 && copy.Size() == 0 && !moved.Exists(7);
+    printTestResult("Move constructor", moveTest);
+
+    Vector<int> vec(5);
+    vec[0] = 3; vec[1] = 1; vec[2] = 3; vec[3] = 2; vec[4] = 1;
+    SetHash<int> fromVec(vec);
+    bool containerTest = fromVec.Size() == 3 && fromVec.Exists(1) && fromVec.Exists(2) && fromVec.Exists(3);
+    printTestResult("TraversableContainer constructor", containerTest);
+
+    cout << "\n=== SetHash Reserve/Clear Test ===" << endl;
+    SetHash<int> reserved;
+    reserved.Reserve(1000);
+    ulong capacity = reserved.Capacity();
+    for (int i = 0; i < 1000; i++) {
+        reserved.Insert(i);
+    }
+    bool reserveTest = capacity >= 1000 && reserved.Capacity() == capacity;
+    printTestResult("Reserve avoids rehashing", reserveTest);
+    cout << "  - Capacity after Reserve(1000): " << capacity << endl;
+
+    reserved.Clear();
+    bool clearTest = reserved.Empty() && !reserved.Exists(5) && reserved.Insert(5) && reserved.Size() == 1;
+    printTestResult("Clear and reuse", clearTest);
+
+    cout << "\n=== SetHash Colliding Hasher Test ===" << endl;
+    SetHash<int, CollidingHash> coll;
+    for (int i = 0; i < 40; i++) {
+        coll.Insert(i);
+    }
+    bool collisionTest = coll.Size() == 40;
+    for (int i = 0; i < 40; i += 3) {
+        collisionTest &= coll.Remove(i);
+    }
+    for (int i = 0; i < 40; i++) {
+        collisionTest &= (coll.Exists(i) == (i % 3 != 0));
+    }
+    printTestResult("Backward-shift deletion across a wrapping run", collisionTest);
+
+    cout << "\n=== SetHash String Test ===" << endl;
+    SetHash<string> shs;
+    shs.Insert(string("banana"));
+    shs.Insert(string("apple"));
+    shs.Insert(string("cherry"));
+    bool stringTest = !shs.Insert(string("apple")) && shs.Exists("cherry") && shs.Remove("banana") && !shs.Exists("banana") && shs.Size() == 2;
+    printTestResult("String values", stringTest);
+
+    cout << "Overall SetHash test result: "
+         << (insertTest && duplicateTest && existsTest && removeTest && foldTest && copyTest && moveTest
+             && containerTest && reserveTest && clearTest && collisionTest && stringTest ? "SUCCESS" : "FAILURE") << endl;
+
+    cout << "\n======= END OF SETHASH TESTS =======" << endl;
+}
+
+// Range queries through the Set interface (values 0, 3, 6, ..., 57)
+void testSetRangeOn(const string& name, Set<int>& set) {
+    cout << "\n=== " << name << " Range Queries Test ===" << endl;
+    for (int i = 19; i >= 0; i--) {
+        set.Insert(i * 3);
+    }
+
+    string visited;
+    set.TraverseRange(10, 22, [&visited](const int& x) { visited += to_string(x) + " "; });
+    bool traverseTest = (visited == "12 15 18 21 ");
+    printTestResult("TraverseRange [10, 22)", traverseTest);
+    cout << "  - Visited: " << visited << endl;
+
+    bool countTest = set.CountRange(10, 22) == 4 && set.CountRange(0, 3) == 1 && set.CountRange(-5, 100) == 20
+                     && set.CountRange(22, 10) == 0 && set.CountRange(58, 100) == 0;
+    printTestResult("CountRange (inner, single, all, inverted, past end)", countTest);
+
+    bool removeTest = set.RemoveRange(10, 22) == 4 && set.Size() == 16 && !set.Exists(12) && !set.Exists(21)
+                      && set.Exists(9) && set.Exists(24) && set.CountRange(0, 100) == 16;
+    printTestResult("RemoveRange inner chain", removeTest);
+
+    bool edgeTest = set.RemoveRange(-10, 4) == 2 && set.Min() == 6
+                    && set.RemoveRange(50, 1000) == 3 && set.Max() == 48
+                    && set.RemoveRange(7, 8) == 0 && set.Size() == 11;
+    set.Insert(100);
+    edgeTest &= (set.Max() == 100);
+    edgeTest &= set.RemoveRange(-1000, 1000) == 12 && set.Empty();
+    set.Insert(1);
+    edgeTest &= (set.Min() == 1 && set.Max() == 1 && set.Size() == 1);
+    printTestResult("RemoveRange at both ends, everything, then reuse", edgeTest);
+
+    cout << "Overall " << name << " range test result: "
+         << (traverseTest && countTest && removeTest && edgeTest ? "SUCCESS" : "FAILURE") << endl;
+}
+
+void testSetRange() {
+    cout << "\n======= TESTS FOR SET RANGE QUERIES =======" << endl;
+    SetVec<int> setvec;
+    testSetRangeOn("SetVec", setvec);
+    SetLst<int> setlst;
+    testSetRangeOn("SetLst", setlst);
+    cout << "\n======= END OF SET RANGE TESTS =======" << endl;
+}
+
+// Rank/Select through the Set interface, interleaved with modifications
+void testSetOrderStatisticsOn(const string& name, Set<int>& set) {
+    cout << "\n=== " << name << " Rank/Select Test ===" << endl;
+    for (int i = 0; i < 100; i++) {
+        set.Insert((i * 37) % 100 * 2); // Even values 0..198, inserted out of order
+    }
+
+    bool rankTest = set.Rank(0) == 0 && set.Rank(1) == 1 && set.Rank(50) == 25 && set.Rank(51) == 26
+                    && set.Rank(-3) == 0 && set.Rank(1000) == 100;
+    printTestResult("Rank of present, absent and out-of-range values", rankTest);
+
+    bool selectTest = set.Select(0) == 0 && set.Select(25) == 50 && set.Select(99) == 198;
+    for (ulong k = 0; k < set.Size(); k++) {
+        selectTest &= (set.Rank(set.Select(k)) == k);
+    }
+    printTestResult("Select and Rank(Select(k)) == k", selectTest);
+
+    set.Remove(50);
+    set.Insert(51);
+    set.RemoveMin();
+    bool updateTest = set.Select(0) == 2 && set.Select(24) == 51 && set.Rank(52) == 25 && set.Size() == 99;
+    printTestResult("Rank/Select after Remove, Insert and RemoveMin", updateTest);
+
+    bool percentileTest = set.Select(set.Size() * 50 / 100) == 100 && set.Select(set.Size() * 99 / 100) == 198;
+    printTestResult("Percentiles (p50, p99)", percentileTest);
+    cout << "  - p50: " << set.Select(set.Size() * 50 / 100) << ", p99: " << set.Select(set.Size() * 99 / 100) << endl;
+
+    bool exceptionTest = false;
+    try {
+        set.Select(set.Size());
+    } catch (const std::out_of_range&) {
+        exceptionTest = true;
+    }
+    set.Clear();
+    try {
+        set.Select(0);
+        exceptionTest = false;
+    } catch (const std::out_of_range&) {
+    }
+    exceptionTest &= (set.Rank(5) == 0);
+    printTestResult("Select out of range throws; Rank on empty set", exceptionTest);
+
+    cout << "Overall " << name << " order statistics test result: "
+         << (rankTest && selectTest && updateTest && percentileTest && exceptionTest ? "SUCCESS" : "FAILURE") << endl;
+}
+
+void testSetOrderStatistics() {
+    cout << "\n======= TESTS FOR SET ORDER STATISTICS =======" << endl;
+    SetVec<int> setvec;
+    testSetOrderStatisticsOn("SetVec", setvec);
+    SetLst<int> setlst;
+    testSetOrderStatisticsOn("SetLst", setlst);
+
+    // The SetLst index follows every kind of update, checked against a model
+    std::mt19937 gen(28);
+    std::set<int> model;
+    SetLst<int> indexed;
+    bool modelTest = true;
+    for (ulong step = 0; step < 4000; step++) {
+        int value = static_cast<int>(gen() % 600);
+        switch (gen() % 8) {
+            case 0: case 1: case 2:
+                modelTest &= indexed.Insert(value) == model.insert(value).second;
+                break;
+            case 3:
+                modelTest &= indexed.Remove(value) == (model.erase(value) == 1);
+                break;
+            case 4:
+                if (model.empty()) break;
+                if (gen() % 2 == 0) {
+                    modelTest &= indexed.MinNRemove() == *model.begin();
+                    model.erase(model.begin());
+                } else {
+                    modelTest &= indexed.MaxNRemove() == *model.rbegin();
+                    model.erase(std::prev(model.end()));
+                }
+                break;
+            case 5: {
+                auto it = model.lower_bound(value);
+                if (it != model.begin()) {
+                    modelTest &= indexed.PredecessorNRemove(value) == *std::prev(it);
+                    model.erase(std::prev(it));
+                }
+                break;
+            }
+            case 6: {
+                auto it = model.upper_bound(value);
+                if (it != model.end()) {
+                    modelTest &= indexed.SuccessorNRemove(value) == *it;
+                    model.erase(it);
+                }
+                break;
+            }
+            default: {
+                auto first = model.lower_bound(value), last = model.lower_bound(value + 5);
+                modelTest &= indexed.RemoveRange(value, value + 5) == static_cast<ulong>(std::distance(first, last));
+                model.erase(first, last);
+            }
+        }
+        modelTest &= indexed.Size() == model.size();
+        if (!model.empty()) {
+            ulong k = gen() % model.size();
+            modelTest &= indexed.Select(k) == *std::next(model.begin(), k) && indexed.Min() == *model.begin() && indexed.Max() == *model.rbegin();
+        }
+        modelTest &= indexed.Rank(value) == static_cast<ulong>(std::distance(model.begin(), model.lower_bound(value)));
+        modelTest &= indexed.Exists(value) == (model.count(value) == 1);
+    }
+    SetLst<int> copied(indexed);
+    SetLst<int> moved(std::move(indexed));
+    modelTest &= indexed.Empty() && indexed.Rank(7) == 0 && copied == moved;
+    for (ulong k = 0; k < model.size(); k += 7) {
+        modelTest &= copied.Select(k) == moved.Select(k) && moved.Rank(moved.Select(k)) == k;
+    }
+    indexed = std::move(moved);
+    indexed.Insert(-1);
+    modelTest &= indexed.Select(0) == -1 && indexed.Size() == model.size() + 1 && moved.Empty();
+    printTestResult("SetLst Rank/Select stay exact across every kind of update", modelTest);
+    cout << "\n======= END OF SET ORDER STATISTICS TESTS =======" << endl;
+}
+
+// Heap-owning value: not trivially copyable, but safe to relocate bitwise
+struct Boxed {
+    int* ptr;
+    Boxed(int v = 0) : ptr(new int(v)) {}
+    Boxed(const Boxed& other) : ptr(new int(*other.ptr)) {}
+    Boxed& operator=(const Boxed& other) { *ptr = *other.ptr; return *this; }
+    ~Boxed() { delete ptr; }
+    bool operator<(const Boxed& other) const { return *ptr < *other.ptr; }
+    bool operator==(const Boxed& other) const { return *ptr == *other.ptr; }
+    bool operator!=(const Boxed& other) const { return *ptr != *other.ptr; }
+};
+
+template <>
+struct lasd::IsTriviallyRelocatable<Boxed> : std::true_type {};
+
+// Random Insert/Remove against std::set, checking order after every step batch
+template <typename Data>
+bool checkSetVecAgainstModel(SetVec<Data>& set, unsigned seed, int ops) {
+    std::set<int> model;
+    std::mt19937 gen(seed);
+    bool ok = true;
+    for (int op = 0; op < ops && ok; op++) {
+        int value = static_cast<int>(gen() % 500);
+        if (gen() % 3 != 0) {
+            ok &= (set.Insert(Data(value)) == model.insert(value).second);
+        } else {
+            ok &= (set.Remove(Data(value)) == (model.erase(value) == 1));
+        }
+        if (op % 97 == 0) {
+            ok &= (set.Size() == model.size());
+            ulong i = 0;
+            for (int expected : model) {
+                ok &= (set[i++] == Data(expected));
+            }
+        }
+    }
+    return ok;
+}
+
+// Test relocatable fast paths (memmove shifts, realloc growth)
+void testRelocation() {
+    cout << "\n======= TESTS FOR TRIVIALLY RELOCATABLE FAST PATHS =======" << endl;
+
+    Vector<int> vec(3);
+    vec[0] = 1; vec[1] = 2; vec[2] = 3;
+    vec.Resize(6);
+    bool growTest = vec.Size() == 6 && vec[0] == 1 && vec[2] == 3 && vec[3] == 0 && vec[5] == 0;
+    vec.Resize(2);
+    growTest &= vec.Size() == 2 && vec[1] == 2;
+    printTestResult("Vector<int> Resize keeps prefix, zero-fills growth", growTest);
+
+    SetVec<int> ints;
+    bool intTest = checkSetVecAgainstModel(ints, 7, 3000);
+    printTestResult("SetVec<int> random Insert/Remove (memmove path)", intTest);
+
+    SetVec<int> copy(ints);
+    bool copyTest = copy == ints;
+    for (int i = 0; i < 600; i++) {
+        copy.Insert(1000 + i);
+    }
+    copyTest &= copy.Size() == ints.Size() + 600 && copy.Max() == 1599 && copy.Exists(1000);
+    printTestResult("SetVec copy keeps its capacity consistent on growth", copyTest);
+
+    SetVec<Boxed> boxed;
+    bool boxedTest = checkSetVecAgainstModel(boxed, 11, 3000);
+    printTestResult("SetVec<Boxed> random Insert/Remove (relocatable, non-trivial)", boxedTest);
+
+    SetVec<string> strings;
+    bool stringTest = true;
+    for (int i = 0; i < 200; i++) {
+        stringTest &= strings.Insert(to_string((i * 71) % 200 + 1000));
+    }
+    for (int i = 0; i < 200; i += 2) {
+        stringTest &= strings.Remove(to_string(i + 1000));
+    }
+    stringTest &= strings.Size() == 100 && strings.Min() == "1001" && strings.Max() == "1199";
+    printTestResult("SetVec<string> (element-wise path)", stringTest);
+
+    cout << "Overall relocation test result: "
+         << (growTest && intTest && copyTest && boxedTest && stringTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF RELOCATION TESTS =======" << endl;
+}
+
+// Move-only value without a default constructor; a moved-from value reads -1
+struct MoveOnly {
+    std::unique_ptr<int> ptr;
+    explicit MoveOnly(int v) : ptr(std::make_unique<int>(v)) {}
+    MoveOnly(MoveOnly&&) noexcept = default;
+    MoveOnly& operator=(MoveOnly&&) noexcept = default;
+    int Value() const { return ptr ? *ptr : -1; }
+    bool operator<(const MoveOnly& other) const { return Value() < other.Value(); }
+    bool operator>(const MoveOnly& other) const { return Value() > other.Value(); }
+    bool operator<=(const MoveOnly& other) const { return Value() <= other.Value(); }
+    bool operator>=(const MoveOnly& other) const { return Value() >= other.Value(); }
+    bool operator==(const MoveOnly& other) const { return Value() == other.Value(); }
+    bool operator!=(const MoveOnly& other) const { return Value() != other.Value(); }
+};
+
+struct MoveOnlyHash {
+    ulong operator()(const MoveOnly& value) const noexcept { return Hashable<int>()(value.Value()); }
+};
+
+// Sorted, no moved-from leftovers, every removal returns the expected value
+bool testMoveOnlySetOn(const string& name, Set<MoveOnly>& set) {
+    bool ok = true;
+    for (int i = 0; i < 200; i++) {
+        ok &= set.Insert(MoveOnly((i * 71) % 200));
+    }
+    ok &= !set.Insert(MoveOnly(42));
+    for (int i = 0; i < 200; i += 4) {
+        ok &= set.Remove(MoveOnly(i));
+    }
+    ok &= set.Size() == 150;
+    ok &= set.MinNRemove().Value() == 1 && set.MaxNRemove().Value() == 199;
+    ok &= set.PredecessorNRemove(MoveOnly(100)).Value() == 99;
+    ok &= set.SuccessorNRemove(MoveOnly(100)).Value() == 101;
+    ok &= set.RemoveRange(MoveOnly(150), MoveOnly(170)) == 15;
+    int previous = -1;
+    set.Traverse([&ok, &previous](const MoveOnly& value) {
+        ok &= value.Value() > previous;
+        previous = value.Value();
+    });
+    ok &= set.Size() == 131;
+
+    const MoveOnly probe(1000);
+    bool copyThrows = false;
+    try {
+        set.Insert(probe);
+    } catch (const std::logic_error&) {
+        copyThrows = true;
+    }
+    ok &= copyThrows && set.Size() == 131;
+    printTestResult(name + "<MoveOnly> insert/remove/range by move", ok);
+    return ok;
+}
+
+// Test move-only and non-default-constructible element types
+void testMoveOnly() {
+    cout << "\n======= TESTS FOR MOVE-ONLY VALUES =======" << endl;
+
+    List<MoveOnly> list;
+    for (int i = 0; i < 10; i++) {
+        list.InsertAtBack(MoveOnly(i));
+    }
+    bool listTest = list.FrontNRemove().Value() == 0 && list.Front().Value() == 1;
+    Vector<MoveOnly> vec(std::move(list));
+    listTest &= vec.Size() == 9 && vec[0].Value() == 1 && vec[8].Value() == 9;
+    vec.Resize(4);
+    listTest &= vec.Size() == 4 && vec.Back().Value() == 4;
+    bool growThrows = false;
+    try {
+        vec.Resize(8);
+    } catch (const std::logic_error&) {
+        growThrows = true;
+    }
+    listTest &= growThrows && vec.Size() == 4;
+    printTestResult("List/Vector<MoveOnly> move construction and Resize", listTest);
+
+    SetVec<MoveOnly> setvec;
+    bool setvecTest = testMoveOnlySetOn("SetVec", setvec);
+    SetLst<MoveOnly> setlst;
+    bool setlstTest = testMoveOnlySetOn("SetLst", setlst);
+
+    SetHash<MoveOnly, MoveOnlyHash> sethash;
+    bool hashTest = true;
+    for (int i = 0; i < 500; i++) {
+        hashTest &= sethash.Insert(MoveOnly(i));
+    }
+    for (int i = 0; i < 500; i += 2) {
+        hashTest &= sethash.Remove(MoveOnly(i));
+    }
+    hashTest &= sethash.Size() == 250 && sethash.Exists(MoveOnly(499)) && !sethash.Exists(MoveOnly(0));
+    sethash.Traverse([&hashTest](const MoveOnly& value) { hashTest &= value.Value() % 2 == 1; });
+    printTestResult("SetHash<MoveOnly> insert/remove by move", hashTest);
+
+    List<MoveOnly> source;
+    for (int i = 0; i < 100; i++) {
+        source.InsertAtBack(MoveOnly((i * 37) % 100));
+    }
+    HeapVec<MoveOnly> heap(std::move(source));
+    heap.Insert(MoveOnly(500));
+    bool heapTest = heap.IsHeap() && heap.Top().Value() == 500;
+    for (int expected = 500; heapTest && heap.Size() > 0; expected = (expected == 500) ? 99 : expected - 1) {
+        heapTest &= heap.TopNRemove().Value() == expected;
+    }
+    printTestResult("HeapVec<MoveOnly> TopNRemove in order", heapTest);
+
+    PQHeap<MoveOnly> pq;
+    for (int i = 0; i < 100; i++) {
+        pq.Insert(MoveOnly((i * 37) % 100));
+    }
+    pq.Change(0, MoveOnly(-5));
+    pq.Change(50, MoveOnly(1000));
+    bool pqTest = pq.IsHeap() && pq.Tip().Value() != -5;
+    int previous = pq.TipNRemove().Value();
+    pqTest &= previous == 1000;
+    while (pqTest && pq.Size() > 0) {
+        int current = pq.TipNRemove().Value();
+        pqTest &= current < previous;
+        previous = current;
+    }
+    pqTest &= previous == -5;
+    printTestResult("PQHeap<MoveOnly> Insert/Change/TipNRemove by move", pqTest);
+
+    PQHeap<std::unique_ptr<int>> pointers;
+    for (int i = 0; i < 64; i++) {
+        pointers.Insert(std::make_unique<int>(i));
+    }
+    bool pointerTest = true;
+    int sum = 0;
+    std::unique_ptr<int> last = pointers.TipNRemove();
+    while (pointerTest && pointers.Size() > 0) {
+        std::unique_ptr<int> current = pointers.TipNRemove();
+        pointerTest &= current != nullptr && std::greater<std::unique_ptr<int>>()(last, current);
+        sum += *last;
+        last = std::move(current);
+    }
+    pointerTest &= sum + *last == 64 * 63 / 2;
+    printTestResult("PQHeap<unique_ptr<int>> drains every pointer once", pointerTest);
+
+    cout << "Overall move-only test result: "
+         << (listTest && setvecTest && setlstTest && hashTest && heapTest && pqTest && pointerTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF MOVE-ONLY TESTS =======" << endl;
+}
+
+// Heap invariants, Sort and PQ drain order for one arity, against std::multiset
+template <ulong Arity>
+bool testHeapArityOn() {
+    std::mt19937 gen(Arity);
+    List<int> values;
+    for (int i = 0; i < 1000; i++) {
+        values.InsertAtBack(static_cast<int>(gen() % 300));
+    }
+
+    HeapVec<int, Arity> heap(values);
+    bool heapTest = heap.IsHeap();
+    heap.Sort();
+    for (ulong i = 1; i < heap.Size(); i++) {
+        heapTest &= heap[i - 1] <= heap[i];
+    }
+    heap.Heapify();
+    heapTest &= heap.IsHeap();
+    printTestResult("HeapVec arity " + to_string(Arity) + " build/Sort/Heapify", heapTest);
+
+    PQHeap<int, Arity> pq;
+    std::multiset<int> model;
+    bool pqTest = true;
+    for (int op = 0; op < 3000 && pqTest; op++) {
+        if (gen() % 3 != 0 || model.empty()) {
+            int value = static_cast<int>(gen() % 1000);
+            pq.Insert(value);
+            model.insert(value);
+        } else if (gen() % 4 == 0) {
+            ulong index = gen() % pq.Size();
+            int value = static_cast<int>(gen() % 1000);
+            model.erase(model.find(pq[index]));
+            model.insert(value);
+            pq.Change(index, value);
+        } else {
+            pqTest &= pq.TipNRemove() == *model.rbegin();
+            model.erase(std::prev(model.end()));
+        }
+        pqTest &= pq.Size() == model.size();
+    }
+    pqTest &= pq.Size() == 0 || pq.IsHeap();
+    printTestResult("PQHeap arity " + to_string(Arity) + " against std::multiset", pqTest);
+    return heapTest && pqTest;
+}
+
+// Test d-ary heaps
+void testHeapArity() {
+    cout << "\n======= TESTS FOR D-ARY HEAPS =======" << endl;
+    bool ok = testHeapArityOn<2>();
+    ok &= testHeapArityOn<3>();
+    ok &= testHeapArityOn<4>();
+    ok &= testHeapArityOn<8>();
+    cout << "Overall d-ary heap test result: " << (ok ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF D-ARY HEAP TESTS =======" << endl;
+}
+
+// Case-insensitive order on strings: "abc" and "ABC" are the same element
+struct CaseInsensitiveLess {
+    bool operator()(const string& a, const string& b) const {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+            [](char x, char y) { return std::tolower(x) < std::tolower(y); });
+    }
+};
+
+// Test comparator policies on heaps and sets
+void testComparator() {
+    cout << "\n======= TESTS FOR COMPARATOR POLICIES =======" << endl;
+
+    PQHeap<int, 4, std::greater<int>> minpq;
+    for (int i = 0; i < 200; i++) {
+        minpq.Insert((i * 37) % 200);
+    }
+    bool minTest = minpq.IsHeap() && minpq.Tip() == 0;
+    minpq.Change(0, 500);
+    minTest &= minpq.Tip() == 1;
+    for (int expected = 1; minTest && expected < 200; expected++) {
+        minTest &= minpq.TipNRemove() == expected;
+    }
+    minTest &= minpq.TipNRemove() == 500 && minpq.Size() == 0;
+    printTestResult("PQHeap<int, 4, greater> drains in ascending order", minTest);
+
+    List<int> values;
+    for (int i = 0; i < 50; i++) {
+        values.InsertAtBack((i * 13) % 50);
+    }
+    HeapVec<int, 2, std::greater<int>> minheap(values);
+    minheap.Sort();
+    bool sortTest = true;
+    for (ulong i = 0; i < minheap.Size(); i++) {
+        sortTest &= minheap[i] == 49 - static_cast<int>(i);
+    }
+    printTestResult("HeapVec<int, 2, greater> Sort is descending", sortTest);
+
+    SetVec<int, std::greater<int>> setvec;
+    SetLst<int, std::greater<int>> setlst;
+    bool reverseTest = true;
+    for (int i = 0; i < 100; i++) {
+        int value = (i * 31) % 100;
+        reverseTest &= setvec.Insert(value) && setlst.Insert(value);
+    }
+    reverseTest &= !setvec.Insert(42) && !setlst.Insert(42);
+    reverseTest &= setvec.Min() == 99 && setvec.Max() == 0 && setlst.Min() == 99 && setlst.Max() == 0;
+    reverseTest &= setvec.Successor(50) == 49 && setlst.Successor(50) == 49;
+    reverseTest &= setvec.Predecessor(50) == 51 && setlst.Predecessor(50) == 51;
+    reverseTest &= setvec.CountRange(80, 70) == 10 && setlst.CountRange(80, 70) == 10;
+    reverseTest &= setvec.Rank(90) == 9 && setlst.Rank(90) == 9 && setvec.Select(0) == 99 && setlst.Select(99) == 0;
+    reverseTest &= setvec.Remove(7) && setlst.Remove(7) && !setvec.Exists(7) && !setlst.Exists(7);
+    printTestResult("SetVec/SetLst<int, greater> ordered in reverse", reverseTest);
+
+    SetVec<string, CaseInsensitiveLess> words;
+    SetLst<string, CaseInsensitiveLess> wordlist;
+    bool caseTest = words.Insert("Beta") && words.Insert("alpha") && !words.Insert("ALPHA");
+    caseTest &= wordlist.Insert("Beta") && wordlist.Insert("alpha") && !wordlist.Insert("ALPHA");
+    caseTest &= words.Exists("BETA") && wordlist.Exists("beta") && words.Min() == "alpha" && wordlist.Min() == "alpha";
+    caseTest &= words.Remove("bEtA") && wordlist.Remove("bEtA") && words.Size() == 1 && wordlist.Size() == 1;
+    printTestResult("SetVec/SetLst equality follows the comparator", caseTest);
+
+    cout << "Overall comparator test result: "
+         << (minTest && sortTest && reverseTest && caseTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF COMPARATOR TESTS =======" << endl;
+}
+
+// Shortest paths from vertex 0 with decrease-key and with duplicate inserts
+void shortestPaths(ulong n, const std::vector<std::vector<std::pair<ulong, ulong>>>& graph,
+                   std::vector<ulong>& indexed, std::vector<ulong>& duplicates) {
+    const ulong infinity = static_cast<ulong>(-1);
+    indexed.assign(n, infinity);
+    IndexedPQHeap<ulong, std::greater<ulong>> queue;
+    std::vector<IndexedPQHeap<ulong, std::greater<ulong>>::Handle> handle(n);
+    std::vector<ulong> vertex(n); // Vertex of every handle slot
+    indexed[0] = 0;
+    handle[0] = queue.Insert(0);
+    vertex[handle[0].index] = 0;
+    while (!queue.Empty()) {
+        ulong u = vertex[queue.TipHandle().index];
+        queue.RemoveTip();
+        for (auto [v, w] : graph[u]) {
+            if (indexed[u] + w < indexed[v]) {
+                indexed[v] = indexed[u] + w;
+                if (queue.Contains(handle[v])) {
+                    queue.Update(handle[v], indexed[v]);
+                } else {
+                    handle[v] = queue.Insert(indexed[v]);
+                    vertex[handle[v].index] = v;
+                }
+            }
+        }
+    }
+
+    duplicates.assign(n, infinity);
+    PQHeap<std::pair<ulong, ulong>, 2, std::greater<std::pair<ulong, ulong>>> lazy;
+    duplicates[0] = 0;
+    lazy.Insert({0, 0});
+    while (!lazy.Empty()) {
+        auto [d, u] = lazy.TipNRemove();
+        if (d != duplicates[u]) {
+            continue;
+        }
+        for (auto [v, w] : graph[u]) {
+            if (d + w < duplicates[v]) {
+                duplicates[v] = d + w;
+                lazy.Insert({duplicates[v], v});
+            }
+        }
+    }
+}
+
+// Test the addressable priority queue
+void testIndexedPQ() {
+    cout << "\n======= TESTS FOR INDEXED PRIORITY QUEUE =======" << endl;
+
+    using Handle = IndexedPQHeap<int>::Handle;
+    IndexedPQHeap<int> pq;
+    std::map<ulong, std::pair<Handle, int>> model; // By slot
+    std::vector<Handle> released;
+    std::mt19937 gen(33);
+    bool modelTest = true;
+    for (int op = 0; op < 5000 && modelTest; op++) {
+        ulong choice = gen() % 5;
+        if (choice <= 1 || model.empty()) {
+            int value = static_cast<int>(gen() % 1000);
+            Handle handle = pq.Insert(value);
+            modelTest &= model.count(handle.index) == 0;
+            model[handle.index] = {handle, value};
+        } else if (choice == 2) {
+            auto it = std::next(model.begin(), gen() % model.size());
+            int value = static_cast<int>(gen() % 1000);
+            pq.Update(it->second.first, value);
+            it->second.second = value;
+        } else if (choice == 3) {
+            auto it = std::next(model.begin(), gen() % model.size());
+            Handle handle = it->second.first;
+            modelTest &= pq.Remove(handle) && !pq.Contains(handle) && !pq.Remove(handle);
+            released.push_back(handle);
+            model.erase(it);
+        } else {
+            auto best = model.begin();
+            for (auto it = model.begin(); it != model.end(); ++it) {
+                if (it->second.second > best->second.second) best = it;
+            }
+            modelTest &= pq.Tip() == best->second.second;
+            Handle handle = pq.TipHandle(); // Ties may pick another value than best
+            auto top = model.find(handle.index);
+            modelTest &= top != model.end() && top->second.first.generation == handle.generation;
+            modelTest &= top != model.end() && top->second.second == best->second.second && pq.TipNRemove() == best->second.second;
+            released.push_back(handle);
+            if (top != model.end()) model.erase(top);
+        }
+        modelTest &= pq.Size() == model.size();
+        if (op % 101 == 0) {
+            for (const auto& [slot, entry] : model) {
+                modelTest &= pq.Contains(entry.first) && pq.Value(entry.first) == entry.second;
+            }
+            for (const Handle& handle : released) {
+                modelTest &= !pq.Contains(handle); // Stale, even when its slot holds a newer value
+            }
+        }
+    }
+    printTestResult("IndexedPQHeap random Insert/Update/Remove against a model", modelTest);
+
+    bool errorTest = false;
+    try {
+        pq.Update(Handle{1000000, 0}, 1);
+    } catch (const std::out_of_range&) {
+        errorTest = true;
+    }
+    IndexedPQHeap<int> copy(pq);
+    pq.Clear();
+    errorTest &= pq.Empty() && copy.Size() == model.size();
+    Handle fresh = pq.Insert(5);
+    errorTest &= pq.Contains(fresh) && fresh.index < copy.Slots();
+    for (const auto& [slot, entry] : model) {
+        errorTest &= !pq.Contains(entry.first) && copy.Contains(entry.first);
+    }
+    printTestResult("IndexedPQHeap errors, copy and Clear", errorTest);
+
+    // A queue that runs forever keeps as many slots as its peak size
+    IndexedPQHeap<long> churn;
+    auto first = churn.Insert(0);
+    for (long i = 1; i <= 100000; i++) {
+        churn.Insert(i);
+        churn.RemoveTip();
+    }
+    bool recycleTest = churn.Size() == 1 && churn.Slots() == 2 && churn.Contains(first) && churn.Tip() == 0;
+    churn.Remove(first);
+    recycleTest &= !churn.Contains(first) && churn.Insert(7).index < 2 && churn.Slots() == 2;
+    printTestResult("IndexedPQHeap recycles the slots of removed values", recycleTest);
+
+    ulong n = 2000;
+    std::vector<std::vector<std::pair<ulong, ulong>>> graph(n);
+    for (ulong u = 0; u < n; u++) {
+        for (int e = 0; e < 6; e++) {
+            graph[u].push_back({gen() % n, 1 + gen() % 100});
+        }
+    }
+    std::vector<ulong> indexed, duplicates;
+    shortestPaths(n, graph, indexed, duplicates);
+    bool pathTest = indexed == duplicates;
+    printTestResult("Dijkstra with Update matches duplicate inserts", pathTest);
+
+    cout << "Overall indexed PQ test result: " << (modelTest && errorTest && recycleTest && pathTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF INDEXED PQ TESTS =======" << endl;
+}
+
+// Test batched insertion and removal
+void testBatch() {
+    cout << "\n======= TESTS FOR BATCHED PQ OPERATIONS =======" << endl;
+
+    std::mt19937 gen(34);
+    std::multiset<int> model;
+    PQHeap<int, 4> pq;
+    for (int i = 0; i < 1000; i++) {
+        int value = static_cast<int>(gen() % 5000);
+        pq.Insert(value);
+        model.insert(value);
+    }
+    bool growTest = pq.Capacity() >= pq.Size() && pq.Capacity() < 2 * pq.Size();
+    printTestResult("PQHeap Insert grows capacity geometrically", growTest);
+
+    Vector<int> small(10), large(5000);
+    for (ulong i = 0; i < small.Size(); i++) {
+        small[i] = static_cast<int>(gen() % 5000);
+        model.insert(small[i]);
+    }
+    pq.InsertBatch(small);
+    bool batchTest = pq.IsHeap() && pq.Size() == model.size();
+    for (ulong i = 0; i < large.Size(); i++) {
+        large[i] = static_cast<int>(gen() % 5000);
+        model.insert(large[i]);
+    }
+    pq.InsertBatch(large);
+    batchTest &= pq.IsHeap() && pq.Size() == model.size() && pq.Tip() == *model.rbegin();
+    List<string> words;
+    words.InsertAtBack("delta");
+    words.InsertAtBack("alpha");
+    words.InsertAtBack("charlie");
+    PQHeap<string, 2, std::greater<string>> wordpq;
+    wordpq.Insert("bravo");
+    wordpq.InsertBatch(std::move(words));
+    batchTest &= wordpq.Size() == 4 && wordpq.Tip() == "alpha" && wordpq.IsHeap();
+    printTestResult("PQHeap InsertBatch (sift-up and rebuild paths)", batchTest);
+
+    Vector<int> top = pq.TipNRemoveK(100);
+    bool topTest = top.Size() == 100;
+    for (ulong i = 0; i < top.Size(); i++) {
+        topTest &= top[i] == *model.rbegin();
+        model.erase(std::prev(model.end()));
+    }
+    topTest &= pq.Size() == model.size() && pq.IsHeap() && pq.Tip() == *model.rbegin();
+    topTest &= pq.TipNRemoveK(0).Size() == 0;
+    bool tooMany = false;
+    try {
+        pq.TipNRemoveK(pq.Size() + 1);
+    } catch (const std::length_error&) {
+        tooMany = true;
+    }
+    topTest &= tooMany && pq.Size() == model.size();
+    Vector<int> all = pq.TipNRemoveK(pq.Size());
+    topTest &= pq.Empty() && all.Size() == model.size() && all.Back() == *model.begin();
+    printTestResult("PQHeap TipNRemoveK in priority order", topTest);
+
+    cout << "Overall batch test result: " << (growTest && batchTest && topTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF BATCH TESTS =======" << endl;
+}
+
+// Value that counts its comparisons and moves (copies count as moves)
+struct CountedInt {
+    static inline ulong compares = 0;
+    static inline ulong moves = 0;
+    int value = 0;
+    CountedInt() = default;
+    CountedInt(int v) : value(v) {}
+    CountedInt(const CountedInt& other) : value(other.value) { moves++; }
+    CountedInt(CountedInt&& other) noexcept : value(other.value) { moves++; }
+    CountedInt& operator=(const CountedInt& other) { value = other.value; moves++; return *this; }
+    CountedInt& operator=(CountedInt&& other) noexcept { value = other.value; moves++; return *this; }
+    bool operator<(const CountedInt& other) const { compares++; return value < other.value; }
+    bool operator>(const CountedInt& other) const { compares++; return value > other.value; }
+    bool operator==(const CountedInt& other) const { return value == other.value; }
+    bool operator!=(const CountedInt& other) const { return value != other.value; }
+};
+
+template <ulong Arity, typename Compare>
+bool testHeapSortOn(std::mt19937& gen) {
+    bool ok = true;
+    for (ulong n = 0; n <= 200; n += (n < 20 ? 1 : 37)) {
+        Vector<CountedInt> values(n);
+        std::vector<int> model(n);
+        for (ulong i = 0; i < n; i++) {
+            model[i] = static_cast<int>(gen() % 50);
+            values[i] = model[i];
+        }
+        HeapVec<CountedInt, Arity, Compare> heap(values);
+        heap.Sort();
+        std::sort(model.begin(), model.end(), [](int a, int b) { return Compare()(CountedInt(a), CountedInt(b)); });
+        for (ulong i = 0; i < n; i++) {
+            ok &= heap[i].value == model[i];
+        }
+    }
+    return ok;
+}
+
+void testHoleSift() {
+    cout << "\n======= TESTS FOR HOLE-BASED SIFTING =======" << endl;
+
+    std::mt19937 gen(35);
+    bool sortTest = testHeapSortOn<2, std::less<CountedInt>>(gen);
+    sortTest &= testHeapSortOn<3, std::less<CountedInt>>(gen);
+    sortTest &= testHeapSortOn<4, std::greater<CountedInt>>(gen);
+    printTestResult("HeapVec bottom-up Sort (arity 2, 3, 4; both orders)", sortTest);
+
+    // A value climbing the whole height costs one move per level plus two
+    HeapVec<CountedInt> heap;
+    heap.Reserve(1024);
+    for (int i = 0; i < 1023; i++) {
+        heap.Insert(CountedInt(-i));
+    }
+    CountedInt::moves = 0;
+    heap.Insert(CountedInt(5000));
+    bool siftTest = heap.Top().value == 5000 && CountedInt::moves <= 1 + 10 + 2;
+    CountedInt::moves = 0;
+    CountedInt top = heap.TopNRemove();
+    siftTest &= top.value == 5000 && heap.IsHeap() && CountedInt::moves <= 3 + 10 + 1;
+    printTestResult("HeapVec sift moves one value per level", siftTest);
+
+    ulong n = 4096;
+    Vector<CountedInt> values(n);
+    for (ulong i = 0; i < n; i++) {
+        values[i] = static_cast<int>(gen());
+    }
+    HeapVec<CountedInt> big(values);
+    CountedInt::compares = 0;
+    CountedInt::moves = 0;
+    big.Sort();
+    bool costTest = true;
+    for (ulong i = 1; i < n; i++) {
+        costTest &= !(big[i] < big[i - 1]);
+    }
+    // Textbook heapsort needs about 2 n log n comparisons and 3 n log n moves
+    costTest &= CountedInt::compares < 3 * n * 12 / 2 && CountedInt::moves < 3 * n * 12 / 2;
+    printTestResult("HeapVec Sort stays near n log n comparisons and moves", costTest);
+
+    cout << "Overall hole sift test result: " << (sortTest && siftTest && costTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF HOLE SIFT TESTS =======" << endl;
+}
+
+// A value with an integer key, for the radix priority queue
+template <typename Number, typename Payload>
+struct Keyed {
+    Number key;
+    Payload value;
+    bool operator==(const Keyed& other) const { return key == other.key && value == other.value; }
+    bool operator!=(const Keyed& other) const { return !(*this == other); }
+};
+
+struct KeyOf {
+    template <typename Item>
+    auto operator()(const Item& item) const { return item.key; }
+};
+
+// Test the monotone radix priority queue
+void testRadixPQ() {
+    cout << "\n======= TESTS FOR RADIX PRIORITY QUEUE =======" << endl;
+
+    // Event-loop shape: new keys never fall below the last removed one
+    PQRadix<Keyed<ulong, int>, KeyOf> pq;
+    std::multimap<ulong, int> model;
+    std::mt19937_64 gen(36);
+    bool modelTest = true;
+    ulong floor = 0;
+    for (int op = 0; op < 20000 && modelTest; op++) {
+        if (gen() % 3 != 0 || model.empty()) {
+            ulong key = floor + (gen() % 4 == 0 ? gen() % 8 : gen() % 1000000);
+            pq.Insert({key, op});
+            model.insert({key, op});
+        } else {
+            modelTest &= pq.Tip().key == model.begin()->first;
+            auto [key, value] = pq.TipNRemove();
+            auto range = model.equal_range(key);
+            auto it = std::find_if(range.first, range.second, [value](const auto& item) { return item.second == value; });
+            modelTest &= key == model.begin()->first && it != range.second;
+            if (it != range.second) model.erase(it);
+            floor = key;
+            modelTest &= pq.Floor() == floor;
+        }
+        modelTest &= pq.Size() == model.size();
+    }
+    printTestResult("PQRadix random monotone Insert/TipNRemove against a model", modelTest);
+
+    bool monotoneTest = false;
+    try {
+        pq.Insert({floor - 1, 0});
+    } catch (const std::invalid_argument&) {
+        monotoneTest = true;
+    }
+    monotoneTest &= pq.Size() == model.size();
+    PQRadix<Keyed<ulong, int>, KeyOf> copy(pq);
+    pq.Insert({floor, 7});
+    monotoneTest &= pq.Tip().key == floor && copy.Size() + 1 == pq.Size();
+    pq.Clear();
+    monotoneTest &= pq.Empty() && pq.Floor() == 0;
+    pq.Insert({0, 1});
+    bool emptyThrows = false;
+    pq.RemoveTip();
+    try {
+        pq.TipNRemove();
+    } catch (const std::length_error&) {
+        emptyThrows = true;
+    }
+    monotoneTest &= emptyThrows;
+    printTestResult("PQRadix monotonicity violation, copy, Clear and empty errors", monotoneTest);
+
+    // Signed keys keep their order, peeking does not raise the floor
+    PQRadix<Keyed<int, string>, KeyOf> timers;
+    timers.Insert({-5, "b"});
+    timers.Insert({3, "c"});
+    timers.Insert({-40, "a"});
+    bool signedTest = timers.Tip().value == "a" && timers.Floor() == std::numeric_limits<int>::min();
+    timers.Insert({-100, "z"});
+    signedTest &= timers.TipNRemove().value == "z" && timers.TipNRemove().value == "a";
+    timers.Insert({-40, "again"});
+    signedTest &= timers.TipNRemove().value == "again" && timers.TipNRemove().value == "b";
+    signedTest &= timers.TipNRemove().value == "c" && timers.Empty() && timers.Floor() == 3;
+    printTestResult("PQRadix signed keys and Tip without removal", signedTest);
+
+    // Through the PQ interface: index order is bucket order, Change moves a
+    // value to the bucket of its new key
+    PQRadix<ulong> plain;
+    PQ<ulong>& queue = plain;
+    for (ulong value : {40UL, 7UL, 300UL, 7UL, 1UL << 40, 90UL}) queue.Insert(value);
+    bool interfaceTest = queue.TipNRemove() == 7 && queue.Tip() == 7 && plain.Floor() == 7;
+    ulong traversed = 0;
+    queue.Traverse([&traversed](const ulong& value) { traversed += value; });
+    std::vector<ulong> indexed, reversed;
+    for (ulong i = 0; i < queue.Size(); i++) indexed.push_back(queue[i]);
+    queue.PostOrderTraverse([&reversed](const ulong& value) { reversed.push_back(value); });
+    std::reverse(reversed.begin(), reversed.end());
+    interfaceTest &= traversed == 7 + 40 + 300 + (1UL << 40) + 90 && indexed == reversed;
+    for (ulong i = 0; i < queue.Size(); i++) {
+        if (queue[i] == (1UL << 40)) queue.Change(i, 8);
+    }
+    for (ulong i = 0; i < queue.Size(); i++) {
+        if (queue[i] == 300) queue.Change(i, 1000);
+    }
+    bool changeThrows = false;
+    try {
+        queue.Change(0, 6);
+    } catch (const std::invalid_argument&) {
+        changeThrows = true;
+    }
+    try {
+        queue.Change(queue.Size(), 9);
+        changeThrows = false;
+    } catch (const std::out_of_range&) {
+    }
+    interfaceTest &= changeThrows && queue.Size() == 5;
+    for (ulong expected : {7UL, 8UL, 40UL, 90UL, 1000UL}) interfaceTest &= queue.TipNRemove() == expected;
+    interfaceTest &= queue.Empty();
+    Vector<ulong> source(3);
+    source[0] = 5;
+    source[1] = 2;
+    source[2] = 9;
+    PQRadix<ulong> built(source);
+    interfaceTest &= built.Size() == 3 && built.TipNRemove() == 2 && built.TipNRemove() == 5;
+    printTestResult("PQRadix through the PQ interface: operator[], traversals and Change", interfaceTest);
+
+    cout << "Overall radix PQ test result: " << (modelTest && monotoneTest && signedTest && interfaceTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF RADIX PQ TESTS =======" << endl;
+}
+
+// Test the relaxed concurrent priority queue
+void testConcurrentPQ() {
+    cout << "\n======= TESTS FOR CONCURRENT PRIORITY QUEUE =======" << endl;
+
+    // Single thread: every value comes out once, each close to the top
+    ConcurrentPQ<int> pq(4);
+    const int n = 4000;
+    for (int i = 0; i < n; i++) {
+        pq.Insert((i * 7919) % n);
+    }
+    std::set<int> remaining;
+    for (int i = 0; i < n; i++) remaining.insert(i);
+    bool rankTest = pq.Size() == static_cast<ulong>(n) && pq.Shards() == 8;
+    ulong worstRank = 0;
+    int value = 0;
+    while (pq.TryTipNRemove(value)) {
+        auto it = remaining.find(value);
+        rankTest &= it != remaining.end();
+        if (it == remaining.end()) break;
+        worstRank = std::max<ulong>(worstRank, std::distance(it, remaining.end()) - 1);
+        remaining.erase(it);
+    }
+    rankTest &= remaining.empty() && pq.Empty() && worstRank < 200;
+    printTestResult("ConcurrentPQ single thread: all values, bounded rank error", rankTest);
+
+    // Producers and consumers at once: nothing lost, nothing duplicated
+    const int threads = 4, perThread = 5000;
+    ConcurrentPQ<int, std::greater<int>> shared(threads);
+    std::vector<std::vector<int>> popped(threads);
+    std::atomic<int> producersDone{0};
+    std::atomic<bool> sizeWrapped{false}; // A pop counted before its push would wrap Size around
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; i++) {
+                shared.Insert(t * perThread + i);
+            }
+            producersDone++;
+        });
+        workers.emplace_back([&, t]() {
+            int item = 0;
+            while (true) {
+                if (shared.TryTipNRemove(item)) {
+                    popped[t].push_back(item);
+                    if (shared.Size() > static_cast<ulong>(threads * perThread)) sizeWrapped = true;
+                } else if (producersDone.load() == threads && shared.Empty()) {
+                    break;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    std::vector<int> all;
+    for (const auto& part : popped) all.insert(all.end(), part.begin(), part.end());
+    std::sort(all.begin(), all.end());
+    bool threadTest = all.size() == static_cast<size_t>(threads * perThread) && shared.Empty() && !sizeWrapped;
+    for (size_t i = 0; i < all.size() && threadTest; i++) {
+        threadTest &= all[i] == static_cast<int>(i);
+    }
+    printTestResult("ConcurrentPQ concurrent Insert/TryTipNRemove", threadTest);
+
+    bool errorTest = false;
+    try {
+        ConcurrentPQ<int> none(0);
+    } catch (const std::invalid_argument&) {
+        errorTest = true;
+    }
+    errorTest &= !shared.TryTipNRemove(value);
+    printTestResult("ConcurrentPQ errors and empty removal", errorTest);
+
+    cout << "Overall concurrent PQ test result: " << (rankTest && threadTest && errorTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF CONCURRENT PQ TESTS =======" << endl;
+}
+
+// Test the meldable pairing heap and PQHeap::Meld
+void testMeld() {
+    cout << "\n======= TESTS FOR MELDABLE PRIORITY QUEUES =======" << endl;
+
+    std::mt19937 gen(38);
+    std::multiset<int> model;
+    PQPairing<int> pq;
+    bool modelTest = true;
+    for (int op = 0; op < 6000 && modelTest; op++) {
+        ulong choice = gen() % 6;
+        if (choice <= 2 || model.empty()) {
+            int value = static_cast<int>(gen() % 2000);
+            pq.Insert(value);
+            model.insert(value);
+        } else if (choice == 3) {
+            ulong index = gen() % pq.Size();
+            int old = pq[index];
+            int value = static_cast<int>(gen() % 2000);
+            pq.Change(index, value);
+            model.erase(model.find(old));
+            model.insert(value);
+        } else {
+            modelTest &= pq.Tip() == *model.rbegin() && pq.TipNRemove() == *model.rbegin();
+            model.erase(std::prev(model.end()));
+        }
+        modelTest &= pq.Size() == model.size();
+    }
+    int sum = 0, expected = 0;
+    pq.Traverse([&sum](const int& value) { sum += value; });
+    for (int value : model) expected += value;
+    modelTest &= sum == expected;
+    printTestResult("PQPairing random Insert/Change/TipNRemove against a model", modelTest);
+
+    PQPairing<int> other;
+    for (int i = 0; i < 3000; i++) {
+        int value = static_cast<int>(gen() % 5000);
+        other.Insert(value);
+        model.insert(value);
+    }
+    PQPairing<int> copy(other);
+    bool meldTest = copy == other && copy.Size() == 3000;
+    pq.Meld(std::move(other));
+    meldTest &= other.Empty() && pq.Size() == model.size();
+    other.Insert(7);
+    meldTest &= other.Tip() == 7;
+    while (!pq.Empty() && meldTest) {
+        meldTest &= pq.TipNRemove() == *model.rbegin();
+        model.erase(std::prev(model.end()));
+    }
+    meldTest &= model.empty() && copy.Size() == 3000;
+    printTestResult("PQPairing Meld, copy and drain in order", meldTest);
+
+    Vector<string> words(4);
+    words[0] = "delta"; words[1] = "alpha"; words[2] = "charlie"; words[3] = "bravo";
+    PQPairing<string, std::greater<string>> wordpq(words);
+    bool orderTest = wordpq.TipNRemove() == "alpha" && wordpq.Tip() == "bravo";
+    bool emptyThrows = false, rangeThrows = false;
+    try {
+        wordpq[3];
+    } catch (const std::out_of_range&) {
+        rangeThrows = true;
+    }
+    wordpq.Clear();
+    try {
+        wordpq.Tip();
+    } catch (const std::length_error&) {
+        emptyThrows = true;
+    }
+    orderTest &= emptyThrows && rangeThrows;
+    printTestResult("PQPairing comparator, errors and Clear", orderTest);
+
+    PQHeap<int, 4> small, large;
+    std::multiset<int> heapModel;
+    for (int i = 0; i < 50; i++) {
+        int value = static_cast<int>(gen() % 1000);
+        small.Insert(value);
+        heapModel.insert(value);
+    }
+    for (int i = 0; i < 2000; i++) {
+        int value = static_cast<int>(gen() % 1000);
+        large.Insert(value);
+        heapModel.insert(value);
+    }
+    small.Meld(std::move(large));
+    bool heapMeldTest = large.Empty() && small.IsHeap() && small.Size() == heapModel.size() && small.Tip() == *heapModel.rbegin();
+    small.Meld(std::move(small));
+    heapMeldTest &= small.Size() == heapModel.size();
+    Vector<int> all = small.TipNRemoveK(small.Size());
+    heapMeldTest &= all[0] == *heapModel.rbegin() && all[all.Size() - 1] == *heapModel.begin();
+    // A sorted heap is not in heap order: appending to it must rebuild it
+    PQHeap<int> ascending, three;
+    for (int i = 0; i < 8; i++) ascending.Insert(i);
+    ascending.Sort();
+    three.Insert(3);
+    ascending.Meld(std::move(three));
+    heapMeldTest &= ascending.IsHeap() && ascending.Size() == 9 && ascending.TipNRemove() == 7;
+    Vector<int> extra(2);
+    extra[0] = 3;
+    extra[1] = -1;
+    ascending.Sort();
+    ascending.InsertBatch(extra);
+    heapMeldTest &= ascending.IsHeap() && ascending.Size() == 10 && ascending.TipNRemove() == 6;
+    printTestResult("PQHeap Meld (append smaller, restore heap)", heapMeldTest);
+
+    cout << "Overall meld test result: " << (modelTest && meldTest && orderTest && heapMeldTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF MELD TESTS =======" << endl;
+}
+
+// Test the streaming top-k selector
+void testTopK() {
+    cout << "\n======= TESTS FOR TOP-K SELECTOR =======" << endl;
+
+    std::mt19937 gen(39);
+    const ulong n = 20000, k = 100;
+    Vector<int> values(n);
+    for (ulong i = 0; i < n; i++) {
+        values[i] = static_cast<int>(gen() % 100000);
+    }
+    std::vector<int> sorted;
+    values.Traverse([&sorted](const int& value) { sorted.push_back(value); });
+    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+
+    TopK<int> top(k);
+    top.OfferAll(values);
+    Vector<int> result = top.Result();
+    bool streamTest = top.Full() && top.Size() == k && result.Size() == k && top.Threshold() == sorted[k - 1];
+    for (ulong i = 0; i < k; i++) {
+        streamTest &= result[i] == sorted[i];
+    }
+    streamTest &= !top.Offer(sorted[k - 1] - 1) && top.Offer(1000000) && top.Result()[0] == 1000000;
+    printTestResult("TopK keeps the k greatest values, sorted best first", streamTest);
+
+    // Four threads select from their own slices, then the partial results merge
+    const int threads = 4;
+    std::vector<TopK<int>> partial(threads, TopK<int>(k));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (ulong i = t; i < n; i += threads) {
+                partial[t].Offer(values[i]);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    TopK<int> merged(k);
+    merged.Merge(partial[0]);
+    for (int t = 1; t < threads; t++) {
+        merged.Merge(std::move(partial[t]));
+    }
+    Vector<int> mergedResult = merged.Result();
+    bool mergeTest = partial[1].Empty() && partial[0].Size() == k && mergedResult.Size() == k;
+    for (ulong i = 0; i < k && mergeTest; i++) {
+        mergeTest &= mergedResult[i] == sorted[i];
+    }
+    printTestResult("TopK Merge of per-thread partial results", mergeTest);
+
+    TopK<string, std::greater<string>> shortest(2);
+    shortest.Offer("delta");
+    shortest.Offer("alpha");
+    shortest.Offer("charlie");
+    bool edgeTest = shortest.Result()[0] == "alpha" && shortest.Result()[1] == "charlie";
+    TopK<int> none(0);
+    edgeTest &= !none.Offer(5) && none.Empty();
+    bool emptyThrows = false;
+    try {
+        none.Threshold();
+    } catch (const std::length_error&) {
+        emptyThrows = true;
+    }
+    shortest.Clear();
+    edgeTest &= emptyThrows && shortest.Empty() && shortest.K() == 2 && shortest.Offer("zulu");
+    printTestResult("TopK comparator, k = 0 and Clear", edgeTest);
+
+    cout << "Overall top-k test result: " << (streamTest && mergeTest && edgeTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF TOP-K TESTS =======" << endl;
+}
+
+// Fills a vector with one of several input shapes
+void fillSelectionInput(SortableVector<int>& vec, std::vector<int>& model, int shape, std::mt19937& gen) {
+    ulong n = vec.Size();
+    for (ulong i = 0; i < n; i++) {
+        int value = 0;
+        if (shape == 0) value = static_cast<int>(gen() % 1000000);
+        else if (shape == 1) value = static_cast<int>(gen() % 4);
+        else if (shape == 2) value = static_cast<int>(i);
+        else if (shape == 3) value = static_cast<int>(n - i);
+        else value = static_cast<int>(i < n / 2 ? i : n - i); // Organ pipe
+        vec[i] = value;
+        model[i] = value;
+    }
+}
+
+// Test partial sorting and selection
+void testSelection() {
+    cout << "\n======= TESTS FOR PARTIAL SORT AND SELECTION =======" << endl;
+
+    std::mt19937 gen(40);
+    bool partialTest = true, nthTest = true;
+    for (ulong n : {1UL, 2UL, 17UL, 100UL, 1000UL, 20000UL}) {
+        for (int shape = 0; shape < 5; shape++) {
+            SortableVector<int> vec(n);
+            std::vector<int> model(n);
+            fillSelectionInput(vec, model, shape, gen);
+            std::vector<int> sorted(model);
+            std::sort(sorted.begin(), sorted.end());
+
+            ulong k = gen() % (n + 1);
+            SortableVector<int> copy(vec);
+            copy.PartialSort(k);
+            for (ulong i = 0; i < k; i++) {
+                partialTest &= copy[i] == sorted[i];
+            }
+            std::vector<int> rest;
+            for (ulong i = 0; i < n; i++) rest.push_back(copy[i]);
+            std::sort(rest.begin(), rest.end());
+            partialTest &= rest == sorted;
+
+            ulong index = gen() % n;
+            vec.NthElement(index);
+            nthTest &= vec[index] == sorted[index];
+            for (ulong i = 0; i < n; i++) {
+                nthTest &= (i < index) ? !(vec[index] < vec[i]) : !(vec[i] < vec[index]);
+            }
+        }
+    }
+    SortableVector<int> small(3);
+    bool errorTest = false;
+    try {
+        small.NthElement(3);
+    } catch (const std::out_of_range&) {
+        errorTest = true;
+    }
+    try {
+        small.PartialSort(4);
+        errorTest = false;
+    } catch (const std::out_of_range&) {
+    }
+    printTestResult("SortableVector PartialSort against std::sort", partialTest);
+    printTestResult("SortableVector NthElement against std::sort", nthTest && errorTest);
+
+    bool topTest = true;
+    for (ulong n : {1UL, 5UL, 300UL, 5000UL}) {
+        SortableVector<int> values(n);
+        std::vector<int> model(n);
+        fillSelectionInput(values, model, 0, gen);
+        std::sort(model.begin(), model.end());
+        for (ulong k : {0UL, 1UL, n / 10, n}) {
+            HeapVec<int, 3> heap(values);
+            heap.SortTopK(k);
+            for (ulong i = n - k; i < n; i++) {
+                topTest &= heap[i] == model[i];
+            }
+            for (ulong i = 1; i < n - k; i++) {
+                topTest &= !(heap[(i - 1) / 3] < heap[i]);
+            }
+        }
+    }
+    HeapVec<int> heap(small);
+    bool tooMany = false;
+    try {
+        heap.SortTopK(4);
+    } catch (const std::out_of_range&) {
+        tooMany = true;
+    }
+    printTestResult("HeapVec SortTopK sorts only the top k", topTest && tooMany);
+
+    cout << "Overall selection test result: " << (partialTest && nthTest && errorTest && topTest && tooMany ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF SELECTION TESTS =======" << endl;
+}
+
+// Checks every node against its children and grandchildren
+bool isMinMaxHeap(const PQMinMax<int>& pq) {
+    ulong n = pq.Size();
+    for (ulong i = 0; i < n; i++) {
+        bool min = (std::bit_width(i + 1) & 1) == 1;
+        for (ulong d : {2 * i + 1, 2 * i + 2, 4 * i + 3, 4 * i + 4, 4 * i + 5, 4 * i + 6}) {
+            if (d < n && (min ? pq[d] < pq[i] : pq[i] < pq[d])) return false;
+        }
+    }
+    return true;
+}
+
+void testMinMaxPQ() {
+    cout << "\n======= TESTS FOR MIN-MAX PRIORITY QUEUE =======" << endl;
+
+    std::mt19937 gen(41);
+    PQMinMax<int> pq;
+    std::multiset<int> model;
+    bool modelTest = true;
+    for (int step = 0; step < 20000 && modelTest; step++) {
+        unsigned op = gen() % 8;
+        if (op < 4 || model.empty()) {
+            int value = static_cast<int>(gen() % 5000);
+            pq.Insert(value);
+            model.insert(value);
+        } else if (op == 4) {
+            modelTest &= pq.TipMinNRemove() == *model.begin();
+            model.erase(model.begin());
+        } else if (op == 5) {
+            modelTest &= pq.TipMaxNRemove() == *model.rbegin();
+            model.erase(std::prev(model.end()));
+        } else {
+            ulong index = gen() % pq.Size();
+            int value = static_cast<int>(gen() % 5000);
+            model.erase(model.find(pq[index]));
+            model.insert(value);
+            pq.Change(index, value);
+        }
+        modelTest &= pq.Size() == model.size();
+        if (!model.empty()) {
+            modelTest &= pq.TipMin() == *model.begin() && pq.TipMax() == *model.rbegin() && pq.Tip() == pq.TipMax();
+        }
+        if (step % 1000 == 0) modelTest &= isMinMaxHeap(pq);
+    }
+    printTestResult("PQMinMax against a multiset model", modelTest && isMinMaxHeap(pq));
+
+    SortableVector<int> values(1000);
+    for (ulong i = 0; i < values.Size(); i++) values[i] = static_cast<int>(gen() % 300);
+    PQMinMax<int> built(values);
+    PQMinMax<int> copy(built);
+    bool buildTest = isMinMaxHeap(built) && copy.Size() == 1000;
+    int last = std::numeric_limits<int>::min();
+    while (!copy.Empty()) {
+        int value = copy.TipMinNRemove();
+        buildTest &= last <= value;
+        last = value;
+    }
+    buildTest &= built.Size() == 1000;
+    printTestResult("PQMinMax built from a container drains in order", buildTest);
+
+    PQMinMax<int> bounded(3);
+    bool boundTest = !bounded.InsertEvict(5).has_value() && !bounded.InsertEvict(1).has_value() && !bounded.InsertEvict(9).has_value();
+    std::optional<int> evicted = bounded.InsertEvict(7);
+    boundTest &= evicted == 1 && bounded.Size() == 3 && bounded.TipMin() == 5;
+    evicted = bounded.InsertEvict(2);
+    boundTest &= evicted == 2 && bounded.TipMin() == 5 && bounded.TipMax() == 9;
+    bounded.SetBound(1);
+    boundTest &= bounded.Size() == 1 && bounded.TipMin() == 9 && bounded.Bound() == 1;
+    bounded.SetBound(0);
+    bounded.Insert(3);
+    bounded.Insert(4);
+    boundTest &= bounded.Size() == 3 && bounded.TipMin() == 3;
+    printTestResult("PQMinMax bounded capacity evicts the lowest values", boundTest);
+
+    PQMinMax<string> empty;
+    bool errorTest = true;
+    try {
+        empty.TipMin();
+        errorTest = false;
+    } catch (const std::length_error&) {
+    }
+    try {
+        empty.RemoveTipMax();
+        errorTest = false;
+    } catch (const std::length_error&) {
+    }
+    try {
+        built.Change(1000, 0);
+        errorTest = false;
+    } catch (const std::out_of_range&) {
+    }
+    empty.Insert("beta");
+    empty.Insert("alpha");
+    errorTest &= empty.TipMin() == "alpha" && empty.TipMax() == "beta";
+    empty.Clear();
+    errorTest &= empty.Empty() && empty.Capacity() == 0;
+    printTestResult("PQMinMax errors on empty queues and bad indices", errorTest);
+
+    cout << "Overall min-max test result: " << (modelTest && buildTest && boundTest && errorTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF MIN-MAX TESTS =======" << endl;
+}
+
+// Counts the comparisons a heap makes
+struct CountingLess {
+    static inline ulong calls = 0;
+    bool operator()(int a, int b) const {
+        ++calls;
+        return a < b;
+    }
+};
+
+void testHeapState() {
+    cout << "\n======= TESTS FOR HEAP STATE TRACKING =======" << endl;
+
+    std::mt19937 gen(42);
+    SortableVector<int> values(2000);
+    for (ulong i = 0; i < values.Size(); i++) values[i] = static_cast<int>(gen() % 100000);
+
+    HeapVec<int, 2, CountingLess> heap(values);
+    CountingLess::calls = 0;
+    HeapVec<int, 2, CountingLess> copy(heap);
+    HeapVec<int, 2, CountingLess> assigned;
+    assigned = copy;
+    bool knownTest = heap.IsHeap() && copy.IsHeap() && assigned.IsHeap() && copy == heap;
+    heap.Heapify();
+    knownTest &= CountingLess::calls == 0;
+    heap.Sort();
+    CountingLess::calls = 0;
+    knownTest &= !heap.IsHeap() && CountingLess::calls == 0;
+    HeapVec<int, 2, CountingLess> rebuilt(heap);
+    knownTest &= rebuilt.IsHeap() && rebuilt.Top() == heap[heap.Size() - 1];
+    printTestResult("HeapVec IsHeap, copies and Heapify skip work on a known heap", knownTest);
+
+    HeapVec<int> touched(values);
+    bool touchTest = touched.IsHeap();
+    touched[touched.Size() - 1] = std::numeric_limits<int>::max();
+    touchTest &= !touched.IsHeap();
+    touched.Heapify();
+    touchTest &= touched.IsHeap() && touched.Top() == std::numeric_limits<int>::max();
+    touched[0] = touched[0];
+    touchTest &= touched.IsHeap();
+    touched.PartialSort(10);
+    touchTest &= !touched.IsHeap();
+    touched.Resize(5);
+    touched.Heapify();
+    touched.Resize(3);
+    touchTest &= touched.IsHeap();
+    printTestResult("HeapVec mutable access makes the state unknown", touchTest);
+
+    HeapVec<int> sorted5;
+    for (int i = 0; i < 5; i++) sorted5.Insert(i);
+    sorted5.Sort();
+    bool restoreTest = !sorted5.IsHeap() && static_cast<const HeapVec<int>&>(sorted5).Top() == 4 && !sorted5.IsHeap();
+    restoreTest &= sorted5.Top() == 4 && sorted5.IsHeap() && sorted5.TopNRemove() == 4 && sorted5.IsHeap();
+    sorted5.Sort();
+    sorted5.ReplaceTop(-1);
+    restoreTest &= sorted5.IsHeap() && sorted5.Top() == 2;
+    HeapVec<int> viaBase;
+    for (int i = 0; i <= 5; i++) viaBase.Insert(i);
+    SortableVector<int>& base = viaBase;
+    base.PartialSort(3);
+    restoreTest &= !viaBase.IsHeap() && viaBase.Top() == 5 && viaBase.IsHeap();
+    base.NthElement(0);
+    restoreTest &= viaBase[0] == 0 && !viaBase.IsHeap() && viaBase.TopNRemove() == 5 && viaBase.IsHeap();
+    printTestResult("HeapVec Top, TopNRemove and ReplaceTop restore a heap left unsorted", restoreTest);
+
+    HeapVec<int> deferred(values);
+    deferred.DeferHeapify();
+    deferred.Insert(std::numeric_limits<int>::max());
+    deferred.Insert(-5);
+    const HeapVec<int> frozen(std::move(deferred));
+    bool constTest = frozen.HeapifyPending() && frozen.Top() == std::numeric_limits<int>::max() && frozen.HeapifyPending();
+    HeapVec<int> scrambled(values);
+    scrambled[scrambled.Size() - 1] = std::numeric_limits<int>::max();
+    const HeapVec<int>& view = scrambled;
+    constTest &= view.Top() == std::numeric_limits<int>::max() && !view.IsHeap();
+    printTestResult("HeapVec const Top reads an unsettled heap without changing it", constTest);
+
+    HeapVec<int, 4, CountingLess> bulk;
+    bulk.Insert(-1);
+    bulk.DeferHeapify();
+    CountingLess::calls = 0;
+    for (ulong i = 0; i < values.Size(); i++) bulk.Insert(values[i]);
+    bulk.InsertBatch(values);
+    bool bulkTest = bulk.HeapifyPending() && CountingLess::calls == 0 && bulk.Size() == 4001;
+    HeapVec<int, 4, CountingLess> moved(std::move(bulk));
+    bulkTest &= moved.HeapifyPending() && CountingLess::calls == 0 && moved.Size() == 4001 && bulk.Empty();
+    std::vector<int> sorted;
+    values.Traverse([&sorted](const int& value) { sorted.push_back(value); sorted.push_back(value); });
+    sorted.push_back(-1);
+    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+    bulkTest &= moved.Top() == sorted[0] && !moved.HeapifyPending() && moved.IsHeap();
+    for (ulong i = 0; i < 100; i++) {
+        bulkTest &= moved.TopNRemove() == sorted[i];
+    }
+    printTestResult("HeapVec bulk-append mode survives a move and heapifies on the first Top", bulkTest);
+
+    PQHeap<int> pq;
+    pq.DeferHeapify();
+    for (ulong i = 0; i < values.Size(); i++) pq.Insert(values[i]);
+    // An index names a position as the values are, pending heapification or not
+    const PQHeap<int>& pending = pq;
+    ulong highest = 0;
+    for (ulong i = 1; i < pending.Size(); i++) if (pending[i] > pending[highest]) highest = i;
+    pq.Change(highest, std::numeric_limits<int>::max());
+    PQHeap<int> other;
+    other.DeferHeapify();
+    other.Insert(std::numeric_limits<int>::min());
+    other.Insert(sorted[0]);
+    pq.Meld(std::move(other));
+    bool pqTest = pq.Tip() == std::numeric_limits<int>::max() && pq.IsHeap() && pq.Size() == 2002;
+    pq.RemoveTip();
+    pqTest &= pq.TipNRemove() == sorted[0] && pq.TipNRemove() == sorted[2];
+    printTestResult("PQHeap bulk-append mode with Change and Meld", pqTest);
+
+    cout << "Overall heap state test result: " << (knownTest && touchTest && restoreTest && constTest && bulkTest && pqTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF HEAP STATE TESTS =======" << endl;
+}
+
+struct TestTimer {
+    long deadline;
+    ulong id;
+    bool operator==(const TestTimer& other) const { return deadline == other.deadline && id == other.id; }
+    bool operator!=(const TestTimer& other) const { return !(*this == other); }
+};
+
+struct TestTimerDeadline {
+    long operator()(const TestTimer& timer) const { return timer.deadline; }
+};
+
+void testTimerWheel() {
+    cout << "\n======= TESTS FOR TIMER WHEEL =======" << endl;
+
+    // Reference: pending timers ordered by deadline, then by insertion
+    std::mt19937_64 gen(43);
+    PQTimerWheel<TestTimer, TestTimerDeadline> wheel;
+    std::map<std::pair<long, ulong>, PQTimerWheel<TestTimer, TestTimerDeadline>::Handle> model;
+    std::vector<PQTimerWheel<TestTimer, TestTimerDeadline>::Handle> handles;
+    std::vector<long> deadlines;
+    long clock = -1000000;
+    ulong nextId = 0;
+    bool traceTest = true;
+    for (int step = 0; step < 30000 && traceTest; step++) {
+        for (int k = 0; k < 3; k++) {
+            ulong span = (gen() % 4 == 0) ? gen() % (1UL << 40) : gen() % 5000;
+            long deadline = clock + static_cast<long>(span);
+            auto handle = wheel.Schedule(TestTimer{deadline, nextId});
+            model[{deadline, nextId}] = handle;
+            handles.push_back(handle);
+            deadlines.push_back(deadline);
+            nextId++;
+        }
+        if (gen() % 2 == 0) {
+            ulong id = gen() % nextId;
+            auto entry = model.find({deadlines[id], id});
+            bool cancelled = wheel.Cancel(handles[id]);
+            traceTest &= cancelled == (entry != model.end()) && !wheel.Pending(handles[id]);
+            if (entry != model.end()) model.erase(entry);
+        }
+        clock += static_cast<long>(gen() % 3000);
+        wheel.Expire(clock, [&](TestTimer&& timer) {
+            traceTest &= !model.empty() && model.begin()->first == std::make_pair(timer.deadline, timer.id);
+            model.erase(model.begin());
+        });
+        traceTest &= wheel.Size() == model.size() && (model.empty() || model.begin()->first.first > clock);
+        if (!model.empty()) {
+            traceTest &= wheel.Tip().id == model.begin()->first.second;
+        }
+    }
+    printTestResult("PQTimerWheel schedule, cancel and expire against a reference", traceTest);
+
+    PQTimerWheel<TestTimer, TestTimerDeadline> copy(wheel);
+    bool copyTest = copy.Size() == wheel.Size() && !model.empty();
+    auto last = std::prev(model.end());
+    copyTest &= copy.Pending(last->second) && copy.Cancel(last->second) && wheel.Pending(last->second);
+    ulong traversed = 0;
+    copy.Traverse([&traversed](const TestTimer&) { traversed++; });
+    copyTest &= traversed == wheel.Size() - 1 && copy[0] == wheel[0];
+    long previous = std::numeric_limits<long>::min();
+    while (!copy.Empty()) {
+        TestTimer timer = copy.TipNRemove();
+        copyTest &= previous <= timer.deadline;
+        previous = timer.deadline;
+    }
+    printTestResult("PQTimerWheel copy keeps handles and drains in order", copyTest);
+
+    PQTimerWheel<ulong> simple;
+    bool simpleTest = true;
+    for (ulong value : {70UL, 5UL, 1000000UL, 64UL, 5UL}) simple.Insert(value);
+    simpleTest &= simple.TipNRemove() == 5 && simple.Floor() == 5;
+    simple.Change(0, 7);
+    simpleTest &= simple.Size() == 4;
+    std::vector<ulong> drained;
+    while (!simple.Empty()) drained.push_back(simple.TipNRemove());
+    std::vector<ulong> expected = {5, 64, 70, 1000000};
+    expected[0] = 7;
+    std::sort(expected.begin(), expected.end());
+    bool thrown = false;
+    try {
+        simple.Insert(3);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    simple.Clear();
+    simple.Insert(3);
+    simpleTest &= drained == expected && thrown && simple.Tip() == 3 && simple.Floor() == 0;
+    auto cleared = simple.Schedule(5);
+    simple.Clear();
+    auto fresh = simple.Schedule(7);
+    simpleTest &= !simple.Pending(cleared) && !simple.Cancel(cleared) && simple.Pending(fresh) && simple.Size() == 1;
+    simpleTest &= simple.Cancel(fresh) && simple.Empty();
+    printTestResult("PQTimerWheel Change, Floor and Clear (stale handles after Clear)", simpleTest);
+
+    PQTimerWheel<int> empty;
+    bool errorTest = false;
+    try {
+        empty.Tip();
+    } catch (const std::length_error&) {
+        errorTest = true;
+    }
+    try {
+        empty[0];
+        errorTest = false;
+    } catch (const std::out_of_range&) {
+    }
+    empty.Insert(-5);
+    empty.Insert(std::numeric_limits<int>::min());
+    errorTest &= empty.TipNRemove() == std::numeric_limits<int>::min() && empty.TipNRemove() == -5;
+    errorTest &= !empty.Cancel(PQTimerWheel<int>::Handle{});
+    printTestResult("PQTimerWheel errors, stale handles and signed deadlines", errorTest);
+
+    cout << "Overall timer wheel test result: " << (traceTest && copyTest && simpleTest && errorTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF TIMER WHEEL TESTS =======" << endl;
+}
+
+void testExternalPQ() {
+    cout << "\n======= TESTS FOR EXTERNAL-MEMORY PRIORITY QUEUE =======" << endl;
+
+    // 64 KiB budget, ten times as many bytes of values
+    const ulong budget = 1UL << 16;
+    const ulong n = 10 * budget / sizeof(ulong);
+    std::mt19937_64 gen(44);
+    PQExternal<ulong> pq(budget);
+    std::multiset<ulong> model;
+    ulong maxRuns = 0, maxOnDisk = 0;
+    for (ulong i = 0; i < n; i++) {
+        ulong value = gen() % 1000000000;
+        pq.Insert(value);
+        model.insert(value);
+        maxRuns = std::max(maxRuns, pq.Runs());
+        maxOnDisk = std::max(maxOnDisk, pq.OnDisk());
+    }
+    ulong sum = 0, modelSum = 0, counted = 0;
+    pq.Traverse([&sum, &counted](const ulong& value) { sum += value; counted++; });
+    for (ulong value : model) modelSum += value;
+    bool spillTest = pq.Size() == n && maxOnDisk > n / 2 && maxRuns >= 2 && pq.Runs() <= 17;
+    spillTest &= sum == modelSum && counted == n && pq.Tip() == *model.rbegin();
+    printTestResult("PQExternal spills runs beyond its budget", spillTest);
+
+    std::vector<ulong> order;
+    pq.PreOrderTraverse([&order](const ulong& value) { order.push_back(value); });
+    bool indexTest = true;
+    for (ulong i = 0; i < n; i += 997) {
+        indexTest &= pq[i] == order[i];
+    }
+    std::vector<ulong> reversed;
+    pq.PostOrderTraverse([&reversed](const ulong& value) { reversed.push_back(value); });
+    std::reverse(reversed.begin(), reversed.end());
+    indexTest &= reversed == order;
+    for (ulong i : {0UL, n / 3, n - 1}) {
+        ulong old = pq[i];
+        ulong value = gen() % 1000000000;
+        pq.Change(i, value);
+        model.erase(model.find(old));
+        model.insert(value);
+    }
+    indexTest &= pq.Size() == n;
+    printTestResult("PQExternal operator[], traversals and Change across memory and disk", indexTest);
+
+    PQExternal<ulong> copy(pq);
+    bool drainTest = copy.Size() == n;
+    for (ulong i = 0; i < n / 2; i++) {
+        ulong top = pq.TipNRemove();
+        drainTest &= top == *model.rbegin();
+        model.erase(std::prev(model.end()));
+        if (i % 7 == 0) {
+            ulong value = gen() % 1000000000;
+            pq.Insert(value);
+            model.insert(value);
+        }
+    }
+    while (!pq.Empty()) {
+        drainTest &= pq.TipNRemove() == *model.rbegin();
+        model.erase(std::prev(model.end()));
+    }
+    ulong previous = std::numeric_limits<ulong>::max();
+    while (!copy.Empty()) {
+        ulong value = copy.TipNRemove();
+        drainTest &= value <= previous;
+        previous = value;
+    }
+    drainTest &= model.empty() && pq.Runs() == 0;
+    printTestResult("PQExternal drains in order, with inserts between removals", drainTest);
+
+    PQExternal<double, std::greater<double>> small(256);
+    for (int i = 100; i > 0; i--) small.Insert(i * 0.5);
+    bool minTest = small.Runs() > 0 && small.Tip() == 0.5;
+    small.Clear();
+    bool errorTest = false;
+    try {
+        small.TipNRemove();
+    } catch (const std::length_error&) {
+        errorTest = true;
+    }
+    try {
+        small[0];
+        errorTest = false;
+    } catch (const std::out_of_range&) {
+    }
+    errorTest &= minTest && small.Empty() && small.Runs() == 0;
+    printTestResult("PQExternal comparator, Clear and errors", errorTest);
+
+    cout << "Overall external PQ test result: " << (spillTest && indexTest && drainTest && errorTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF EXTERNAL PQ TESTS =======" << endl;
+}
+
+// Every node below count is the child of its parent, and comes after it
+template <typename Map>
+bool checkHeapLayout(ulong count) {
+    for (ulong i = 1; i < count; i++) {
+        ulong parent = Map::Parent(i);
+        HeapChildren children = Map::Children(parent);
+        bool found = i >= children.first && i < children.first + children.count;
+        if (parent >= i || !found || Map::FirstChild(parent) != children.first) return false;
+    }
+    for (ulong i = 0; i < count; i++) {
+        HeapChildren children = Map::Children(i);
+        for (ulong k = 0; k < children.count; k++) {
+            if (Map::Parent(children.first + k) != i) return false;
+        }
+        if (children.count > 0 && children.first <= i) return false;
+    }
+    for (ulong i = Map::Internal(count); i < count; i++) {
+        if (Map::FirstChild(i) < count) return false;
+    }
+    return true;
+}
+
+void testHeapLayout() {
+    cout << "\n======= TESTS FOR HEAP LAYOUTS =======" << endl;
+
+    bool mapTest = checkHeapLayout<PagedLayout<64>::Map<ulong, 2>>(5000);
+    mapTest &= checkHeapLayout<PagedLayout<64>::Map<ulong, 3>>(5000);
+    mapTest &= checkHeapLayout<PagedLayout<4096>::Map<int, 4>>(100000);
+    mapTest &= checkHeapLayout<PagedLayout<4>::Map<ulong, 2>>(1000);
+    mapTest &= checkHeapLayout<ImplicitLayout::Map<ulong, 3>>(1000);
+    mapTest &= PagedLayout<64>::Map<ulong, 2>::PageNodes == 8 && PagedLayout<64>::Map<ulong, 2>::Fanout == 5;
+    printTestResult("PagedLayout parents and children agree", mapTest);
+
+    std::mt19937 gen(45);
+    SortableVector<long> values(3000);
+    for (ulong i = 0; i < values.Size(); i++) values[i] = static_cast<long>(gen() % 1000);
+    std::vector<long> sorted;
+    values.Traverse([&sorted](const long& value) { sorted.push_back(value); });
+    std::sort(sorted.begin(), sorted.end());
+
+    HeapVec<long, 2, std::less<long>, PagedLayout<64>> heap(values);
+    bool heapTest = heap.IsHeap() && heap.Top() == sorted.back();
+    for (ulong i = 1; i < heap.Size(); i++) {
+        heapTest &= heap[i] <= heap[PagedLayout<64>::Map<long, 2>::Parent(i)];
+    }
+    HeapVec<long, 2, std::less<long>, PagedLayout<64>> copy(heap);
+    copy.Sort();
+    for (ulong i = 0; i < sorted.size(); i++) heapTest &= copy[i] == sorted[i];
+    heap.SortTopK(100);
+    for (ulong i = 0; i < 100; i++) heapTest &= heap[heap.Size() - 100 + i] == sorted[sorted.size() - 100 + i];
+    heap.Heapify();
+    heapTest &= heap.IsHeap();
+    HeapVec<long, 3, std::greater<long>, PagedLayout<64>> minHeap;
+    minHeap.InsertBatch(values);
+    for (ulong i = 0; i < 200; i++) heapTest &= minHeap.TopNRemove() == sorted[i];
+    printTestResult("HeapVec with PagedLayout: BuildHeap, Sort, SortTopK and InsertBatch", heapTest);
+
+    PQHeap<long, 2, std::less<long>, PagedLayout<128>> pq;
+    pq.DeferHeapify();
+    for (ulong i = 0; i < values.Size(); i++) pq.Insert(values[i]);
+    pq.Change(values.Size() / 2, 5000);
+    pq.Insert(-1);
+    bool pqTest = pq.TipNRemove() == 5000 && pq.IsHeap();
+    pq.TipNRemove();
+    for (ulong i = 0; i < 1000; i++) {
+        pq.ReplaceTop(static_cast<long>(gen() % 1000));
+        pq.RemoveTip();
+        pqTest &= pq.IsHeap() && pq.Size() == values.Size() - 2 - i;
+    }
+    long previous = pq.TipNRemove();
+    while (!pq.Empty()) {
+        long next = pq.TipNRemove();
+        pqTest &= next <= previous;
+        previous = next;
+    }
+    pqTest &= previous == -1;
+    printTestResult("PQHeap with PagedLayout: Insert, Change, ReplaceTop and TipNRemove", pqTest);
+
+    // Pages of Arity values are the implicit layout, node for node
+    HeapVec<long, 2, std::less<long>, PagedLayout<4>> single(values);
+    HeapVec<long> implicit(values);
+    bool singleTest = true;
+    for (ulong i = 0; i < values.Size(); i++) singleTest &= single[i] == implicit[i];
+    printTestResult("PagedLayout with pages of Arity values matches the implicit layout", singleTest);
+
+    // Sibling groups of at most a line never straddle two, through growth, copies and resizes
+    auto oneLine = [](const auto& first, ulong count) {
+        std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(&first);
+        return begin / 64 == (begin + count * sizeof(first) - 1) / 64;
+    };
+    HeapVec<int, 8> wide;
+    bool lineTest = true;
+    for (int i = 0; i < 5000; i++) {
+        wide.Insert(static_cast<int>(gen() % 1000));
+        const HeapVec<int, 8>& view = wide;
+        lineTest &= view.Size() < 9 || oneLine(view[1], 8);
+    }
+    HeapVec<int, 8> wideCopy(wide);
+    const HeapVec<int, 8>& wideView = wideCopy;
+    for (ulong i = 0; 8 * i + 8 < wideView.Size(); i++) lineTest &= oneLine(wideView[8 * i + 1], 8);
+    wideCopy.Resize(100);
+    for (ulong i = 0; 8 * i + 8 < wideView.Size(); i++) lineTest &= oneLine(wideView[8 * i + 1], 8);
+    HeapVec<long, 4> longs(values);
+    const HeapVec<long, 4>& longView = longs;
+    for (ulong i = 0; 4 * i + 4 < longView.Size(); i++) lineTest &= oneLine(longView[4 * i + 1], 4);
+    HeapVec<string, 2> strings;
+    for (int i = 0; i < 300; i++) strings.Insert(std::to_string(gen() % 1000));
+    const HeapVec<string, 2>& stringView = strings;
+    for (ulong i = 0; 2 * i + 2 < stringView.Size(); i++) lineTest &= 2 * sizeof(string) > 64 || oneLine(stringView[2 * i + 1], 2);
+    lineTest &= wide.IsHeap() && wideCopy.Size() == 100 && strings.IsHeap();
+    printTestResult("Sibling groups of a HeapVec stay within a cache line", lineTest);
+
+    cout << "Overall heap layout test result: " << (mapTest && heapTest && pqTest && singleTest && lineTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF HEAP LAYOUT TESTS =======" << endl;
+}
+
+void testParallelBuildHeap() {
+    cout << "\n======= TESTS FOR PARALLEL BUILDHEAP =======" << endl;
+
+    std::mt19937 gen(46);
+    SortableVector<int> values(300001);
+    for (ulong i = 0; i < values.Size(); i++) values[i] = static_cast<int>(gen() % 1000000);
+
+    // Floyd's result only depends on heapifying children before parents
+    ThreadPool pool(3);
+    ThreadPool serial(0);
+    ThreadPool many(7);
+    HeapVec<int> parallel(values);
+    HeapVec<int> sequential(values);
+    parallel.Sort();
+    sequential.Sort();
+    parallel.ParallelHeapify(pool);
+    sequential.ParallelHeapify(serial);
+    bool sameTest = parallel.IsHeap() && parallel == sequential;
+    for (ulong i = 1; i < parallel.Size(); i++) {
+        sameTest &= parallel[i] <= parallel[(i - 1) / 2];
+    }
+    printTestResult("ParallelHeapify on a pool of 4 threads gives the sequential heap", sameTest);
+
+    HeapVec<int, 4, std::greater<int>> wide(values);
+    HeapVec<int, 4, std::greater<int>> wideSequential(values);
+    wide.Sort();
+    wideSequential.Sort();
+    wide.ParallelHeapify(many);
+    wideSequential.ParallelHeapify(serial);
+    bool wideTest = wide == wideSequential;
+    for (ulong i = 1; i < wide.Size(); i++) {
+        wideTest &= wide[i] >= wide[(i - 1) / 4];
+    }
+    printTestResult("ParallelHeapify on a 4-ary min-heap with 8 threads", wideTest);
+
+    SortableVector<int> few(1000);
+    for (ulong i = 0; i < few.Size(); i++) few[i] = static_cast<int>(i);
+    HeapVec<int> small(few);
+    small.Sort();
+    small.ParallelHeapify(many);
+    HeapVec<int, 2, std::less<int>, PagedLayout<256>> paged(values);
+    paged.Sort();
+    paged.ParallelHeapify(pool);
+    bool fallbackTest = small.IsHeap() && small.Top() == 999 && paged.IsHeap() && paged.Top() == sequential.Top();
+    for (ulong i = 1; i < paged.Size(); i++) {
+        fallbackTest &= paged[i] <= paged[PagedLayout<256>::Map<int, 2>::Parent(i)];
+    }
+    printTestResult("ParallelHeapify falls back to one thread on small heaps and other layouts", fallbackTest);
+
+    PQHeap<int> pq(values);
+    pq.Sort();
+    pq.ParallelHeapify();
+    std::vector<int> sorted;
+    values.Traverse([&sorted](const int& value) { sorted.push_back(value); });
+    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+    bool pqTest = true;
+    for (ulong i = 0; i < 1000; i++) pqTest &= pq.TipNRemove() == sorted[i];
+    printTestResult("PQHeap ParallelHeapify on the default pool", pqTest);
+
+    cout << "Overall parallel BuildHeap test result: " << (sameTest && wideTest && fallbackTest && pqTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF PARALLEL BUILDHEAP TESTS =======" << endl;
+}
+
+void testThreadPool() {
+    cout << "\n======= TESTS FOR THREAD POOL =======" << endl;
+
+    ThreadPool pool(3);
+    ThreadPool serial(0);
+    bool basicTest = pool.Workers() == 3 && pool.Concurrency() == 4 && !pool.Deterministic();
+    basicTest &= serial.Deterministic() && serial.Concurrency() == 1;
+    ulong hardware = std::max(std::thread::hardware_concurrency(), 1U);
+    basicTest &= ThreadPool::Default().Workers() == hardware - 1 && &ThreadPool::Default() == &ThreadPool::Default();
+    printTestResult("ThreadPool workers, concurrency and default pool", basicTest);
+
+    bool forTest = true;
+    for (ulong grain : {0UL, 1UL, 7UL, 1000UL, 20000UL}) {
+        std::vector<std::atomic<int>> visits(10007);
+        std::atomic<ulong> chunks{0};
+        std::atomic<bool> sized{true};
+        pool.ParallelFor(3, visits.size(), grain, [&](ulong begin, ulong end) {
+            if (end <= begin || end - begin > std::max<ulong>(grain, 1)) sized = false;
+            for (ulong i = begin; i < end; i++) visits[i]++;
+            chunks++;
+        });
+        forTest &= sized;
+        for (ulong i = 0; i < visits.size(); i++) forTest &= visits[i] == (i >= 3 ? 1 : 0);
+        forTest &= chunks == (visits.size() - 3 + std::max<ulong>(grain, 1) - 1) / std::max<ulong>(grain, 1);
+    }
+    bool called = false;
+    pool.ParallelFor(5, 5, 1, [&](ulong, ulong) { called = true; });
+    forTest &= !called;
+    printTestResult("ParallelFor visits every index once, in chunks of at most grain", forTest);
+
+    std::atomic<ulong> inner{0};
+    pool.ParallelFor(0, 64, 1, [&](ulong, ulong) {
+        pool.ParallelFor(0, 100, 3, [&](ulong begin, ulong end) { inner += end - begin; });
+    });
+    bool nestedTest = inner == 6400;
+    printTestResult("ParallelFor nests inside ParallelFor", nestedTest);
+
+    std::vector<double> terms(100000);
+    for (ulong i = 0; i < terms.size(); i++) terms[i] = 1.0 / static_cast<double>(i + 1);
+    auto partial = [&terms](ulong begin, ulong end) {
+        double sum = 0.0;
+        for (ulong i = begin; i < end; i++) sum += terms[i];
+        return sum;
+    };
+    auto plus = [](double a, double b) { return a + b; };
+    double parallelSum = pool.ParallelReduce(0, terms.size(), 333, 0.0, partial, plus);
+    double serialSum = serial.ParallelReduce(0, terms.size(), 333, 0.0, partial, plus);
+    ulong count = pool.ParallelReduce(0, 1000, 10, 0UL, [](ulong begin, ulong end) { return end - begin; }, [](ulong a, ulong b) { return a + b; });
+    bool reduceTest = parallelSum == serialSum && count == 1000 && pool.ParallelReduce(4, 4, 1, 42, partial, plus) == 42;
+    printTestResult("ParallelReduce is the same on any number of threads", reduceTest);
+
+    pool.SetDeterministic(true);
+    std::vector<ulong> order;
+    pool.ParallelFor(0, 50, 5, [&order](ulong begin, ulong) { order.push_back(begin); });
+    pool.SetDeterministic(false);
+    bool deterministicTest = order.size() == 10;
+    for (ulong i = 0; i < order.size(); i++) deterministicTest &= order[i] == 5 * i;
+    printTestResult("Deterministic mode runs the chunks in order on the caller", deterministicTest);
+
+    bool exceptionTest = false;
+    std::atomic<ulong> ran{0};
+    try {
+        pool.ParallelFor(0, 100, 1, [&ran](ulong begin, ulong) {
+            ran++;
+            if (begin == 50) throw std::runtime_error("chunk failed");
+        });
+    } catch (const std::runtime_error&) {
+        exceptionTest = true;
+    }
+    exceptionTest &= ran == 100;
+    std::atomic<ulong> after{0};
+    pool.ParallelFor(0, 100, 1, [&after](ulong, ulong) { after++; });
+    exceptionTest &= after == 100;
+    printTestResult("ParallelFor rethrows the exception of a chunk after the others", exceptionTest);
+
+    cout << "Overall thread pool test result: " << (basicTest && forTest && nestedTest && reduceTest && deterministicTest && exceptionTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF THREAD POOL TESTS =======" << endl;
+}
+
+void testParallelMapFold() {
+    cout << "\n======= TESTS FOR PARALLEL MAP AND FOLD =======" << endl;
+
+    ThreadPool pool(3);
+    ThreadPool serial(0);
+
+    Vector<double> values(100000);
+    for (ulong i = 0; i < values.Size(); i++) values[i] = static_cast<double>(i);
+    ParallelMap(values, [](double& value) { value = 2 * value + 1; }, 1000, pool);
+    bool mapTest = true;
+    for (ulong i = 0; i < values.Size(); i++) mapTest &= values[i] == 2.0 * i + 1;
+    Vector<double> empty;
+    ParallelMap(empty, [](double& value) { value = 0; }, 10, pool);
+    SortableVector<int> sortable(5000);
+    for (ulong i = 0; i < sortable.Size(); i++) sortable[i] = static_cast<int>(i % 97);
+    ParallelMap(sortable, [](int& value) { value = -value; }, 64, pool);
+    sortable.Sort();
+    mapTest &= empty.Empty() && sortable[0] == -96 && sortable[sortable.Size() - 1] == 0;
+    printTestResult("ParallelMap on Vector and SortableVector", mapTest);
+
+    auto add = [](const double& value, const double& sum) { return sum + value; };
+    auto plus = [](const double& a, const double& b) { return a + b; };
+    double sequentialSum = values.Fold<double>(add, 0.0);
+    double parallelSum = ParallelFold<double>(values, add, plus, 0.0, 4096, pool);
+    double serialSum = ParallelFold<double>(values, add, plus, 0.0, 4096, serial);
+    bool foldTest = parallelSum == serialSum && parallelSum == sequentialSum;
+    foldTest &= ParallelFold<double>(empty, add, plus, 5.0, 10, pool) == 5.0;
+
+    // Concatenation is associative but not commutative: the chunks must be combined in order
+    Vector<string> words(1000);
+    for (ulong i = 0; i < words.Size(); i++) words[i] = std::to_string(i) + ",";
+    auto append = [](const string& word, const string& text) { return text + word; };
+    auto concatenate = [](const string& a, const string& b) { return a + b; };
+    foldTest &= ParallelFold<string>(words, append, concatenate, string(), 7, pool) == words.Fold<string>(append, string());
+    printTestResult("ParallelFold equals Fold for associative combinations", foldTest);
+
+    std::mt19937 gen(48);
+    SortableVector<int> keys(20000);
+    for (ulong i = 0; i < keys.Size(); i++) keys[i] = static_cast<int>(gen() % 100000);
+    PQHeap<int> pq(keys);
+    int top = pq.Tip();
+    ParallelMap(pq, [](int& value) { value = -value; }, 500, pool);
+    bool heapTest = !pq.IsHeap();
+    pq.Heapify();
+    int lowest = top;
+    keys.Traverse([&lowest](const int& value) { lowest = std::min(lowest, value); });
+    heapTest &= pq.IsHeap() && pq.Tip() == -lowest;
+    heapTest &= ParallelFold<long>(pq, [](const int& value, const long& sum) { return sum + value; },
+                                      [](const long& a, const long& b) { return a + b; }, 0L, 333, pool)
+                == pq.Fold<long>([](const int& value, const long& sum) { return sum + value; }, 0L);
+    printTestResult("ParallelMap on a heap loses the heap order; ParallelFold on a PQHeap", heapTest);
+
+    PQMinMax<int> ends(keys);
+    ParallelMap(ends, [](int& value) { value = -value; }, 500, pool);
+    bool minMaxTest = ends.TipMin() == -top && ends.TipMax() == -lowest && ends.Size() == keys.Size();
+    int previous = ends.TipMinNRemove();
+    for (ulong i = 0; i < 1000; i++) {
+        int next = ends.TipMinNRemove();
+        minMaxTest &= previous <= next;
+        previous = next;
+    }
+    printTestResult("ParallelMap on a min-max heap rebuilds its order", minMaxTest);
+
+    cout << "Overall parallel map and fold test result: " << (mapTest && foldTest && heapTest && minMaxTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF PARALLEL MAP AND FOLD TESTS =======" << endl;
+}
+
+// Generic code over the non-virtual interface
+template <typename Derived, typename Data>
+Data staticSum(const StaticLinearContainer<Derived, Data>& container) {
+    return container.template StaticFold<Data>([](const Data& value, const Data& sum) { return sum + value; }, Data{});
+}
+
+void testStaticInterface() {
+    cout << "\n======= TESTS FOR STATIC INTERFACE =======" << endl;
+
+    bool finalTest = std::is_final_v<SetVec<int>> && std::is_final_v<SetLst<int>> && std::is_final_v<SetHash<int>>;
+    finalTest &= std::is_final_v<PQHeap<int>> && std::is_final_v<PQMinMax<int>> && std::is_final_v<PQPairing<int>>;
+    finalTest &= std::is_final_v<TopK<int>> && std::is_final_v<PQExternal<int>> && std::is_final_v<IndexedPQHeap<int>>;
+    finalTest &= !std::is_final_v<Vector<int>> && !std::is_final_v<HeapVec<int>>;
+    printTestResult("Concrete classes without subclasses are final", finalTest);
+
+    std::mt19937 gen(49);
+    SetVec<int> set;
+    for (ulong i = 0; i < 500; i++) set.Insert(static_cast<int>(gen() % 1000));
+    std::vector<int> virtualOrder, staticOrder;
+    set.Traverse([&virtualOrder](const int& value) { virtualOrder.push_back(value); });
+    set.StaticTraverse([&staticOrder](const int& value) { staticOrder.push_back(value); });
+    bool setTest = virtualOrder == staticOrder && set.StaticSize() == set.Size() && !set.StaticEmpty();
+    setTest &= set.StaticAt(0) == set.Min() && set.StaticAt(set.Size() - 1) == set.Max();
+    setTest &= staticSum(set) == set.Fold<int>([](const int& value, const int& sum) { return sum + value; }, 0);
+    bool thrown = false;
+    try {
+        set.StaticAt(set.Size());
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    setTest &= thrown;
+    printTestResult("SetVec static members agree with the virtual ones", setTest);
+
+    SetVec<int, std::greater<int>> descending;
+    for (ulong i = 0; i < 500; i++) descending.Insert(static_cast<int>(gen() % 1000));
+    std::vector<int> descendingOrder, descendingStatic;
+    descending.Traverse([&descendingOrder](const int& value) { descendingOrder.push_back(value); });
+    descending.StaticTraverse([&descendingStatic](const int& value) { descendingStatic.push_back(value); });
+    bool compareTest = std::is_base_of_v<StaticLinearContainer<SetVec<int, std::greater<int>>, int>, SetVec<int, std::greater<int>>>;
+    compareTest &= descendingOrder == descendingStatic && descending.StaticSize() == descending.Size();
+    compareTest &= descending.StaticAt(0) == descending.Min() && descending.StaticAt(0) > descending.StaticAt(1);
+    compareTest &= staticSum(descending) == descending.Fold<int>([](const int& value, const int& sum) { return sum + value; }, 0);
+    printTestResult("SetVec with a custom comparator has the right static interface", compareTest);
+
+    SortableVector<long> values(1000);
+    for (ulong i = 0; i < values.Size(); i++) values[i] = static_cast<long>(gen() % 10000);
+    PQHeap<long> heap(values);
+    PQMinMax<long> minmax(values);
+    long total = values.Fold<long>([](const long& value, const long& sum) { return sum + value; }, 0L);
+    bool pqTest = staticSum(heap) == total && staticSum(minmax) == total;
+    pqTest &= heap.StaticAt(0) == heap.Tip() && minmax.StaticSize() == values.Size();
+    PQHeap<long> empty;
+    pqTest &= empty.StaticEmpty() && staticSum(empty) == 0;
+    printTestResult("PQHeap and PQMinMax static members agree with the virtual ones", pqTest);
+
+    cout << "Overall static interface test result: " << (finalTest && setTest && compareTest && pqTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF STATIC INTERFACE TESTS =======" << endl;
+}
+
+void testFoldInPlace() {
+    cout << "\n======= TESTS FOR FOLD IN PLACE =======" << endl;
+
+    std::mt19937 gen(50);
+    Vector<string> words(300);
+    List<string> list;
+    for (ulong i = 0; i < words.Size(); i++) {
+        words[i] = std::to_string(gen() % 1000) + ",";
+        list.InsertAtBack(words[i]);
+    }
+    auto concatenate = [](const string& word, const string& text) { return text + word; };
+    auto append = [](const string& word, string& text) { text += word; };
+
+    bool vectorTest = words.FoldInPlace<string>(append, string("")) == words.Fold<string>(concatenate, string(""));
+    vectorTest &= words.PreOrderFoldInPlace<string>(append, string("")) == words.PreOrderFold<string>(concatenate, string(""));
+    vectorTest &= words.PostOrderFoldInPlace<string>(append, string("")) == words.PostOrderFold<string>(concatenate, string(""));
+    vectorTest &= words.PreOrderFoldInPlace<string>(append, string("")) != words.PostOrderFoldInPlace<string>(append, string(""));
+    printTestResult("Vector folds in place as Fold in every order", vectorTest);
+
+    bool listTest = list.FoldInPlace<string>(append, string("")) == list.Fold<string>(concatenate, string(""));
+    listTest &= list.PreOrderFoldInPlace<string>(append, string("")) == words.PreOrderFoldInPlace<string>(append, string(""));
+    listTest &= list.PostOrderFoldInPlace<string>(append, string("")) == list.PostOrderFold<string>(concatenate, string(""));
+    printTestResult("List folds in place as Fold in every order", listTest);
+
+    Vector<int> empty;
+    bool baseTest = empty.FoldInPlace<string>([](const int&, string& text) { text += "x"; }, string("base")) == "base";
+    SetLst<int> none;
+    std::vector<int> collected = none.PostOrderFoldInPlace<std::vector<int>>(
+        [](const int& value, std::vector<int>& all) { all.push_back(value); }, std::vector<int>{7});
+    baseTest &= collected == std::vector<int>{7};
+    printTestResult("An empty container returns the initial accumulator", baseTest);
+
+    SortableVector<int> values(1000);
+    for (ulong i = 0; i < values.Size(); i++) values[i] = static_cast<int>(gen() % 100);
+    PQHeap<int> heap(values);
+    std::vector<ulong> counts = heap.FoldInPlace<std::vector<ulong>>(
+        [](const int& value, std::vector<ulong>& histogram) { histogram[value]++; }, std::vector<ulong>(100, 0));
+    ulong total = 0;
+    bool histogramTest = counts.size() == 100;
+    for (ulong i = 0; i < counts.size(); i++) {
+        total += counts[i];
+        histogramTest &= counts[i] == values.Fold<ulong>([i](const int& value, const ulong& count) { return count + (static_cast<ulong>(value) == i); }, 0UL);
+    }
+    histogramTest &= total == values.Size();
+    printTestResult("A container accumulator is updated in place", histogramTest);
+
+    cout << "Overall fold in place test result: " << (vectorTest && listTest && baseTest && histogramTest ? "SUCCESS" : "FAILURE") << endl;
+    cout << "\n======= END OF FOLD IN PLACE TESTS =======" << endl;
+}
+
 // Funzione principale per eseguire tutti i test Heap e PQ
 void runHeapPQTests() {
-    cout << "======= STARTING HEAP AND PRIORITY QUEUE TESTS =======" << endl;
+    cout << "======= STARTING ALL TESTS =======" << endl;
     
     testHeapVecInt();
     testHeapVecString();
     testPQHeapInt();
     testPQHeapString();
-    
-    cout << "\n======= ALL HEAP AND PQ TESTS COMPLETED =======" << endl;
+    testSetHash();
+    testSetRange();
+    testSetOrderStatistics();
+    testRelocation();
+    testMoveOnly();
+    testHeapArity();
+    testComparator();
+    testIndexedPQ();
+    testBatch();
+    testHoleSift();
+    testRadixPQ();
+    testConcurrentPQ();
+    testMeld();
+    testTopK();
+    testSelection();
+    testMinMaxPQ();
+    testHeapState();
+    testTimerWheel();
+    testExternalPQ();
+    testHeapLayout();
+    testParallelBuildHeap();
+    testThreadPool();
+    testParallelMapFold();
+    testStaticInterface();
+    testFoldInPlace();
+    
+    cout << "\n======= ALL TESTS COMPLETED =======" << endl;
 }
 
 // Menu per i test
@@ -433,7 +2706,32 @@ void allTests() {
              << "2. Test HeapVec (string)" << endl
              << "3. Test PQHeap (int)" << endl
              << "4. Test PQHeap (string)" << endl
-             << "5. Run All Heap and PQ Tests" << endl;
+             << "5. Run All Tests" << endl
+             << "6. Test SetHash" << endl
+             << "7. Test Set range queries" << endl
+             << "8. Test Set order statistics" << endl
+             << "9. Test relocatable fast paths" << endl
+             << "10. Test move-only values" << endl
+             << "11. Test d-ary heaps" << endl
+             << "12. Test comparator policies" << endl
+             << "13. Test indexed priority queue" << endl
+             << "14. Test batched PQ operations" << endl
+             << "15. Test hole-based sifting and heapsort" << endl
+             << "16. Test radix priority queue" << endl
+             << "17. Test concurrent priority queue" << endl
+             << "18. Test meldable priority queues" << endl
+             << "19. Test top-k selector" << endl
+             << "20. Test partial sort and selection" << endl
+             << "21. Test Min-Max Priority Queue" << endl
+             << "22. Test Heap State Tracking" << endl
+             << "23. Test Timer Wheel" << endl
+             << "24. Test External-Memory Priority Queue" << endl
+             << "25. Heap Layouts" << endl
+             << "26. Parallel BuildHeap" << endl
+             << "27. Thread Pool" << endl
+             << "28. Parallel Map and Fold" << endl
+             << "29. Static Interface" << endl
+             << "30. FoldInPlace" << endl;
         
         string input;
         cin >> input;
@@ -456,6 +2754,56 @@ void allTests() {
             testPQHeapString();
         } else if (choice == 5) {
             runHeapPQTests();
+        } else if (choice == 6) {
+            testSetHash();
+        } else if (choice == 7) {
+            testSetRange();
+        } else if (choice == 8) {
+            testSetOrderStatistics();
+        } else if (choice == 9) {
+            testRelocation();
+        } else if (choice == 10) {
+            testMoveOnly();
+        } else if (choice == 11) {
+            testHeapArity();
+        } else if (choice == 12) {
+            testComparator();
+        } else if (choice == 13) {
+            testIndexedPQ();
+        } else if (choice == 14) {
+            testBatch();
+        } else if (choice == 15) {
+            testHoleSift();
+        } else if (choice == 16) {
+            testRadixPQ();
+        } else if (choice == 17) {
+            testConcurrentPQ();
+        } else if (choice == 18) {
+            testMeld();
+        } else if (choice == 19) {
+            testTopK();
+        } else if (choice == 20) {
+            testSelection();
+        } else if (choice == 21) {
+            testMinMaxPQ();
+        } else if (choice == 22) {
+            testHeapState();
+        } else if (choice == 23) {
+            testTimerWheel();
+        } else if (choice == 24) {
+            testExternalPQ();
+        } else if (choice == 25) {
+            testHeapLayout();
+        } else if (choice == 26) {
+            testParallelBuildHeap();
+        } else if (choice == 27) {
+            testThreadPool();
+        } else if (choice == 28) {
+            testParallelMapFold();
+        } else if (choice == 29) {
+            testStaticInterface();
+        } else if (choice == 30) {
+            testFoldInPlace();
         } else {
             cout << "Invalid input" << endl;
         }